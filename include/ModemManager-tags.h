@@ -252,6 +252,22 @@
  */
 #define ID_MM_TTY_FLOW_CONTROL "ID_MM_TTY_FLOW_CONTROL"
 
+/**
+ * ID_MM_TTY_BURST_WRITE:
+ *
+ * This is a port-specific tag applied to TTYs that are able to receive
+ * full commands at full speed.
+ *
+ * By default, commands sent to TTYs are written one byte at a time, with
+ * a short delay between bytes, as some devices will drop characters if
+ * they are written too quickly. When this tag is set, commands are written
+ * to the TTY in as few writes as possible, and the daemon just waits for
+ * the TTY to be writable again if it cannot take all the data at once.
+ *
+ * Since: 1.22
+ */
+#define ID_MM_TTY_BURST_WRITE "ID_MM_TTY_BURST_WRITE"
+
 /**
  * ID_MM_REQUIRED:
  *
@@ -1826,30 +1826,42 @@ mm_new_iso8601_time (guint    year,
 
 /*****************************************************************************/
 
-/* From hostap, Copyright (c) 2002-2005, Jouni Malinen <jkmaline@cc.hut.fi> */
-
-static gint
-hex2num (gchar c)
-{
-    if (c >= '0' && c <= '9')
-        return c - '0';
-    if (c >= 'a' && c <= 'f')
-        return c - 'a' + 10;
-    if (c >= 'A' && c <= 'F')
-        return c - 'A' + 10;
-    return -1;
-}
+/* Hex digit values, with HEX_INVALID for anything that isn't a hex digit */
+#define HEX_INVALID 0x10
+
+#define XX HEX_INVALID
+static const guint8 hex_values[256] = {
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+     0,  1,  2,  3,  4,  5,  6,  7,  8,  9, XX, XX, XX, XX, XX, XX,
+    XX, 10, 11, 12, 13, 14, 15, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, 10, 11, 12, 13, 14, 15, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+};
+#undef XX
+
+static const gchar hex_digits[] = "0123456789ABCDEF";
 
 gint
 mm_utils_hex2byte (const gchar *hex)
 {
-    gint a, b;
+    guint8 a, b;
 
-    a = hex2num (*hex++);
-    if (a < 0)
+    a = hex_values[(guint8) hex[0]];
+    if (a == HEX_INVALID)
         return -1;
-    b = hex2num (*hex++);
-    if (b < 0)
+    b = hex_values[(guint8) hex[1]];
+    if (b == HEX_INVALID)
         return -1;
     return (a << 4) | b;
 }
@@ -1860,11 +1872,10 @@ mm_utils_hexstr2bin (const gchar  *hex,
                      gsize        *out_len,
                      GError      **error)
 {
-    const gchar *ipos = hex;
+    const guint8      *ipos = (const guint8 *) hex;
     g_autofree guint8 *buf = NULL;
-    gssize i;
-    gint a;
-    guint8 *opos;
+    gsize              i;
+    guint8             invalid = 0;
 
     if (len < 0)
         len = strlen (hex);
@@ -1882,62 +1893,65 @@ mm_utils_hexstr2bin (const gchar  *hex,
         return NULL;
     }
 
-    opos = buf = g_malloc0 (len / 2);
-    for (i = 0; i < len; i += 2) {
-        a = mm_utils_hex2byte (ipos);
-        if (a < 0) {
-            g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
-                         "Hex byte conversion from '%c%c' failed",
-                         ipos[0], ipos[1]);
-            return NULL;
-        }
-        *opos++ = (guint8)a;
-        ipos += 2;
+    /* Convert without branching on the input, and validate all at once */
+    buf = g_malloc (len / 2);
+    for (i = 0; i < (gsize) len / 2; i++) {
+        guint8 a, b;
+
+        a = hex_values[ipos[2 * i]];
+        b = hex_values[ipos[2 * i + 1]];
+        invalid |= a | b;
+        buf[i] = (guint8) ((a << 4) | b);
     }
+
+    if (invalid & HEX_INVALID) {
+        /* Look for the offending byte only when reporting the error */
+        for (i = 0; mm_utils_hex2byte (&hex[i]) >= 0; i += 2);
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
+                     "Hex byte conversion from '%c%c' failed",
+                     hex[i], hex[i + 1]);
+        return NULL;
+    }
+
     *out_len = len / 2;
     return g_steal_pointer (&buf);
 }
 
-/* End from hostap */
-
 gboolean
 mm_utils_ishexstr (const gchar *hex)
 {
-    gsize len;
-    gsize i;
+    gsize  len;
+    gsize  i;
+    guint8 invalid = 0;
 
     /* Empty string or length not multiple of 2? */
     len = strlen (hex);
     if (len == 0 || (len % 2) != 0)
         return FALSE;
 
-    for (i = 0; i < len; i++) {
-        /* Non-hex char? */
-        if (hex[i] >= '0' && hex[i] <= '9')
-            continue;
-        if (hex[i] >= 'a' && hex[i] <= 'f')
-            continue;
-        if (hex[i] >= 'A' && hex[i] <= 'F')
-            continue;
-        return FALSE;
-    }
+    /* Non-hex char? */
+    for (i = 0; i < len; i++)
+        invalid |= hex_values[(guint8) hex[i]];
 
-    return TRUE;
+    return !(invalid & HEX_INVALID);
 }
 
 gchar *
 mm_utils_bin2hexstr (const guint8 *bin,
                      gsize         len)
 {
-    GString *ret;
-    gsize i;
+    gchar *ret;
+    gsize  i;
 
     g_return_val_if_fail (bin != NULL, NULL);
 
-    ret = g_string_sized_new (len * 2 + 1);
-    for (i = 0; i < len; i++)
-        g_string_append_printf (ret, "%.2X", bin[i]);
-    return g_string_free (ret, FALSE);
+    ret = g_malloc (len * 2 + 1);
+    for (i = 0; i < len; i++) {
+        ret[2 * i]     = hex_digits[bin[i] >> 4];
+        ret[2 * i + 1] = hex_digits[bin[i] & 0x0F];
+    }
+    ret[len * 2] = '\0';
+    return ret;
 }
 
 gboolean
@@ -598,6 +598,91 @@ hexstr_wrong_digits_some (void)
     common_hexstr2bin_test_failure ("012345k7");
 }
 
+static void
+hexstr_wrong_digits_embedded_nul (void)
+{
+    g_autoptr(GError)  error = NULL;
+    g_autofree guint8 *bin = NULL;
+    gsize              bin_len = 0;
+
+    bin = mm_utils_hexstr2bin ("0123\0\06789", 10, &bin_len, &error);
+    g_assert_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS);
+    g_assert_null (bin);
+}
+
+static void
+hexstr_all_bytes (void)
+{
+    guint8             bin[256];
+    g_autofree gchar  *hex = NULL;
+    g_autofree guint8 *out = NULL;
+    g_autoptr(GError)  error = NULL;
+    gsize              out_len = 0;
+    guint              i;
+
+    for (i = 0; i < G_N_ELEMENTS (bin); i++)
+        bin[i] = (guint8) i;
+
+    hex = mm_utils_bin2hexstr (bin, sizeof (bin));
+    g_assert_cmpuint (strlen (hex), ==, 2 * sizeof (bin));
+    g_assert (g_str_has_prefix (hex, "000102"));
+    g_assert (g_str_has_suffix (hex, "FDFEFF"));
+
+    out = mm_utils_hexstr2bin (hex, -1, &out_len, &error);
+    g_assert_no_error (error);
+    g_assert_cmpuint (out_len, ==, sizeof (bin));
+    g_assert (memcmp (out, bin, sizeof (bin)) == 0);
+}
+
+static void
+hexstr_perf (void)
+{
+    /* Sizes in bytes: ICCID, SMS PDU, +CRSM record, EF binary read */
+    static const gsize sizes[] = { 10, 176, 256, 4096 };
+    /* Amount of data converted for each size */
+    const gsize        total = 16 * 1024 * 1024;
+    guint              i;
+
+    if (!g_test_perf ()) {
+        g_test_skip ("only run in perf mode");
+        return;
+    }
+
+    for (i = 0; i < G_N_ELEMENTS (sizes); i++) {
+        g_autofree guint8 *bin = NULL;
+        g_autofree gchar  *hex = NULL;
+        gsize              iterations;
+        gsize              j;
+        gdouble            elapsed;
+
+        bin = g_malloc (sizes[i]);
+        for (j = 0; j < sizes[i]; j++)
+            bin[j] = (guint8) g_test_rand_int ();
+        hex = mm_utils_bin2hexstr (bin, sizes[i]);
+
+        iterations = MAX (total / sizes[i], 1);
+
+        g_test_timer_start ();
+        for (j = 0; j < iterations; j++)
+            g_free (mm_utils_bin2hexstr (bin, sizes[i]));
+        elapsed = g_test_timer_elapsed ();
+        g_test_maximized_result (iterations * sizes[i] / elapsed / (1024 * 1024),
+                                 "%" G_GSIZE_FORMAT " bytes: encode %.1f MB/s",
+                                 sizes[i], iterations * sizes[i] / elapsed / (1024 * 1024));
+
+        g_test_timer_start ();
+        for (j = 0; j < iterations; j++) {
+            gsize out_len;
+
+            g_free (mm_utils_hexstr2bin (hex, sizes[i] * 2, &out_len, NULL));
+        }
+        elapsed = g_test_timer_elapsed ();
+        g_test_maximized_result (iterations * sizes[i] / elapsed / (1024 * 1024),
+                                 "%" G_GSIZE_FORMAT " bytes: decode %.1f MB/s",
+                                 sizes[i], iterations * sizes[i] / elapsed / (1024 * 1024));
+    }
+}
+
 static void
 date_time_iso8601 (void)
 {
@@ -1320,6 +1405,9 @@ int main (int argc, char **argv)
     g_test_add_func ("/MM/Common/HexStr/missing-digits",    hexstr_missing_digits);
     g_test_add_func ("/MM/Common/HexStr/wrong-digits-all",  hexstr_wrong_digits_all);
     g_test_add_func ("/MM/Common/HexStr/wrong-digits-some", hexstr_wrong_digits_some);
+    g_test_add_func ("/MM/Common/HexStr/wrong-digits-nul",  hexstr_wrong_digits_embedded_nul);
+    g_test_add_func ("/MM/Common/HexStr/all-bytes",         hexstr_all_bytes);
+    g_test_add_func ("/MM/Common/HexStr/perf",              hexstr_perf);
 
     g_test_add_func ("/MM/Common/DateTime/iso8601", date_time_iso8601);
 
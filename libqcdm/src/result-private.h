@@ -22,6 +22,9 @@
 
 QcdmResult *qcdm_result_new (void);
 
+/* Keys given to the setters are not copied; they must be static strings,
+ * as all the item names used by the response parsers are. */
+
 void qcdm_result_add_string (QcdmResult *result,
                              const char *key,
                              const char *str);
@@ -21,6 +21,7 @@
 #include "result.h"
 #include "result-private.h"
 #include "errors.h"
+#include "utils.h"
 
 /*********************************************************/
 
@@ -35,151 +36,38 @@ typedef enum {
     VAL_TYPE_U16_ARRAY = 5,
 } ValType;
 
+/* Keys are the static item name strings from the command headers, so they
+ * are referenced and not copied.  String and array contents live in the
+ * result's inline data area, and only spill to the heap when too big.
+ */
 struct Val {
-    char *key;
+    const char *key;
     uint8_t type;
+    uint8_t heap;
+    uint32_t array_len;
     union {
         char *s;
         uint8_t u8;
         uint32_t u32;
         uint8_t *u8_array;
         uint16_t *u16_array;
+        void *data;
     } u;
-    uint32_t array_len;
-    Val *next;
 };
 
-static void
-val_free (Val *v)
-{
-    if (v->type == VAL_TYPE_STRING) {
-        free (v->u.s);
-    } else if (v->type == VAL_TYPE_U8_ARRAY) {
-        free (v->u.u8_array);
-    } else if (v->type == VAL_TYPE_U16_ARRAY) {
-        free (v->u.u16_array);
-    }
-    free (v->key);
-    memset (v, 0, sizeof (*v));
-    free (v);
-}
-
-static Val *
-val_new_string (const char *key, const char *value)
-{
-    Val *v;
-
-    qcdm_return_val_if_fail (key != NULL, NULL);
-    qcdm_return_val_if_fail (key[0] != '\0', NULL);
-    qcdm_return_val_if_fail (value != NULL, NULL);
-
-    v = calloc (sizeof (Val), 1);
-    if (v == NULL)
-        return NULL;
-
-    v->key = strdup (key);
-    v->type = VAL_TYPE_STRING;
-    v->u.s = strdup (value);
-    return v;
-}
-
-static Val *
-val_new_u8 (const char *key, uint8_t u)
-{
-    Val *v;
-
-    qcdm_return_val_if_fail (key != NULL, NULL);
-    qcdm_return_val_if_fail (key[0] != '\0', NULL);
-
-    v = calloc (sizeof (Val), 1);
-    if (v == NULL)
-        return NULL;
-
-    v->key = strdup (key);
-    v->type = VAL_TYPE_U8;
-    v->u.u8 = u;
-    return v;
-}
-
-static Val *
-val_new_u8_array (const char *key, const uint8_t *array, size_t array_len)
-{
-    Val *v;
-
-    qcdm_return_val_if_fail (key != NULL, NULL);
-    qcdm_return_val_if_fail (key[0] != '\0', NULL);
-    qcdm_return_val_if_fail (array != NULL, NULL);
-    qcdm_return_val_if_fail (array_len > 0, NULL);
-
-    v = calloc (sizeof (Val), 1);
-    if (v == NULL)
-        return NULL;
-
-    v->key = strdup (key);
-    v->type = VAL_TYPE_U8_ARRAY;
-    v->u.u8_array = malloc (array_len);
-    if (v->u.u8_array == NULL) {
-        val_free (v);
-        return NULL;
-    }
-    memcpy (v->u.u8_array, array, array_len);
-    v->array_len = array_len;
-
-    return v;
-}
-
-static Val *
-val_new_u32 (const char *key, uint32_t u)
-{
-    Val *v;
-
-    qcdm_return_val_if_fail (key != NULL, NULL);
-    qcdm_return_val_if_fail (key[0] != '\0', NULL);
-
-    v = calloc (sizeof (Val), 1);
-    if (v == NULL)
-        return NULL;
-
-    v->key = strdup (key);
-    v->type = VAL_TYPE_U32;
-    v->u.u32 = u;
-    return v;
-}
-
-static Val *
-val_new_u16_array (const char *key, const uint16_t *array, size_t array_len)
-{
-    Val *v;
-    size_t sz;
-
-    qcdm_return_val_if_fail (key != NULL, NULL);
-    qcdm_return_val_if_fail (key[0] != '\0', NULL);
-    qcdm_return_val_if_fail (array != NULL, NULL);
-    qcdm_return_val_if_fail (array_len > 0, NULL);
-
-    v = calloc (sizeof (Val), 1);
-    if (v == NULL)
-        return NULL;
-
-    v->key = strdup (key);
-    v->type = VAL_TYPE_U16_ARRAY;
-    sz = sizeof (uint16_t) * array_len;
-    v->u.u16_array = malloc (sz);
-    if (v->u.u16_array == NULL) {
-        val_free (v);
-        return NULL;
-    }
-    memcpy (v->u.u16_array, array, sz);
-    v->array_len = array_len;
-
-    return v;
-}
-
-/*********************************************************/
+/* Enough for every command and log item response */
+#define RESULT_INLINE_VALS  16
+#define RESULT_INLINE_DATA  256
+#define RESULT_DATA_ALIGN   8
 
 struct QcdmResult {
     uint32_t refcount;
-    Val *first;
+    uint32_t n_vals;
+    uint32_t n_alloc;
+    uint32_t data_used;
+    Val *vals;
+    Val inline_vals[RESULT_INLINE_VALS];
+    uint8_t data[RESULT_INLINE_DATA] __attribute__ ((aligned (RESULT_DATA_ALIGN)));
 };
 
 QcdmResult *
@@ -187,9 +75,15 @@ qcdm_result_new (void)
 {
     QcdmResult *r;
 
-    r = calloc (sizeof (QcdmResult), 1);
-    if (r)
+    /* No need to clear the inline storage, only used slots are ever read */
+    r = malloc (sizeof (QcdmResult));
+    if (r) {
         r->refcount = 1;
+        r->n_vals = 0;
+        r->n_alloc = RESULT_INLINE_VALS;
+        r->data_used = 0;
+        r->vals = r->inline_vals;
+    }
     return r;
 }
 
@@ -206,15 +100,15 @@ qcdm_result_ref (QcdmResult *r)
 static void
 qcdm_result_free (QcdmResult *r)
 {
-    Val *v, *n;
+    uint32_t i;
 
-    v = r->first;
-    while (v) {
-        n = v->next;
-        val_free (v);
-        v = n;
+    for (i = 0; i < r->n_vals; i++) {
+        if (r->vals[i].heap)
+            free (r->vals[i].u.data);
     }
-    memset (r, 0, sizeof (*r));
+    if (r->vals != r->inline_vals)
+        free (r->vals);
+    r->refcount = 0;
     free (r);
 }
 
@@ -229,20 +123,70 @@ qcdm_result_unref (QcdmResult *r)
         qcdm_result_free (r);
 }
 
+static Val *
+add_val (QcdmResult *r, const char *key, ValType type, size_t data_len)
+{
+    Val *v;
+
+    qcdm_return_val_if_fail (key != NULL, NULL);
+    qcdm_return_val_if_fail (key[0] != '\0', NULL);
+
+    if (r->n_vals == r->n_alloc) {
+        Val *vals;
+
+        if (r->vals == r->inline_vals) {
+            vals = malloc (sizeof (Val) * r->n_alloc * 2);
+            if (vals)
+                memcpy (vals, r->inline_vals, sizeof (Val) * r->n_vals);
+        } else
+            vals = realloc (r->vals, sizeof (Val) * r->n_alloc * 2);
+        if (vals == NULL)
+            return NULL;
+        r->vals = vals;
+        r->n_alloc *= 2;
+    }
+
+    v = &r->vals[r->n_vals];
+    v->key = key;
+    v->type = type;
+    v->heap = FALSE;
+    v->array_len = 0;
+
+    if (data_len > 0) {
+        size_t offset;
+
+        offset = (r->data_used + RESULT_DATA_ALIGN - 1) & ~(RESULT_DATA_ALIGN - 1);
+        if (offset + data_len <= RESULT_INLINE_DATA) {
+            v->u.data = &r->data[offset];
+            r->data_used = offset + data_len;
+        } else {
+            v->u.data = malloc (data_len);
+            if (v->u.data == NULL)
+                return NULL;
+            v->heap = TRUE;
+        }
+    }
+
+    r->n_vals++;
+    return v;
+}
+
 static Val *
 find_val (QcdmResult *r, const char *key, ValType expected_type)
 {
-    Val *v, *n;
+    uint32_t i;
 
-    v = r->first;
-    while (v) {
-        n = v->next;
-        if (strcmp (v->key, key) == 0) {
+    /* Walk backwards so that the last value added for a key wins. Callers
+     * usually pass the very same item name string the parser used, so try
+     * the cheap pointer comparison before the string one. */
+    for (i = r->n_vals; i > 0; i--) {
+        Val *v = &r->vals[i - 1];
+
+        if (v->key == key || strcmp (v->key, key) == 0) {
             /* Check type */
             qcdm_return_val_if_fail (v->type == expected_type, NULL);
             return v;
         }
-        v = n;
     }
     return NULL;
 }
@@ -253,16 +197,17 @@ qcdm_result_add_string (QcdmResult *r,
                        const char *str)
 {
     Val *v;
+    size_t len;
 
     qcdm_return_if_fail (r != NULL);
     qcdm_return_if_fail (r->refcount > 0);
     qcdm_return_if_fail (key != NULL);
     qcdm_return_if_fail (str != NULL);
 
-    v = val_new_string (key, str);
+    len = strlen (str) + 1;
+    v = add_val (r, key, VAL_TYPE_STRING, len);
     qcdm_return_if_fail (v != NULL);
-    v->next = r->first;
-    r->first = v;
+    memcpy (v->u.s, str, len);
 }
 
 int
@@ -297,10 +242,9 @@ qcdm_result_add_u8 (QcdmResult *r,
     qcdm_return_if_fail (r->refcount > 0);
     qcdm_return_if_fail (key != NULL);
 
-    v = val_new_u8 (key, num);
+    v = add_val (r, key, VAL_TYPE_U8, 0);
     qcdm_return_if_fail (v != NULL);
-    v->next = r->first;
-    r->first = v;
+    v->u.u8 = num;
 }
 
 int
@@ -336,10 +280,12 @@ qcdm_result_add_u8_array (QcdmResult *r,
     qcdm_return_if_fail (key != NULL);
     qcdm_return_if_fail (array != NULL);
 
-    v = val_new_u8_array (key, array, array_len);
+    qcdm_return_if_fail (array_len > 0);
+
+    v = add_val (r, key, VAL_TYPE_U8_ARRAY, array_len);
     qcdm_return_if_fail (v != NULL);
-    v->next = r->first;
-    r->first = v;
+    memcpy (v->u.u8_array, array, array_len);
+    v->array_len = array_len;
 }
 
 int
@@ -376,10 +322,9 @@ qcdm_result_add_u32 (QcdmResult *r,
     qcdm_return_if_fail (r->refcount > 0);
     qcdm_return_if_fail (key != NULL);
 
-    v = val_new_u32 (key, num);
+    v = add_val (r, key, VAL_TYPE_U32, 0);
     qcdm_return_if_fail (v != NULL);
-    v->next = r->first;
-    r->first = v;
+    v->u.u32 = num;
 }
 
 int
@@ -415,10 +360,12 @@ qcdm_result_add_u16_array (QcdmResult *r,
     qcdm_return_if_fail (key != NULL);
     qcdm_return_if_fail (array != NULL);
 
-    v = val_new_u16_array (key, array, array_len);
+    qcdm_return_if_fail (array_len > 0);
+
+    v = add_val (r, key, VAL_TYPE_U16_ARRAY, sizeof (uint16_t) * array_len);
     qcdm_return_if_fail (v != NULL);
-    v->next = r->first;
-    r->first = v;
+    memcpy (v->u.u16_array, array, sizeof (uint16_t) * array_len);
+    v->array_len = array_len;
 }
 
 int
@@ -68,20 +68,70 @@ static const uint16_t crc_table[256] = {
     0x7bc7, 0x6a4e, 0x58d5, 0x495c, 0x3de3, 0x2c6a, 0x1ef1, 0x0f78
 };
 
+/* Slicing-by-8 tables: crc_slices[k][n] is the CRC contribution of byte n
+ * followed by k zero bytes, so that 8 input bytes can be folded into the CRC
+ * with 8 independent lookups. The first one is crc_table itself, the rest are
+ * derived from it the first time they're needed. */
+static uint16_t crc_slices[8][256];
+static qcdmbool crc_slices_ready;
+
+static void
+crc_slices_init (void)
+{
+    size_t n, k;
+
+    for (n = 0; n < 256; n++)
+        crc_slices[0][n] = crc_table[n];
+    for (k = 1; k < 8; k++) {
+        for (n = 0; n < 256; n++)
+            crc_slices[k][n] = crc_table[crc_slices[k - 1][n] & 0xff] ^ (crc_slices[k - 1][n] >> 8);
+    }
+    crc_slices_ready = TRUE;
+}
+
 /* Calculate the CRC for a buffer using a seed of 0xffff */
 uint16_t
 dm_crc16 (const char *buffer, size_t len)
 {
+    const uint8_t *p = (const uint8_t *) buffer;
     uint16_t crc = 0xffff;
 
+    if (len >= 8) {
+        if (!crc_slices_ready)
+            crc_slices_init ();
+
+        while (len >= 8) {
+            crc = crc_slices[7][(p[0] ^ crc) & 0xff] ^
+                  crc_slices[6][(p[1] ^ (crc >> 8)) & 0xff] ^
+                  crc_slices[5][p[2]] ^
+                  crc_slices[4][p[3]] ^
+                  crc_slices[3][p[4]] ^
+                  crc_slices[2][p[5]] ^
+                  crc_slices[1][p[6]] ^
+                  crc_slices[0][p[7]];
+            p += 8;
+            len -= 8;
+        }
+    }
+
     while (len--)
-            crc = crc_table[(crc ^ *buffer++) & 0xff] ^ (crc >> 8);
+            crc = crc_table[(crc ^ *p++) & 0xff] ^ (crc >> 8);
     return ~crc;
 }
 
 #define DIAG_ESC_CHAR     0x7D  /* Escape sequence 1st character value */
 #define DIAG_ESC_MASK     0x20  /* Escape sequence complement value */
 
+/* Returns the first occurrence of c in [p, end), or end if none */
+static inline const char *
+find_char (const char *p, const char *end, char c)
+{
+    const char *found;
+
+    found = memchr (p, c, end - p);
+    return found ? found : end;
+}
+
 /* Performs DM escaping on inbuf putting the result into outbuf, and returns
  * the final length of the buffer.
  */
@@ -92,8 +142,10 @@ dm_escape (const char *inbuf,
            size_t outbuf_len)
 {
     const char *src = inbuf;
+    const char *end = inbuf + inbuf_len;
+    const char *next_ctrl;
+    const char *next_esc;
     char *dst = outbuf;
-    size_t i = inbuf_len;
 
     qcdm_return_val_if_fail (inbuf != NULL, 0);
     qcdm_return_val_if_fail (inbuf_len > 0, 0);
@@ -108,11 +160,10 @@ dm_escape (const char *inbuf,
         size_t outbuf_required = inbuf_len + 1; /* +1 for the trailing control char */
 
         /* Each escaped character takes up two bytes in the output buffer */
-        while (i--) {
-            if (*src == DIAG_CONTROL_CHAR || *src == DIAG_ESC_CHAR)
-                outbuf_required++;
-            src++;
-        }
+        for (src = find_char (inbuf, end, DIAG_CONTROL_CHAR); src < end; src = find_char (src + 1, end, DIAG_CONTROL_CHAR))
+            outbuf_required++;
+        for (src = find_char (inbuf, end, DIAG_ESC_CHAR); src < end; src = find_char (src + 1, end, DIAG_ESC_CHAR))
+            outbuf_required++;
 
         if (outbuf_len < outbuf_required)
             return 0;
@@ -122,16 +173,32 @@ dm_escape (const char *inbuf,
      * the escape character in the source buffer with the following sequence:
      *
      * <escape_char> <src_byte ^ escape_mask>
+     *
+     * Runs of bytes in between are copied as they are. The next occurrence of
+     * each special character is tracked separately, so that every byte is
+     * only looked at once by each search.
      */
     src = inbuf;
-    i = inbuf_len;
-    while (i--) {
-        if (*src == DIAG_CONTROL_CHAR || *src == DIAG_ESC_CHAR) {
-            *dst++ = DIAG_ESC_CHAR;
-            *dst++ = *src ^ DIAG_ESC_MASK;
-        } else
-            *dst++ = *src;
+    next_ctrl = find_char (src, end, DIAG_CONTROL_CHAR);
+    next_esc = find_char (src, end, DIAG_ESC_CHAR);
+    while (src < end) {
+        const char *special;
+
+        special = next_ctrl < next_esc ? next_ctrl : next_esc;
+        memcpy (dst, src, special - src);
+        dst += special - src;
+        src = special;
+        if (src == end)
+            break;
+
+        *dst++ = DIAG_ESC_CHAR;
+        *dst++ = *src ^ DIAG_ESC_MASK;
         src++;
+
+        if (special == next_ctrl)
+            next_ctrl = find_char (src, end, DIAG_CONTROL_CHAR);
+        else
+            next_esc = find_char (src, end, DIAG_ESC_CHAR);
     }
 
     return (dst - outbuf);
@@ -144,26 +211,41 @@ dm_unescape (const char *inbuf,
              size_t outbuf_len,
              qcdmbool *escaping)
 {
-    size_t i, outsize;
+    const char *src = inbuf;
+    const char *end = inbuf + inbuf_len;
+    size_t outsize = 0;
 
     qcdm_return_val_if_fail (inbuf_len > 0, 0);
     qcdm_return_val_if_fail (outbuf_len >= inbuf_len, 0);
     qcdm_return_val_if_fail (escaping != NULL, 0);
 
-    for (i = 0, outsize = 0; i < inbuf_len; i++) {
+    while (src < end) {
+        const char *esc;
+        size_t run;
+
+        /* Byte following an escape character, maybe in a previous buffer */
         if (*escaping) {
-            outbuf[outsize++] = inbuf[i] ^ DIAG_ESC_MASK;
+            outbuf[outsize++] = *src++ ^ DIAG_ESC_MASK;
             *escaping = FALSE;
-        } else if (inbuf[i] == DIAG_ESC_CHAR)
-            *escaping = TRUE;
-        else
-            outbuf[outsize++] = inbuf[i];
+        }
 
-        /* About to overrun output buffer size */
-        if (outsize >= outbuf_len)
-            return 0;
+        /* Copy everything up to the next escape character as it is */
+        esc = find_char (src, end, DIAG_ESC_CHAR);
+        run = esc - src;
+        memcpy (&outbuf[outsize], src, run);
+        outsize += run;
+        src = esc;
+
+        if (src < end) {
+            *escaping = TRUE;
+            src++;
+        }
     }
 
+    /* Filling the output buffer completely is reported as an overrun */
+    if (outsize >= outbuf_len)
+        return 0;
+
     return outsize;
 }
 
@@ -241,6 +323,7 @@ dm_decapsulate_buffer (const char *inbuf,
                        qcdmbool *out_need_more)
 {
     qcdmbool escaping = FALSE;
+    const char *ctrl;
     size_t i, pkt_len = 0, unesc_len;
     uint16_t crc, pkt_crc;
 
@@ -261,20 +344,20 @@ dm_decapsulate_buffer (const char *inbuf,
     }
 
     /* Find the async control character */
-    for (i = 0; i < inbuf_len; i++) {
-        if (inbuf[i] == DIAG_CONTROL_CHAR) {
-            /* If the control character shows up in a position before a valid
-             * QCDM packet length (4), the packet is malformed.
-             */
-            if (i < 3) {
-                /* Tell the caller to advance the buffer past the control char */
-                *out_used = i + 1;
-                return FALSE;
-            }
-
-            pkt_len = i;
-            break;
+    ctrl = memchr (inbuf, DIAG_CONTROL_CHAR, inbuf_len);
+    if (ctrl) {
+        i = ctrl - inbuf;
+
+        /* If the control character shows up in a position before a valid
+         * QCDM packet length (4), the packet is malformed.
+         */
+        if (i < 3) {
+            /* Tell the caller to advance the buffer past the control char */
+            *out_used = i + 1;
+            return FALSE;
         }
+
+        pkt_len = i;
     }
 
     /* No control char yet, need more data */
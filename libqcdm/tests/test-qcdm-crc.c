@@ -63,3 +63,61 @@ test_crc16_1 (void *f, void *data)
     g_assert (crc == expected);
 }
 
+/* Reference implementation, one bit at a time */
+static guint16
+crc16_bitwise (const char *buf, gsize len)
+{
+    guint16 crc = 0xffff;
+    guint   i;
+
+    while (len--) {
+        crc ^= (guint8) *buf++;
+        for (i = 0; i < 8; i++)
+            crc = (crc & 1) ? ((crc >> 1) ^ 0x8408) : (crc >> 1);
+    }
+    return ~crc;
+}
+
+void
+test_crc16_lengths (void *f, void *data)
+{
+    char  buf[80];
+    gsize offset;
+    gsize len;
+    guint i;
+
+    for (i = 0; i < sizeof (buf); i++)
+        buf[i] = (char) (i * 37 + 11);
+
+    /* Cover both the 8-byte blocks and the trailing bytes, from any alignment */
+    for (offset = 0; offset < 8; offset++) {
+        for (len = 0; len <= sizeof (buf) - offset; len++)
+            g_assert_cmpuint (dm_crc16 (&buf[offset], len), ==, crc16_bitwise (&buf[offset], len));
+    }
+}
+
+#define BENCHMARK_BUFFER_SIZE (64 * 1024)
+#define BENCHMARK_ROUNDS      1000
+
+void
+test_crc16_benchmark (void *f, void *data)
+{
+    g_autofree char *buf = NULL;
+    guint16          crc = 0;
+    gdouble          elapsed;
+    guint            i;
+
+    buf = g_malloc (BENCHMARK_BUFFER_SIZE);
+    for (i = 0; i < BENCHMARK_BUFFER_SIZE; i++)
+        buf[i] = (char) g_test_rand_int ();
+
+    g_test_timer_start ();
+    for (i = 0; i < BENCHMARK_ROUNDS; i++)
+        crc ^= dm_crc16 (buf, BENCHMARK_BUFFER_SIZE);
+    elapsed = g_test_timer_elapsed ();
+
+    g_test_maximized_result ((gdouble) BENCHMARK_BUFFER_SIZE * BENCHMARK_ROUNDS / elapsed / (1024 * 1024),
+                             "dm_crc16: %.1f MB/s (crc %04x)",
+                             (gdouble) BENCHMARK_BUFFER_SIZE * BENCHMARK_ROUNDS / elapsed / (1024 * 1024),
+                             crc);
+}
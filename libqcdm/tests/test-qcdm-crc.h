@@ -20,6 +20,8 @@
 
 void test_crc16_2 (void *f, void *data);
 void test_crc16_1 (void *f, void *data);
+void test_crc16_lengths (void *f, void *data);
+void test_crc16_benchmark (void *f, void *data);
 
 #endif  /* TEST_QCDM_CRC_H */
 
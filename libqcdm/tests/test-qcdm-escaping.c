@@ -122,3 +122,92 @@ test_escape_unescape (void *f, void *data)
     g_assert (memcmp (unescaped, data1, unlen) == 0);
 }
 
+void
+test_escape_unescape_chunked (void *f, void *data)
+{
+    char     input[300];
+    char     escaped[sizeof (input) * 2];
+    char     part[sizeof (escaped) + 1];
+    char     unescaped[sizeof (input)];
+    gsize    len;
+    gsize    unlen;
+    gsize    partlen;
+    gsize    split;
+    guint    i;
+
+    /* Mostly special characters, so that runs of all lengths show up */
+    for (i = 0; i < sizeof (input); i++) {
+        switch (g_test_rand_int_range (0, 4)) {
+        case 0:  input[i] = 0x7e; break;
+        case 1:  input[i] = 0x7d; break;
+        default: input[i] = (char) g_test_rand_int (); break;
+        }
+    }
+
+    len = dm_escape (input, sizeof (input), escaped, sizeof (escaped));
+    g_assert_cmpuint (len, >, sizeof (input));
+    g_assert (!memchr (escaped, 0x7e, len));
+
+    /* Unescaping in two steps must give the same result whatever the split
+     * point, even right after an escape character */
+    for (split = 1; split < len; split++) {
+        qcdmbool escaping = FALSE;
+
+        unlen = dm_unescape (escaped, split, part, sizeof (part), &escaping);
+        g_assert_cmpuint (unlen, <=, sizeof (unescaped));
+        memcpy (unescaped, part, unlen);
+
+        partlen = dm_unescape (&escaped[split], len - split, part, sizeof (part), &escaping);
+        g_assert_cmpuint (unlen + partlen, ==, sizeof (input));
+        memcpy (&unescaped[unlen], part, partlen);
+        unlen += partlen;
+
+        g_assert (!escaping);
+        g_assert_cmpuint (unlen, ==, sizeof (input));
+        g_assert (memcmp (unescaped, input, unlen) == 0);
+    }
+}
+
+#define BENCHMARK_BUFFER_SIZE (64 * 1024)
+#define BENCHMARK_ROUNDS      1000
+
+void
+test_escape_benchmark (void *f, void *data)
+{
+    g_autofree char *buf = NULL;
+    g_autofree char *escaped = NULL;
+    g_autofree char *unescaped = NULL;
+    gsize            len = 0;
+    gsize            unlen = 0;
+    gdouble          elapsed;
+    guint            i;
+
+    /* Log packets are mostly binary data, with about one byte out of 128
+     * needing escaping */
+    buf = g_malloc (BENCHMARK_BUFFER_SIZE);
+    for (i = 0; i < BENCHMARK_BUFFER_SIZE; i++)
+        buf[i] = (char) g_test_rand_int ();
+    escaped = g_malloc (BENCHMARK_BUFFER_SIZE * 2);
+    unescaped = g_malloc (BENCHMARK_BUFFER_SIZE * 2);
+
+    g_test_timer_start ();
+    for (i = 0; i < BENCHMARK_ROUNDS; i++)
+        len = dm_escape (buf, BENCHMARK_BUFFER_SIZE, escaped, BENCHMARK_BUFFER_SIZE * 2);
+    elapsed = g_test_timer_elapsed ();
+    g_assert_cmpuint (len, >=, BENCHMARK_BUFFER_SIZE);
+    g_test_maximized_result ((gdouble) BENCHMARK_BUFFER_SIZE * BENCHMARK_ROUNDS / elapsed / (1024 * 1024),
+                             "dm_escape: %.1f MB/s",
+                             (gdouble) BENCHMARK_BUFFER_SIZE * BENCHMARK_ROUNDS / elapsed / (1024 * 1024));
+
+    g_test_timer_start ();
+    for (i = 0; i < BENCHMARK_ROUNDS; i++) {
+        qcdmbool escaping = FALSE;
+
+        unlen = dm_unescape (escaped, len, unescaped, BENCHMARK_BUFFER_SIZE * 2, &escaping);
+    }
+    elapsed = g_test_timer_elapsed ();
+    g_assert_cmpuint (unlen, ==, BENCHMARK_BUFFER_SIZE);
+    g_test_maximized_result ((gdouble) len * BENCHMARK_ROUNDS / elapsed / (1024 * 1024),
+                             "dm_unescape: %.1f MB/s",
+                             (gdouble) len * BENCHMARK_ROUNDS / elapsed / (1024 * 1024));
+}
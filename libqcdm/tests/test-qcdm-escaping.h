@@ -21,6 +21,8 @@
 void test_escape1 (void *f, void *data);
 void test_escape2 (void *f, void *data);
 void test_escape_unescape (void *f, void *data);
+void test_escape_unescape_chunked (void *f, void *data);
+void test_escape_benchmark (void *f, void *data);
 
 #endif  /* TEST_QCDM_ESCAPING_H */
 
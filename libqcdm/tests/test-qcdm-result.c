@@ -21,6 +21,7 @@
 #include "test-qcdm-result.h"
 #include "result.h"
 #include "result-private.h"
+#include "errors.h"
 
 #define TEST_TAG "test"
 
@@ -90,3 +91,49 @@ test_result_uint8_array (void *f, void *data)
 
     qcdm_result_unref (result);
 }
+
+void
+test_result_many_values (void *f, void *data)
+{
+    char keys[40][16];
+    char lookup[16];
+    guint16 array[1000];
+    const guint16 *tmp_array = NULL;
+    size_t tmp_len = 0;
+    const char *tmp_str = NULL;
+    guint32 tmp = 0;
+    QcdmResult *result;
+    guint i;
+
+    /* More values and data than fit in the result's inline storage */
+    result = qcdm_result_new ();
+    for (i = 0; i < G_N_ELEMENTS (keys); i++) {
+        g_snprintf (keys[i], sizeof (keys[i]), "value-%u", i);
+        qcdm_result_add_u32 (result, keys[i], i * 3);
+    }
+    for (i = 0; i < G_N_ELEMENTS (array); i++)
+        array[i] = i;
+    qcdm_result_add_u16_array (result, TEST_TAG, array, G_N_ELEMENTS (array));
+    qcdm_result_add_string (result, "string", "foobarblahblahblah");
+
+    /* The last value added for a key wins */
+    qcdm_result_add_u32 (result, keys[5], 0xDEADBEEF);
+
+    /* Keys are matched by contents, not only by address */
+    for (i = 0; i < G_N_ELEMENTS (keys); i++) {
+        g_snprintf (lookup, sizeof (lookup), "value-%u", i);
+        g_assert_cmpint (qcdm_result_get_u32 (result, lookup, &tmp), ==, 0);
+        g_assert_cmpuint (tmp, ==, (i == 5) ? 0xDEADBEEF : i * 3);
+    }
+
+    g_assert_cmpint (qcdm_result_get_u16_array (result, TEST_TAG, &tmp_array, &tmp_len), ==, 0);
+    g_assert_cmpuint (tmp_len, ==, G_N_ELEMENTS (array));
+    g_assert_cmpint (memcmp (tmp_array, array, sizeof (array)), ==, 0);
+
+    g_assert_cmpint (qcdm_result_get_string (result, "string", &tmp_str), ==, 0);
+    g_assert_cmpstr (tmp_str, ==, "foobarblahblahblah");
+
+    g_assert_cmpint (qcdm_result_get_u32 (result, "missing", &tmp), ==, -QCDM_ERROR_VALUE_NOT_FOUND);
+
+    qcdm_result_unref (result);
+}
@@ -32,6 +32,8 @@ udev_rule_match_clear (MMUdevRuleMatch *rule_match)
 {
     g_free (rule_match->parameter);
     g_free (rule_match->value);
+    g_free (rule_match->name);
+    g_free (rule_match->value_prefix);
 }
 
 static void
@@ -115,6 +117,31 @@ out:
     return TRUE;
 }
 
+static MMUdevRuleMatchParameter
+attribute_to_parameter (const gchar *attribute)
+{
+    /* VID/PID/SUBSYSTEM VID are loaded from either USB or PCI attributes */
+    if (g_str_equal (attribute, "idVendor") || g_str_equal (attribute, "vendor"))
+        return MM_UDEV_RULE_MATCH_PARAMETER_ATTR_VID;
+    if (g_str_equal (attribute, "idProduct") || g_str_equal (attribute, "device"))
+        return MM_UDEV_RULE_MATCH_PARAMETER_ATTR_PID;
+    if (g_str_equal (attribute, "subsystem_vendor"))
+        return MM_UDEV_RULE_MATCH_PARAMETER_ATTR_SUBSYSTEM_VID;
+    if (g_str_equal (attribute, "manufacturer"))
+        return MM_UDEV_RULE_MATCH_PARAMETER_ATTR_MANUFACTURER;
+    if (g_str_equal (attribute, "product"))
+        return MM_UDEV_RULE_MATCH_PARAMETER_ATTR_PRODUCT;
+    if (g_str_equal (attribute, "bInterfaceClass"))
+        return MM_UDEV_RULE_MATCH_PARAMETER_ATTR_INTERFACE_CLASS;
+    if (g_str_equal (attribute, "bInterfaceSubClass"))
+        return MM_UDEV_RULE_MATCH_PARAMETER_ATTR_INTERFACE_SUBCLASS;
+    if (g_str_equal (attribute, "bInterfaceProtocol"))
+        return MM_UDEV_RULE_MATCH_PARAMETER_ATTR_INTERFACE_PROTOCOL;
+    if (g_str_equal (attribute, "bInterfaceNumber"))
+        return MM_UDEV_RULE_MATCH_PARAMETER_ATTR_INTERFACE_NUMBER;
+    return MM_UDEV_RULE_MATCH_PARAMETER_ATTR_OTHER;
+}
+
 static gboolean
 load_rule_result (MMUdevRuleResult  *rule_result,
                   const gchar       *item,
@@ -154,6 +181,20 @@ load_rule_result (MMUdevRuleResult  *rule_result,
         rule_result->type = MM_UDEV_RULE_RESULT_TYPE_PROPERTY;
         rule_result->content.property.name = g_strndup (left + 4, left_len - 5);
         rule_result->content.property.value = right;
+        rule_result->content.property.value_attr = MM_UDEV_RULE_MATCH_PARAMETER_UNKNOWN;
+        /* Only interface attributes are supported as value substitutions */
+        if (g_str_has_prefix (right, "$attr{") && g_str_has_suffix (right, "}")) {
+            g_autofree gchar         *attribute = NULL;
+            MMUdevRuleMatchParameter  value_attr;
+
+            attribute = g_strndup (right + 6, strlen (right) - 7);
+            value_attr = attribute_to_parameter (attribute);
+            if (value_attr == MM_UDEV_RULE_MATCH_PARAMETER_ATTR_INTERFACE_CLASS ||
+                value_attr == MM_UDEV_RULE_MATCH_PARAMETER_ATTR_INTERFACE_SUBCLASS ||
+                value_attr == MM_UDEV_RULE_MATCH_PARAMETER_ATTR_INTERFACE_PROTOCOL ||
+                value_attr == MM_UDEV_RULE_MATCH_PARAMETER_ATTR_INTERFACE_NUMBER)
+                rule_result->content.property.value_attr = value_attr;
+        }
         right = NULL;
         goto out;
     }
@@ -174,6 +215,52 @@ out:
     return TRUE;
 }
 
+static void
+compile_rule_match (MMUdevRuleMatch *rule_match)
+{
+    const gchar *parameter;
+
+    parameter = rule_match->parameter;
+
+    if (g_str_equal (parameter, "ACTION")) {
+        /* We only apply 'add' rules */
+        rule_match->parameter_kind = MM_UDEV_RULE_MATCH_PARAMETER_ACTION;
+        rule_match->value_uint = !!strstr (rule_match->value, "add");
+        rule_match->value_uint_valid = TRUE;
+    } else if (g_str_equal (parameter, "SUBSYSTEM"))
+        rule_match->parameter_kind = MM_UDEV_RULE_MATCH_PARAMETER_SUBSYSTEM;
+    else if (g_str_equal (parameter, "SUBSYSTEMS"))
+        rule_match->parameter_kind = MM_UDEV_RULE_MATCH_PARAMETER_SUBSYSTEMS;
+    else if (g_str_equal (parameter, "DRIVER"))
+        rule_match->parameter_kind = MM_UDEV_RULE_MATCH_PARAMETER_DRIVER;
+    else if (g_str_equal (parameter, "DRIVERS"))
+        rule_match->parameter_kind = MM_UDEV_RULE_MATCH_PARAMETER_DRIVERS;
+    else if (g_str_equal (parameter, "KERNEL"))
+        rule_match->parameter_kind = MM_UDEV_RULE_MATCH_PARAMETER_KERNEL;
+    else if (g_str_equal (parameter, "DEVPATH")) {
+        rule_match->parameter_kind = MM_UDEV_RULE_MATCH_PARAMETER_DEVPATH;
+        /* If not already doing a prefix match, do an implicit one. This is so that
+         * we can add properties to the usb_device owning all ports, and then apply
+         * the property to all ports individually processed here. */
+        if (rule_match->value[0] && rule_match->value[strlen (rule_match->value) - 1] != '*')
+            rule_match->value_prefix = g_strdup_printf ("%s/*", rule_match->value);
+    } else if (g_str_has_prefix (parameter, "ATTR")) {
+        rule_match->name = g_strdup (&parameter[5]);
+        g_strdelimit (rule_match->name, "{}", ' ');
+        g_strstrip (rule_match->name);
+        rule_match->lookup_parents = g_str_has_prefix (parameter, "ATTRS");
+        rule_match->parameter_kind = attribute_to_parameter (rule_match->name);
+        rule_match->value_any = g_str_equal (rule_match->value, "?*");
+        rule_match->value_uint_valid = mm_get_uint_from_hex_str (rule_match->value, &rule_match->value_uint);
+    } else if (g_str_has_prefix (parameter, "ENV")) {
+        rule_match->parameter_kind = MM_UDEV_RULE_MATCH_PARAMETER_ENV;
+        rule_match->name = g_strdup (&parameter[3]);
+        g_strdelimit (rule_match->name, "{}", ' ');
+        g_strstrip (rule_match->name);
+    } else
+        rule_match->parameter_kind = MM_UDEV_RULE_MATCH_PARAMETER_UNKNOWN;
+}
+
 static gboolean
 load_rule_match (MMUdevRuleMatch  *rule_match,
                  const gchar      *item,
@@ -203,6 +290,7 @@ load_rule_match (MMUdevRuleMatch  *rule_match,
     g_free (operator);
     rule_match->parameter = left;
     rule_match->value     = right;
+    compile_rule_match (rule_match);
     return TRUE;
 }
 
@@ -304,6 +392,59 @@ process_goto_tags (GArray  *rules,
     return TRUE;
 }
 
+static void
+rule_load_required_vid (MMUdevRule *rule)
+{
+    guint i;
+
+    if (!rule->conditions)
+        return;
+
+    for (i = 0; i < rule->conditions->len; i++) {
+        MMUdevRuleMatch *rule_match;
+
+        rule_match = &g_array_index (rule->conditions, MMUdevRuleMatch, i);
+        if (rule_match->parameter_kind == MM_UDEV_RULE_MATCH_PARAMETER_ATTR_VID &&
+            rule_match->type == MM_UDEV_RULE_MATCH_TYPE_EQUAL &&
+            rule_match->value_uint_valid &&
+            rule_match->value_uint <= G_MAXUINT16) {
+            rule->vid_required = TRUE;
+            rule->vid = (guint16) rule_match->value_uint;
+            return;
+        }
+    }
+}
+
+static void
+index_rule_vids (GArray *rules)
+{
+    guint i;
+
+    for (i = 0; i < rules->len; i++)
+        rule_load_required_vid (&g_array_index (rules, MMUdevRule, i));
+
+    /* Walk backwards so that each rule gated on a VID knows where the
+     * contiguous block of rules gated on the same VID ends. Skipping the
+     * block is safe because none of those rules may apply to a device
+     * with a different VID. */
+    i = rules->len;
+    while (i > 0) {
+        MMUdevRule *rule;
+        MMUdevRule *next;
+
+        i--;
+        rule = &g_array_index (rules, MMUdevRule, i);
+        if (!rule->vid_required)
+            continue;
+
+        next = (i + 1 < rules->len) ? &g_array_index (rules, MMUdevRule, i + 1) : NULL;
+        if (next && next->vid_required && next->vid == rule->vid)
+            rule->vid_block_end = next->vid_block_end;
+        else
+            rule->vid_block_end = i + 1;
+    }
+}
+
 static gboolean
 load_rules_from_file (GArray       *rules,
                       const gchar  *path,
@@ -428,6 +569,8 @@ mm_kernel_device_generic_rules_load (const gchar  *rules_dir,
         goto out;
     }
 
+    index_rule_vids (rules);
+
 out:
     if (rule_files)
         g_list_free_full (rule_files, g_free);
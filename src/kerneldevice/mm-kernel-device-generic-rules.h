@@ -23,10 +23,43 @@ typedef enum {
     MM_UDEV_RULE_MATCH_TYPE_NOT_EQUAL,
 } MMUdevRuleMatchType;
 
+/* Parameter kinds a match is compiled into when the rules are loaded, so that
+ * the per-device evaluation doesn't need to parse parameter strings */
+typedef enum {
+    MM_UDEV_RULE_MATCH_PARAMETER_UNKNOWN,
+    MM_UDEV_RULE_MATCH_PARAMETER_ACTION,
+    MM_UDEV_RULE_MATCH_PARAMETER_SUBSYSTEM,
+    MM_UDEV_RULE_MATCH_PARAMETER_SUBSYSTEMS,
+    MM_UDEV_RULE_MATCH_PARAMETER_DRIVER,
+    MM_UDEV_RULE_MATCH_PARAMETER_DRIVERS,
+    MM_UDEV_RULE_MATCH_PARAMETER_KERNEL,
+    MM_UDEV_RULE_MATCH_PARAMETER_DEVPATH,
+    MM_UDEV_RULE_MATCH_PARAMETER_ATTR_VID,
+    MM_UDEV_RULE_MATCH_PARAMETER_ATTR_PID,
+    MM_UDEV_RULE_MATCH_PARAMETER_ATTR_SUBSYSTEM_VID,
+    MM_UDEV_RULE_MATCH_PARAMETER_ATTR_MANUFACTURER,
+    MM_UDEV_RULE_MATCH_PARAMETER_ATTR_PRODUCT,
+    MM_UDEV_RULE_MATCH_PARAMETER_ATTR_INTERFACE_CLASS,
+    MM_UDEV_RULE_MATCH_PARAMETER_ATTR_INTERFACE_SUBCLASS,
+    MM_UDEV_RULE_MATCH_PARAMETER_ATTR_INTERFACE_PROTOCOL,
+    MM_UDEV_RULE_MATCH_PARAMETER_ATTR_INTERFACE_NUMBER,
+    MM_UDEV_RULE_MATCH_PARAMETER_ATTR_OTHER,
+    MM_UDEV_RULE_MATCH_PARAMETER_ENV,
+} MMUdevRuleMatchParameter;
+
 typedef struct {
-    MMUdevRuleMatchType  type;
-    gchar               *parameter;
-    gchar               *value;
+    MMUdevRuleMatchType       type;
+    gchar                    *parameter;
+    gchar                    *value;
+
+    /* Compiled contents */
+    MMUdevRuleMatchParameter  parameter_kind;
+    gchar                    *name;             /* ATTR/ATTRS/ENV name */
+    gboolean                  lookup_parents;   /* ATTRS */
+    gboolean                  value_any;        /* "?*" */
+    gboolean                  value_uint_valid;
+    guint                     value_uint;
+    gchar                    *value_prefix;     /* implicit DEVPATH prefix match */
 } MMUdevRuleMatch;
 
 typedef enum {
@@ -38,8 +71,10 @@ typedef enum {
 } MMUdevRuleResultType;
 
 typedef struct {
-    gchar *name;
-    gchar *value;
+    gchar                    *name;
+    gchar                    *value;
+    /* $attr{} substitution in the value, UNKNOWN if none */
+    MMUdevRuleMatchParameter  value_attr;
 } MMUdevRuleResultProperty;
 
 typedef struct {
@@ -54,6 +89,13 @@ typedef struct {
 typedef struct {
     GArray           *conditions;
     MMUdevRuleResult  result;
+
+    /* If the rule requires a specific physdev VID, index of the first rule
+     * after it not gated on that same VID, so that devices from other vendors
+     * skip the whole block at once. */
+    gboolean          vid_required;
+    guint16           vid;
+    guint             vid_block_end;
 } MMUdevRule;
 
 GArray *mm_kernel_device_generic_rules_load (const gchar  *rules_dir,
@@ -749,6 +749,14 @@ kernel_device_cmp (MMKernelDevice *a,
 
 /*****************************************************************************/
 
+static gboolean
+check_condition_uint (MMUdevRuleMatch *match,
+                      guint            value,
+                      gboolean         condition_equal)
+{
+    return (match->value_uint_valid && ((value == match->value_uint) == condition_equal));
+}
+
 static gboolean
 check_condition (MMKernelDeviceGeneric *self,
                  MMUdevRuleMatch       *match)
@@ -757,121 +765,87 @@ check_condition (MMKernelDeviceGeneric *self,
 
     condition_equal = (match->type == MM_UDEV_RULE_MATCH_TYPE_EQUAL);
 
-    /* We only apply 'add' rules */
-    if (g_str_equal (match->parameter, "ACTION"))
-        return ((!!strstr (match->value, "add")) == condition_equal);
+    switch (match->parameter_kind) {
+    case MM_UDEV_RULE_MATCH_PARAMETER_ACTION:
+        /* We only apply 'add' rules */
+        return (!!match->value_uint == condition_equal);
 
-    /* Exact SUBSYSTEM match */
-    if (g_str_equal (match->parameter, "SUBSYSTEM"))
+    case MM_UDEV_RULE_MATCH_PARAMETER_SUBSYSTEM:
+        /* Exact SUBSYSTEM match */
         return ((self->priv->subsystems && !g_strcmp0 (self->priv->subsystems[0], match->value)) == condition_equal);
 
-    /* Loose SUBSYSTEMS match */
-    if (g_str_equal (match->parameter, "SUBSYSTEMS"))
+    case MM_UDEV_RULE_MATCH_PARAMETER_SUBSYSTEMS:
+        /* Loose SUBSYSTEMS match */
         return ((self->priv->subsystems && g_strv_contains ((const gchar * const *) self->priv->subsystems, match->value)) == condition_equal);
 
-    /* Exact DRIVER match */
-    if (g_str_equal (match->parameter, "DRIVER"))
+    case MM_UDEV_RULE_MATCH_PARAMETER_DRIVER:
+        /* Exact DRIVER match */
         return ((self->priv->drivers && !g_strcmp0 (self->priv->drivers[0], match->value)) == condition_equal);
 
-    /* Loose DRIVERS match */
-    if (g_str_equal (match->parameter, "DRIVERS"))
+    case MM_UDEV_RULE_MATCH_PARAMETER_DRIVERS:
+        /* Loose DRIVERS match */
         return ((self->priv->drivers && g_strv_contains ((const gchar * const *) self->priv->drivers, match->value)) == condition_equal);
 
-    /* Device name checks */
-    if (g_str_equal (match->parameter, "KERNEL"))
+    case MM_UDEV_RULE_MATCH_PARAMETER_KERNEL:
+        /* Device name checks */
         return (mm_kernel_device_generic_string_match (mm_kernel_device_get_name (MM_KERNEL_DEVICE (self)), match->value, self) == condition_equal);
 
-    /* Device sysfs path checks; we allow both a direct match and a prefix patch */
-    if (g_str_equal (match->parameter, "DEVPATH")) {
-        g_autofree gchar *prefix_match = NULL;
+    case MM_UDEV_RULE_MATCH_PARAMETER_DEVPATH:
+        /* Device sysfs path checks; we allow both a direct match and a prefix patch */
 
         /* If sysfs path invalid (e.g. path doesn't exist), no match */
         if (!self->priv->sysfs_path)
             return FALSE;
 
-        /* If not already doing a prefix match, do an implicit one. This is so that
-         * we can add properties to the usb_device owning all ports, and then apply
-         * the property to all ports individually processed here. */
-        if (match->value[0] && match->value[strlen (match->value) - 1] != '*')
-            prefix_match = g_strdup_printf ("%s/*", match->value);
-
         if ((mm_kernel_device_generic_string_match (self->priv->sysfs_path, match->value, self) == condition_equal) ||
-            (prefix_match && mm_kernel_device_generic_string_match (self->priv->sysfs_path, prefix_match, self) == condition_equal))
+            (match->value_prefix && mm_kernel_device_generic_string_match (self->priv->sysfs_path, match->value_prefix, self) == condition_equal))
             return TRUE;
 
         if (g_str_has_prefix (self->priv->sysfs_path, "/sys")) {
             if ((mm_kernel_device_generic_string_match (&self->priv->sysfs_path[4], match->value, self) == condition_equal) ||
-                (prefix_match && mm_kernel_device_generic_string_match (&self->priv->sysfs_path[4], prefix_match, self) == condition_equal))
+                (match->value_prefix && mm_kernel_device_generic_string_match (&self->priv->sysfs_path[4], match->value_prefix, self) == condition_equal))
                 return TRUE;
         }
         return FALSE;
-    }
-
-    /* Attributes checks */
-    if (g_str_has_prefix (match->parameter, "ATTR")) {
-        gchar    *attribute;
-        gchar    *contents = NULL;
-        gboolean  result = FALSE;
-        guint     val;
-
-        attribute = g_strdup (&match->parameter[5]);
-        g_strdelimit (attribute, "{}", ' ');
-        g_strstrip (attribute);
-
-        /* VID/PID/SUBSYSTEM VID directly from our API */
-        if (g_str_equal (attribute, "idVendor") || g_str_equal (attribute, "vendor"))
-            result = ((mm_get_uint_from_hex_str (match->value, &val)) &&
-                      ((mm_kernel_device_get_physdev_vid (MM_KERNEL_DEVICE (self)) == val) == condition_equal));
-        else if (g_str_equal (attribute, "idProduct") || g_str_equal (attribute, "device"))
-            result = ((mm_get_uint_from_hex_str (match->value, &val)) &&
-                      ((mm_kernel_device_get_physdev_pid (MM_KERNEL_DEVICE (self)) == val) == condition_equal));
-        else if (g_str_equal (attribute, "subsystem_vendor"))
-            result = ((mm_get_uint_from_hex_str (match->value, &val)) &&
-                      ((mm_kernel_device_get_physdev_subsystem_vid (MM_KERNEL_DEVICE (self)) == val) == condition_equal));
-        /* manufacturer in the physdev */
-        else if (g_str_equal (attribute, "manufacturer"))
-            result = ((self->priv->physdev_manufacturer && g_str_equal (self->priv->physdev_manufacturer, match->value)) == condition_equal);
-        /* product in the physdev */
-        else if (g_str_equal (attribute, "product"))
-            result = ((self->priv->physdev_product && g_str_equal (self->priv->physdev_product, match->value)) == condition_equal);
-        /* interface class/subclass/protocol/number in the interface */
-        else if (g_str_equal (attribute, "bInterfaceClass"))
-            result = (g_str_equal (match->value, "?*") || ((mm_get_uint_from_hex_str (match->value, &val)) &&
-                                                           ((self->priv->interface_class == val) == condition_equal)));
-        else if (g_str_equal (attribute, "bInterfaceSubClass"))
-            result = (g_str_equal (match->value, "?*") || ((mm_get_uint_from_hex_str (match->value, &val)) &&
-                                                           ((self->priv->interface_subclass == val) == condition_equal)));
-        else if (g_str_equal (attribute, "bInterfaceProtocol"))
-            result = (g_str_equal (match->value, "?*") || ((mm_get_uint_from_hex_str (match->value, &val)) &&
-                                                           ((self->priv->interface_protocol == val) == condition_equal)));
-        else if (g_str_equal (attribute, "bInterfaceNumber"))
-            result = (g_str_equal (match->value, "?*") || ((mm_get_uint_from_hex_str (match->value, &val)) &&
-                                                           ((self->priv->interface_number == val) == condition_equal)));
-        else {
-            g_autofree gchar *found_value = NULL;
-
-            found_value = lookup_sysfs_attribute_as_string (self, attribute, g_str_has_prefix (match->parameter, "ATTRS"));
-            result = ((found_value && g_str_equal (found_value, match->value)) == condition_equal);
-        }
 
-        g_free (contents);
-        g_free (attribute);
-        return result;
+    /* VID/PID/SUBSYSTEM VID directly from our API */
+    case MM_UDEV_RULE_MATCH_PARAMETER_ATTR_VID:
+        return check_condition_uint (match, self->priv->physdev_vid, condition_equal);
+    case MM_UDEV_RULE_MATCH_PARAMETER_ATTR_PID:
+        return check_condition_uint (match, self->priv->physdev_pid, condition_equal);
+    case MM_UDEV_RULE_MATCH_PARAMETER_ATTR_SUBSYSTEM_VID:
+        return check_condition_uint (match, self->priv->physdev_subsystem_vid, condition_equal);
+
+    /* manufacturer and product in the physdev */
+    case MM_UDEV_RULE_MATCH_PARAMETER_ATTR_MANUFACTURER:
+        return ((self->priv->physdev_manufacturer && g_str_equal (self->priv->physdev_manufacturer, match->value)) == condition_equal);
+    case MM_UDEV_RULE_MATCH_PARAMETER_ATTR_PRODUCT:
+        return ((self->priv->physdev_product && g_str_equal (self->priv->physdev_product, match->value)) == condition_equal);
+
+    /* interface class/subclass/protocol/number in the interface */
+    case MM_UDEV_RULE_MATCH_PARAMETER_ATTR_INTERFACE_CLASS:
+        return (match->value_any || check_condition_uint (match, self->priv->interface_class, condition_equal));
+    case MM_UDEV_RULE_MATCH_PARAMETER_ATTR_INTERFACE_SUBCLASS:
+        return (match->value_any || check_condition_uint (match, self->priv->interface_subclass, condition_equal));
+    case MM_UDEV_RULE_MATCH_PARAMETER_ATTR_INTERFACE_PROTOCOL:
+        return (match->value_any || check_condition_uint (match, self->priv->interface_protocol, condition_equal));
+    case MM_UDEV_RULE_MATCH_PARAMETER_ATTR_INTERFACE_NUMBER:
+        return (match->value_any || check_condition_uint (match, self->priv->interface_number, condition_equal));
+
+    case MM_UDEV_RULE_MATCH_PARAMETER_ATTR_OTHER: {
+        g_autofree gchar *found_value = NULL;
+
+        found_value = lookup_sysfs_attribute_as_string (self, match->name, match->lookup_parents);
+        return ((found_value && g_str_equal (found_value, match->value)) == condition_equal);
     }
 
-    /* Previously set property checks */
-    if (g_str_has_prefix (match->parameter, "ENV")) {
-        gchar    *property;
-        gboolean  result = FALSE;
-
-        property = g_strdup (&match->parameter[3]);
-        g_strdelimit (property, "{}", ' ');
-        g_strstrip (property);
-
-        result = ((!g_strcmp0 ((const gchar *) g_object_get_data (G_OBJECT (self), property), match->value)) == condition_equal);
+    case MM_UDEV_RULE_MATCH_PARAMETER_ENV:
+        /* Previously set property checks */
+        return ((!g_strcmp0 ((const gchar *) g_object_get_data (G_OBJECT (self), match->name), match->value)) == condition_equal);
 
-        g_free (property);
-        return result;
+    case MM_UDEV_RULE_MATCH_PARAMETER_UNKNOWN:
+    default:
+        break;
     }
 
     mm_obj_warn (self, "unknown match condition parameter: %s", match->parameter);
@@ -888,6 +862,11 @@ check_rule (MMKernelDeviceGeneric *self,
     g_assert (rule_i < self->priv->rules->len);
 
     rule = &g_array_index (self->priv->rules, MMUdevRule, rule_i);
+
+    /* Skip the whole block of rules gated on a different VID */
+    if (rule->vid_required && rule->vid != self->priv->physdev_vid)
+        return rule->vid_block_end;
+
     if (rule->conditions) {
         guint condition_i;
 
@@ -907,14 +886,22 @@ check_rule (MMKernelDeviceGeneric *self,
         case MM_UDEV_RULE_RESULT_TYPE_PROPERTY: {
             gchar *property_value_read = NULL;
 
-            if (g_str_equal (rule->result.content.property.value, "$attr{bInterfaceClass}"))
+            switch (rule->result.content.property.value_attr) {
+            case MM_UDEV_RULE_MATCH_PARAMETER_ATTR_INTERFACE_CLASS:
                 property_value_read = g_strdup_printf ("%02x", self->priv->interface_class);
-            else if (g_str_equal (rule->result.content.property.value, "$attr{bInterfaceSubClass}"))
+                break;
+            case MM_UDEV_RULE_MATCH_PARAMETER_ATTR_INTERFACE_SUBCLASS:
                 property_value_read = g_strdup_printf ("%02x", self->priv->interface_subclass);
-            else if (g_str_equal (rule->result.content.property.value, "$attr{bInterfaceProtocol}"))
+                break;
+            case MM_UDEV_RULE_MATCH_PARAMETER_ATTR_INTERFACE_PROTOCOL:
                 property_value_read = g_strdup_printf ("%02x", self->priv->interface_protocol);
-            else if (g_str_equal (rule->result.content.property.value, "$attr{bInterfaceNumber}"))
+                break;
+            case MM_UDEV_RULE_MATCH_PARAMETER_ATTR_INTERFACE_NUMBER:
                 property_value_read = g_strdup_printf ("%02x", self->priv->interface_number);
+                break;
+            default:
+                break;
+            }
 
             /* add new property */
             mm_obj_dbg (self, "property added: %s=%s",
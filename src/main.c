@@ -16,6 +16,7 @@
 
 #include <config.h>
 #include <signal.h>
+#include <errno.h>
 #include <syslog.h>
 #include <string.h>
 #include <unistd.h>
@@ -30,6 +31,8 @@
 #include "mm-log.h"
 #include "mm-base-manager.h"
 #include "mm-context.h"
+#include "mm-modem-cache.h"
+#include "mm-serial-trace.h"
 
 #if defined WITH_SUSPEND_RESUME
 # include "mm-sleep-monitor.h"
@@ -38,6 +41,10 @@
 /* Maximum time to wait for all modems to get disabled and removed */
 #define MAX_SHUTDOWN_TIME_SECS 20
 
+/* Where serial port traces are dumped if no explicit path given; the
+ * directory is private to the daemon as traces may contain personal info */
+#define DEFAULT_SERIAL_TRACE_FILE "serial-trace.bin"
+
 static GMainLoop *loop;
 static MMBaseManager *manager;
 
@@ -56,6 +63,29 @@ quit_cb (gpointer user_data)
     return FALSE;
 }
 
+static gboolean
+dump_serial_traces_cb (gpointer user_data)
+{
+    g_autofree gchar  *path = NULL;
+    g_autoptr(GError)  error = NULL;
+
+    if (mm_context_get_serial_trace_file ())
+        path = g_strdup (mm_context_get_serial_trace_file ());
+    else {
+        if (g_mkdir_with_parents (SERIALTRACEDIR, 0700) < 0) {
+            mm_warn ("couldn't create serial port traces directory %s: %s", SERIALTRACEDIR, g_strerror (errno));
+            return G_SOURCE_CONTINUE;
+        }
+        path = g_build_filename (SERIALTRACEDIR, DEFAULT_SERIAL_TRACE_FILE, NULL);
+    }
+
+    if (!mm_serial_trace_dump_all (path, &error))
+        mm_warn ("couldn't dump serial port traces: %s", error->message);
+    else
+        mm_msg ("serial port traces dumped to %s", path);
+    return G_SOURCE_CONTINUE;
+}
+
 #if defined WITH_SUSPEND_RESUME
 
 static void
@@ -170,6 +200,8 @@ main (int argc, char *argv[])
                        mm_context_get_log_timestamps (),
                        mm_context_get_log_relative_timestamps (),
                        mm_context_get_log_personal_info (),
+                       mm_context_get_log_async (),
+                       mm_context_get_log_filter (),
                        &error)) {
         g_printerr ("error: failed to set up logging: %s\n", error->message);
         g_error_free (error);
@@ -178,6 +210,11 @@ main (int argc, char *argv[])
 
     g_unix_signal_add (SIGTERM, quit_cb, NULL);
     g_unix_signal_add (SIGINT, quit_cb, NULL);
+    g_unix_signal_add (SIGUSR1, dump_serial_traces_cb, NULL);
+
+    mm_serial_trace_set_size (mm_context_get_serial_trace_size ());
+    mm_serial_trace_set_show_personal_info (mm_context_get_log_personal_info ());
+    mm_modem_cache_set_path (mm_context_get_modem_cache ());
 
     /* Early register all known errors */
     register_dbus_errors ();
@@ -23,6 +23,7 @@
 #include <unistd.h>
 #include <string.h>
 #include <ctype.h>
+#include <net/if.h>
 
 #include <ModemManager.h>
 #define _LIBMM_INSIDE_MM
@@ -40,6 +41,9 @@
 #include "mm-error-helpers.h"
 #include "mm-bearer-stats.h"
 #include "mm-dispatcher-connection.h"
+#include "mm-netlink.h"
+#include "mm-property-batch.h"
+#include "mm-context.h"
 
 /* We require up to 20s to get a proper IP when using PPP */
 #define BEARER_IP_TIMEOUT_DEFAULT 20
@@ -48,6 +52,10 @@
 
 #define BEARER_STATS_UPDATE_TIMEOUT 30
 
+/* Reading the kernel interface counters is cheap, so they may be
+ * refreshed more often; the interval is configurable */
+#define BEARER_INTERFACE_STATS_UPDATE_TIMEOUT_MS (BEARER_STATS_UPDATE_TIMEOUT * 1000)
+
 /* Initial connectivity check after 30s, then each 5s */
 #define BEARER_CONNECTION_MONITOR_INITIAL_TIMEOUT 30
 #define BEARER_CONNECTION_MONITOR_TIMEOUT          5
@@ -127,6 +135,16 @@ struct _MMBaseBearerPrivate {
     GTimer *duration_timer;
     /* Flag to specify whether reloading stats is supported or not */
     gboolean reload_stats_supported;
+    /* Index of the network interface whose kernel counters are used as
+     * stats source, or 0 if the stats are reloaded from the modem */
+    guint interface_stats_ifindex;
+    /* Interface counters since the connection started */
+    gboolean                interface_stats_baseline_set;
+    MMInterfaceStatsCounter interface_stats_rx_bytes;
+    MMInterfaceStatsCounter interface_stats_tx_bytes;
+
+    /* Batched updates of the D-Bus interface properties */
+    MMPropertyBatch *property_batch;
 };
 
 /*****************************************************************************/
@@ -304,9 +322,11 @@ bearer_update_connection_error (MMBaseBearer *self,
 static void
 bearer_update_interface_stats (MMBaseBearer *self)
 {
-    mm_gdbus_bearer_set_stats (
-        MM_GDBUS_BEARER (self),
-        mm_bearer_stats_get_dictionary (self->priv->stats));
+    /* Stats may be updated very frequently, so batch them */
+    mm_property_batch_set_variant (self->priv->property_batch,
+                                   self,
+                                   "stats",
+                                   mm_bearer_stats_get_dictionary (self->priv->stats));
 }
 
 static void
@@ -411,6 +431,82 @@ reload_stats_ready (MMBaseBearer *self,
                                         tx_bytes);
 }
 
+static gboolean
+interface_stats_read_counter (const gchar *interface,
+                              const gchar *counter,
+                              guint64     *value)
+{
+    g_autofree gchar *path = NULL;
+    g_autofree gchar *contents = NULL;
+
+    path = g_strdup_printf ("/sys/class/net/%s/statistics/%s", interface, counter);
+    if (!g_file_get_contents (path, &contents, NULL, NULL))
+        return FALSE;
+    return mm_get_u64_from_str (g_strstrip (contents), value);
+}
+
+static void
+interface_stats_set_baseline (MMBaseBearer *self,
+                              const gchar  *interface)
+{
+    guint64 rx_bytes;
+    guint64 tx_bytes;
+
+    /* Read right away, so that all traffic since the connection was
+     * established is accounted; otherwise done by the first poll */
+    if (!interface_stats_read_counter (interface, "rx_bytes", &rx_bytes) ||
+        !interface_stats_read_counter (interface, "tx_bytes", &tx_bytes)) {
+        mm_obj_dbg (self, "couldn't read initial stats of interface %s", interface);
+        return;
+    }
+
+    mm_interface_stats_counter_init (&self->priv->interface_stats_rx_bytes, rx_bytes);
+    mm_interface_stats_counter_init (&self->priv->interface_stats_tx_bytes, tx_bytes);
+    self->priv->interface_stats_baseline_set = TRUE;
+}
+
+static void
+interface_stats_ready (MMNetlink    *netlink,
+                       GAsyncResult *res,
+                       MMBaseBearer *self)
+{
+    g_autoptr(GHashTable)     link_stats = NULL;
+    g_autoptr(GError)         error = NULL;
+    const MMNetlinkLinkStats *stats;
+
+    link_stats = mm_netlink_get_link_stats_finish (netlink, res, &error);
+    if (!link_stats) {
+        mm_obj_warn (self, "reloading interface stats failed: %s", error->message);
+        goto out;
+    }
+
+    /* Ignore results if we got disconnected in the meantime */
+    if (self->priv->status != MM_BEARER_STATUS_CONNECTED || !self->priv->interface_stats_ifindex)
+        goto out;
+
+    stats = g_hash_table_lookup (link_stats, GUINT_TO_POINTER (self->priv->interface_stats_ifindex));
+    if (!stats) {
+        mm_obj_warn (self, "reloading interface stats failed: interface not found");
+        goto out;
+    }
+
+    /* Counters are cumulative since the interface was created, so make them
+     * relative to the start of the connection */
+    if (!self->priv->interface_stats_baseline_set) {
+        mm_interface_stats_counter_init (&self->priv->interface_stats_rx_bytes, stats->rx_bytes);
+        mm_interface_stats_counter_init (&self->priv->interface_stats_tx_bytes, stats->tx_bytes);
+        self->priv->interface_stats_baseline_set = TRUE;
+    }
+
+    bearer_set_ongoing_interface_stats (self,
+                                        (guint32) g_timer_elapsed (self->priv->duration_timer, NULL),
+                                        mm_interface_stats_counter_update (&self->priv->interface_stats_rx_bytes, stats->rx_bytes),
+                                        mm_interface_stats_counter_update (&self->priv->interface_stats_tx_bytes, stats->tx_bytes));
+
+out:
+    g_object_unref (self);
+}
+
 static gboolean
 stats_update_cb (MMBaseBearer *self)
 {
@@ -418,6 +514,15 @@ stats_update_cb (MMBaseBearer *self)
     if (self->priv->status != MM_BEARER_STATUS_CONNECTED)
         return G_SOURCE_CONTINUE;
 
+    /* If we can read the kernel interface counters, no need to query the modem */
+    if (self->priv->interface_stats_ifindex) {
+        mm_netlink_get_link_stats (mm_netlink_get (),
+                                   NULL,
+                                   (GAsyncReadyCallback)interface_stats_ready,
+                                   g_object_ref (self));
+        return G_SOURCE_CONTINUE;
+    }
+
     /* If the implementation knows how to update stat values, run it */
     if (self->priv->reload_stats_supported) {
         MM_BASE_BEARER_GET_CLASS (self)->reload_stats (
@@ -437,18 +542,45 @@ stats_update_cb (MMBaseBearer *self)
 
 static void
 bearer_stats_start (MMBaseBearer *self,
+                    const gchar  *interface,
+                    gboolean      multiplexed,
+                    gboolean      ppp,
                     guint64       uplink_speed,
                     guint64       downlink_speed)
 {
+    guint interval;
+
     /* Start duration timer */
     g_assert (!self->priv->duration_timer);
     self->priv->duration_timer = g_timer_new ();
 
+    /* The kernel counters of the network interface are used as stats source,
+     * except for PPP and multiplexed links, where the counters of the
+     * interface may not match the ones of the bearer. */
+    self->priv->interface_stats_ifindex = 0;
+    self->priv->interface_stats_baseline_set = FALSE;
+    if (interface && !multiplexed && !ppp) {
+        self->priv->interface_stats_ifindex = if_nametoindex (interface);
+        if (!self->priv->interface_stats_ifindex)
+            mm_obj_dbg (self, "couldn't get interface index of %s, stats reloaded from the modem", interface);
+        else
+            interface_stats_set_baseline (self, interface);
+    }
+
     /* Schedule */
     g_assert (!self->priv->stats_update_id);
-    self->priv->stats_update_id = g_timeout_add_seconds (BEARER_STATS_UPDATE_TIMEOUT,
-                                                         (GSourceFunc) stats_update_cb,
-                                                         self);
+    if (self->priv->interface_stats_ifindex) {
+        interval = mm_context_get_bearer_stats_interval ();
+        if (!interval)
+            interval = BEARER_INTERFACE_STATS_UPDATE_TIMEOUT_MS;
+        mm_obj_dbg (self, "stats loaded from interface %s every %ums", interface, interval);
+        self->priv->stats_update_id = g_timeout_add (interval,
+                                                     (GSourceFunc) stats_update_cb,
+                                                     self);
+    } else
+        self->priv->stats_update_id = g_timeout_add_seconds (BEARER_STATS_UPDATE_TIMEOUT,
+                                                             (GSourceFunc) stats_update_cb,
+                                                             self);
 
     mm_bearer_stats_set_start_date (self->priv->stats, (guint64)(g_get_real_time() / G_USEC_PER_SEC));
     mm_bearer_stats_set_uplink_speed (self->priv->stats, uplink_speed);
@@ -544,6 +676,9 @@ bearer_update_status (MMBaseBearer *self,
     self->priv->status = status;
     g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_STATUS]);
 
+    /* Apply pending batched updates before the connection status changes */
+    mm_property_batch_flush (self->priv->property_batch);
+
     /* Ensure that we don't expose any connection related data in the
      * interface when going into disconnected state. */
     if (self->priv->status == MM_BEARER_STATUS_DISCONNECTED) {
@@ -555,8 +690,9 @@ bearer_update_status (MMBaseBearer *self,
         bearer_reset_interface_status (self);
         /* Cleanup flag to ignore disconnection reports */
         self->priv->ignore_disconnection_reports = FALSE;
-        /* Stop statistics */
+        /* Stop statistics, reporting the final ones right away */
         bearer_stats_stop (self);
+        mm_property_batch_flush (self->priv->property_batch);
         /* Stop connection monitoring */
         connection_monitor_stop (self);
 
@@ -566,7 +702,7 @@ bearer_update_status (MMBaseBearer *self,
                                 "connection #%u finished: duration %us",
                                 mm_bearer_stats_get_attempts (self->priv->stats),
                                 mm_bearer_stats_get_duration (self->priv->stats));
-        if (self->priv->reload_stats_supported)
+        if (self->priv->reload_stats_supported || self->priv->interface_stats_ifindex)
             g_string_append_printf (report,
                                     ", tx: %" G_GUINT64_FORMAT " bytes, rx: %" G_GUINT64_FORMAT " bytes",
                                     mm_bearer_stats_get_tx_bytes (self->priv->stats),
@@ -585,6 +721,8 @@ bearer_update_status_connected (MMBaseBearer     *self,
                                 guint64           uplink_speed,
                                 guint64           downlink_speed)
 {
+    gboolean ppp;
+
     mm_gdbus_bearer_set_profile_id (MM_GDBUS_BEARER (self), profile_id);
     mm_gdbus_bearer_set_multiplexed (MM_GDBUS_BEARER (self), multiplexed);
     mm_gdbus_bearer_set_connected (MM_GDBUS_BEARER (self), TRUE);
@@ -601,8 +739,9 @@ bearer_update_status_connected (MMBaseBearer     *self,
      * all disconnection reports found via CGACT? polling or CGEV URCs.
      * In this case, upper layers should always explicitly disconnect
      * the bearer when ownership of the TTY is given back to MM. */
-    if ((ipv4_config && mm_bearer_ip_config_get_method (ipv4_config) == MM_BEARER_IP_METHOD_PPP) ||
-        (ipv6_config && mm_bearer_ip_config_get_method (ipv6_config) == MM_BEARER_IP_METHOD_PPP)) {
+    ppp = ((ipv4_config && mm_bearer_ip_config_get_method (ipv4_config) == MM_BEARER_IP_METHOD_PPP) ||
+           (ipv6_config && mm_bearer_ip_config_get_method (ipv6_config) == MM_BEARER_IP_METHOD_PPP));
+    if (ppp) {
         mm_obj_dbg (self, "PPP is required for connection, will ignore disconnection reports");
         self->priv->ignore_disconnection_reports = TRUE;
     }
@@ -612,7 +751,7 @@ bearer_update_status_connected (MMBaseBearer     *self,
     g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_STATUS]);
 
     /* Start statistics */
-    bearer_stats_start (self, uplink_speed, downlink_speed);
+    bearer_stats_start (self, interface, multiplexed, ppp, uplink_speed, downlink_speed);
 
     /* Start connection monitor, if supported */
     connection_monitor_start (self);
@@ -1863,6 +2002,7 @@ mm_base_bearer_init (MMBaseBearer *self)
     self->priv->reason_cdma = CONNECTION_FORBIDDEN_REASON_NONE;
     self->priv->reload_stats_supported = FALSE;
     self->priv->stats = mm_bearer_stats_new ();
+    self->priv->property_batch = mm_property_batch_new (mm_context_get_property_batch_window ());
 
     /* Set defaults */
     mm_gdbus_bearer_set_interface   (MM_GDBUS_BEARER (self), NULL);
@@ -1886,6 +2026,7 @@ finalize (GObject *object)
     MMBaseBearer *self = MM_BASE_BEARER (object);
 
     g_free (self->priv->path);
+    mm_property_batch_free (self->priv->property_batch);
 
     G_OBJECT_CLASS (mm_base_bearer_parent_class)->finalize (object);
 }
@@ -1897,6 +2038,8 @@ dispose (GObject *object)
 
     connection_monitor_stop (self);
     bearer_stats_stop (self);
+    /* Pending updates keep a reference to the bearer itself */
+    mm_property_batch_flush (self->priv->property_batch);
     g_clear_object (&self->priv->stats);
 
     if (self->priv->connection) {
@@ -50,6 +50,8 @@
 #include "mm-daemon-enums-types.h"
 #include "mm-device.h"
 #include "mm-plugin-manager.h"
+#include "mm-port-probe-cache.h"
+#include "mm-serial-trace.h"
 #include "mm-auth-provider.h"
 #include "mm-plugin.h"
 #include "mm-filter.h"
@@ -230,11 +232,16 @@ device_support_check_ready (MMPluginManager          *plugin_manager,
         mm_obj_warn (ctx->self, "couldn't create modem for device '%s': %s",
                      mm_device_get_uid (ctx->device), error->message);
         g_error_free (error);
+        /* Don't trust any cached probing result that led to this */
+        mm_port_probe_cache_invalidate (ctx->device);
         g_hash_table_remove (ctx->self->priv->devices, mm_device_get_uid (ctx->device));
         find_device_support_context_free (ctx);
         return;
     }
 
+    /* Store the probing results that allowed creating the modem */
+    mm_port_probe_cache_store (ctx->device);
+
     /* Modem now created */
     mm_obj_msg (ctx->self, "modem for device '%s' successfully created",
                 mm_device_get_uid (ctx->device));
@@ -1416,6 +1423,24 @@ out:
     return TRUE;
 }
 
+static gboolean
+handle_dump_serial_traces (MmGdbusTest           *skeleton,
+                           GDBusMethodInvocation *invocation,
+                           const gchar           *path,
+                           MMBaseManager         *self)
+{
+    GError *error = NULL;
+
+    if (!mm_serial_trace_dump_all (path, &error)) {
+        g_dbus_method_invocation_take_error (invocation, error);
+        return TRUE;
+    }
+
+    mm_obj_msg (self, "serial port traces dumped to %s", path);
+    mm_gdbus_test_complete_dump_serial_traces (skeleton, invocation);
+    return TRUE;
+}
+
 #endif
 
 /*****************************************************************************/
@@ -1657,6 +1682,10 @@ initable_init (GInitable     *initable,
                           "handle-set-profile",
                           G_CALLBACK (handle_set_profile),
                           initable);
+        g_signal_connect (self->priv->test_skeleton,
+                          "handle-dump-serial-traces",
+                          G_CALLBACK (handle_dump_serial_traces),
+                          initable);
         if (!g_dbus_interface_skeleton_export (G_DBUS_INTERFACE_SKELETON (self->priv->test_skeleton),
                                                self->priv->connection,
                                                MM_DBUS_PATH,
@@ -13,6 +13,8 @@
  * Copyright (C) 2011 Aleksander Morgado <aleksander@gnu.org>
  */
 
+#include <string.h>
+
 #include <glib.h>
 #include <glib-object.h>
 
@@ -20,6 +22,8 @@
 
 #include "mm-base-modem-at.h"
 #include "mm-errors-types.h"
+#include "mm-log-object.h"
+#include "mm-modem-helpers.h"
 
 static gboolean
 abort_task_if_port_unusable (MMBaseModem *self,
@@ -91,6 +95,9 @@ typedef struct {
     gpointer                    response_processor_context;
     GDestroyNotify              response_processor_context_free;
     GVariant                   *result;
+    /* Command line in flight when merging several commands */
+    gchar                      *batch_line;
+    guint                       batch_n_commands;
 } AtSequenceContext;
 
 static void
@@ -111,6 +118,7 @@ at_sequence_context_free (AtSequenceContext *ctx)
 
     if (ctx->result)
         g_variant_unref (ctx->result);
+    g_free (ctx->batch_line);
     g_free (ctx);
 }
 
@@ -140,25 +148,17 @@ mm_base_modem_at_sequence_full_finish (MMBaseModem   *self,
     return result;
 }
 
-static void
-at_sequence_parse_response (MMPortSerialAt    *port,
-                            GAsyncResult      *res,
-                            GTask             *task)
+/* Returns TRUE if the sequence is over, in which case the task has already
+ * been completed */
+static gboolean
+at_sequence_process_response (GTask        *task,
+                              const gchar  *response,
+                              const GError *error)
 {
     MMBaseModemAtResponseProcessorResult  processor_result;
     GVariant                             *result = NULL;
     GError                               *result_error = NULL;
     AtSequenceContext                    *ctx;
-    g_autofree gchar                     *response = NULL;
-    GError                               *error = NULL;
-
-    response = mm_port_serial_at_command_finish (port, res, &error);
-
-    /* Cancelled? */
-    if (g_task_return_error_if_cancelled (task)) {
-        g_object_unref (task);
-        return;
-    }
 
     ctx = g_task_get_task_data (task);
     if (!ctx->current->response_processor)
@@ -187,32 +187,16 @@ at_sequence_parse_response (MMPortSerialAt    *port,
                 g_assert (!result && result_error); /* result is optional */
                 g_task_return_error (task, result_error);
                 g_object_unref (task);
-                if (error)
-                    g_error_free (error);
-                return;
+                return TRUE;
             default:
                 g_assert_not_reached ();
         }
     }
 
-    if (error)
-        g_error_free (error);
-
     if (processor_result == MM_BASE_MODEM_AT_RESPONSE_PROCESSOR_RESULT_CONTINUE) {
         ctx->current++;
-        if (ctx->current->command) {
-            /* Schedule the next command in the probing group */
-            mm_port_serial_at_command (
-                ctx->port,
-                ctx->current->command,
-                ctx->current->timeout,
-                FALSE,
-                ctx->current->allow_cached,
-                g_task_get_cancellable (task),
-                (GAsyncReadyCallback)at_sequence_parse_response,
-                task);
-            return;
-        }
+        if (ctx->current->command)
+            return FALSE;
         /* On last command, end. */
     }
 
@@ -224,6 +208,210 @@ at_sequence_parse_response (MMPortSerialAt    *port,
     /* transfer-none, the result remains owned by the GTask context */
     g_task_return_pointer (task, ctx->result, NULL);
     g_object_unref (task);
+    return TRUE;
+}
+
+static void at_sequence_run (GTask *task);
+
+static void
+at_sequence_parse_response (MMPortSerialAt *port,
+                            GAsyncResult   *res,
+                            GTask          *task)
+{
+    g_autofree gchar  *response = NULL;
+    g_autoptr(GError)  error = NULL;
+
+    response = mm_port_serial_at_command_finish (port, res, &error);
+
+    /* Cancelled? */
+    if (g_task_return_error_if_cancelled (task)) {
+        g_object_unref (task);
+        return;
+    }
+
+    if (!at_sequence_process_response (task, response, error))
+        at_sequence_run (task);
+}
+
+/*****************************************************************************/
+/* AT command batching
+ *
+ * In modems flagged with MM_BASE_MODEM_AT_BATCHING, consecutive extended read
+ * and test commands of a sequence are merged in a single command line, e.g.
+ * AT+COPS?;#PSNT?;+SERVICE?, saving one round trip per merged command. The
+ * combined reply is split back using the information response prefixes and
+ * each slice is given to the response processor of its command, exactly as
+ * if the commands had been sent one by one.
+ *
+ * If the modem rejects the line (e.g. because one of the commands is not
+ * supported) or the reply can't be split unambiguously, the commands are
+ * sent one by one instead, and the line is not tried again in this modem.
+ * Merged commands run even if a previous processor ends the sequence, which
+ * is harmless as they have no side effects.
+ */
+
+/* Must fit the 40-character minimum command line buffer of V.250 modems,
+ * once the leading AT is added */
+#define AT_BATCH_MAX_LINE_LENGTH 38
+#define AT_BATCH_MAX_COMMANDS    4
+
+static GQuark rejected_batches_quark;
+
+static GHashTable *
+peek_rejected_batches (MMBaseModem *self)
+{
+    GHashTable *rejected;
+
+    if (G_UNLIKELY (!rejected_batches_quark))
+        rejected_batches_quark = g_quark_from_static_string ("at-rejected-batches");
+
+    rejected = g_object_get_qdata (G_OBJECT (self), rejected_batches_quark);
+    if (!rejected) {
+        rejected = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+        g_object_set_qdata_full (G_OBJECT (self),
+                                 rejected_batches_quark,
+                                 rejected,
+                                 (GDestroyNotify)g_hash_table_unref);
+    }
+    return rejected;
+}
+
+/* Builds the command line merging the commands of the sequence from the
+ * current one, or returns NULL if there is nothing to merge */
+static gchar *
+at_sequence_build_batch (MMBaseModem       *self,
+                         AtSequenceContext *ctx,
+                         guint             *n_commands)
+{
+    g_autoptr(GString) line = NULL;
+    gsize              prefix_lens[AT_BATCH_MAX_COMMANDS];
+    guint              n = 0;
+
+    line = g_string_new (NULL);
+    while (n < AT_BATCH_MAX_COMMANDS && ctx->current[n].command) {
+        const gchar *command = ctx->current[n].command;
+        guint        i;
+
+        if (!mm_at_command_is_batchable (command, &prefix_lens[n]))
+            break;
+        if (line->len + 1 + strlen (command) > AT_BATCH_MAX_LINE_LENGTH)
+            break;
+
+        /* Replies to commands with the same name can't be told apart */
+        for (i = 0; i < n; i++) {
+            if (prefix_lens[i] == prefix_lens[n] &&
+                !g_ascii_strncasecmp (ctx->current[i].command, command, prefix_lens[n]))
+                break;
+        }
+        if (i < n)
+            break;
+
+        if (line->len)
+            g_string_append_c (line, ';');
+        g_string_append (line, command);
+        n++;
+    }
+
+    if (n < 2 || g_hash_table_contains (peek_rejected_batches (self), line->str))
+        return NULL;
+
+    *n_commands = n;
+    return g_string_free (g_steal_pointer (&line), FALSE);
+}
+
+static void
+at_sequence_parse_batch_response (MMPortSerialAt *port,
+                                  GAsyncResult   *res,
+                                  GTask          *task)
+{
+    MMBaseModem         *self;
+    AtSequenceContext   *ctx;
+    g_autofree gchar    *response = NULL;
+    g_autoptr(GError)    error = NULL;
+    g_auto(GStrv)        split = NULL;
+    const gchar         *commands[AT_BATCH_MAX_COMMANDS];
+    guint                i;
+
+    response = mm_port_serial_at_command_finish (port, res, &error);
+
+    /* Cancelled? */
+    if (g_task_return_error_if_cancelled (task)) {
+        g_object_unref (task);
+        return;
+    }
+
+    self = g_task_get_source_object (task);
+    ctx = g_task_get_task_data (task);
+    g_assert (ctx->batch_line);
+
+    for (i = 0; i < ctx->batch_n_commands; i++)
+        commands[i] = ctx->current[i].command;
+
+    if (!error)
+        split = mm_at_command_batch_split_response (response, commands, ctx->batch_n_commands);
+
+    if (!split) {
+        mm_obj_dbg (self, "couldn't run batched commands '%s' (%s): sending them one by one",
+                    ctx->batch_line, error ? error->message : "unexpected reply");
+        g_hash_table_add (peek_rejected_batches (self), g_steal_pointer (&ctx->batch_line));
+        at_sequence_run (task);
+        return;
+    }
+
+    g_clear_pointer (&ctx->batch_line, g_free);
+    for (i = 0; i < ctx->batch_n_commands; i++) {
+        if (at_sequence_process_response (task, split[i], NULL))
+            return;
+    }
+    at_sequence_run (task);
+}
+
+/*****************************************************************************/
+
+static void
+at_sequence_run (GTask *task)
+{
+    AtSequenceContext *ctx;
+    MMBaseModem       *self;
+
+    self = g_task_get_source_object (task);
+    ctx = g_task_get_task_data (task);
+
+    if (mm_base_modem_get_at_batching (self)) {
+        g_assert (!ctx->batch_line);
+        ctx->batch_line = at_sequence_build_batch (self, ctx, &ctx->batch_n_commands);
+        if (ctx->batch_line) {
+            gboolean allow_cached = TRUE;
+            guint    timeout = 0;
+            guint    i;
+
+            for (i = 0; i < ctx->batch_n_commands; i++) {
+                allow_cached &= ctx->current[i].allow_cached;
+                timeout += ctx->current[i].timeout;
+            }
+
+            mm_port_serial_at_command (
+                ctx->port,
+                ctx->batch_line,
+                timeout,
+                FALSE,
+                allow_cached,
+                g_task_get_cancellable (task),
+                (GAsyncReadyCallback)at_sequence_parse_batch_response,
+                task);
+            return;
+        }
+    }
+
+    mm_port_serial_at_command (
+        ctx->port,
+        ctx->current->command,
+        ctx->current->timeout,
+        FALSE,
+        ctx->current->allow_cached,
+        g_task_get_cancellable (task),
+        (GAsyncReadyCallback)at_sequence_parse_response,
+        task);
 }
 
 static void
@@ -264,15 +452,7 @@ at_sequence_common (MMBaseModem                *self,
     g_task_set_task_data (task, ctx, (GDestroyNotify)at_sequence_context_free);
 
     /* Go on with the first one in the sequence */
-    mm_port_serial_at_command (
-        ctx->port,
-        ctx->current->command,
-        ctx->current->timeout,
-        FALSE,
-        ctx->current->allow_cached,
-        g_task_get_cancellable (task),
-        (GAsyncReadyCallback)at_sequence_parse_response,
-        task);
+    at_sequence_run (task);
 }
 
 void
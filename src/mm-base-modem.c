@@ -38,6 +38,7 @@
 #include "mm-port-enums-types.h"
 #include "mm-serial-parsers.h"
 #include "mm-modem-helpers.h"
+#include "mm-property-batch.h"
 
 static void log_object_iface_init (MMLogObjectInterface *iface);
 
@@ -62,6 +63,7 @@ enum {
     PROP_REPROBE,
     PROP_DATA_NET_SUPPORTED,
     PROP_DATA_TTY_SUPPORTED,
+    PROP_AT_BATCHING,
     PROP_LAST
 };
 
@@ -111,6 +113,9 @@ struct _MMBaseModemPrivate {
     gboolean  data_net_supported;
     gboolean  data_tty_supported;
 
+    /* Whether AT sequences may merge several commands in a single line */
+    gboolean at_batching;
+
     /* GPS-enabled modems will have an AT port for control, and a raw serial
      * port to receive all GPS traces */
     MMPortSerialAt *gps_control;
@@ -136,6 +141,9 @@ struct _MMBaseModemPrivate {
     /* Additional port links grabbed after having
      * organized ports */
     GHashTable *link_ports;
+
+    /* Batched updates of the D-Bus interface properties */
+    MMPropertyBatch *property_batch;
 };
 
 guint
@@ -238,6 +246,12 @@ base_modem_create_tty_port (MMBaseModem        *self,
                          name, inner_error->message);
     }
 
+    /* Optional user-provided burst write mode */
+    if (mm_kernel_device_get_property_as_boolean (kernel_device, ID_MM_TTY_BURST_WRITE))
+        g_object_set (port,
+                      MM_PORT_SERIAL_BURST_WRITE, TRUE,
+                      NULL);
+
     return port;
 }
 
@@ -942,6 +956,14 @@ mm_base_modem_get_reprobe (MMBaseModem *self)
     return self->priv->reprobe;
 }
 
+gboolean
+mm_base_modem_get_at_batching (MMBaseModem *self)
+{
+    g_return_val_if_fail (MM_IS_BASE_MODEM (self), FALSE);
+
+    return self->priv->at_batching;
+}
+
 gboolean
 mm_base_modem_get_valid (MMBaseModem *self)
 {
@@ -958,6 +980,16 @@ mm_base_modem_peek_cancellable (MMBaseModem *self)
     return self->priv->cancellable;
 }
 
+MMPropertyBatch *
+mm_base_modem_peek_property_batch (MMBaseModem *self)
+{
+    g_return_val_if_fail (MM_IS_BASE_MODEM (self), NULL);
+
+    if (!self->priv->property_batch)
+        self->priv->property_batch = mm_property_batch_new (mm_context_get_property_batch_window ());
+    return self->priv->property_batch;
+}
+
 MMPortSerialAt *
 mm_base_modem_get_port_primary (MMBaseModem *self)
 {
@@ -1935,6 +1967,9 @@ set_property (GObject *object,
     case PROP_DATA_TTY_SUPPORTED:
         self->priv->data_tty_supported = g_value_get_boolean (value);
         break;
+    case PROP_AT_BATCHING:
+        self->priv->at_batching = g_value_get_boolean (value);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
         break;
@@ -1986,6 +2021,9 @@ get_property (GObject *object,
     case PROP_DATA_TTY_SUPPORTED:
         g_value_set_boolean (value, self->priv->data_tty_supported);
         break;
+    case PROP_AT_BATCHING:
+        g_value_set_boolean (value, self->priv->at_batching);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
         break;
@@ -2009,6 +2047,7 @@ finalize (GObject *object)
     g_free (self->priv->device);
     g_strfreev (self->priv->drivers);
     g_free (self->priv->plugin);
+    g_clear_pointer (&self->priv->property_batch, mm_property_batch_free);
 
     G_OBJECT_CLASS (mm_base_modem_parent_class)->finalize (object);
 }
@@ -2049,6 +2088,9 @@ dispose (GObject *object)
     teardown_ports_table (self, &self->priv->link_ports);
     teardown_ports_table (self, &self->priv->ports);
 
+    /* Pending property updates are discarded */
+    g_clear_pointer (&self->priv->property_batch, mm_property_batch_free);
+
     g_clear_object (&self->priv->connection);
 
     G_OBJECT_CLASS (mm_base_modem_parent_class)->dispose (object);
@@ -2170,6 +2212,14 @@ mm_base_modem_class_init (MMBaseModemClass *klass)
                               G_PARAM_READWRITE);
     g_object_class_install_property (object_class, PROP_DATA_TTY_SUPPORTED, properties[PROP_DATA_TTY_SUPPORTED]);
 
+    properties[PROP_AT_BATCHING] =
+        g_param_spec_boolean (MM_BASE_MODEM_AT_BATCHING,
+                              "AT batching",
+                              "Whether AT sequences may merge several read commands in a single command line.",
+                              FALSE,
+                              G_PARAM_READWRITE);
+    g_object_class_install_property (object_class, PROP_AT_BATCHING, properties[PROP_AT_BATCHING]);
+
     signals[SIGNAL_LINK_PORT_GRABBED] =
         g_signal_new (MM_BASE_MODEM_SIGNAL_LINK_PORT_GRABBED,
                       G_OBJECT_CLASS_TYPE (object_class),
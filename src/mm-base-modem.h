@@ -35,6 +35,7 @@
 #include "mm-port-serial-at.h"
 #include "mm-port-serial-qcdm.h"
 #include "mm-port-serial-gps.h"
+#include "mm-property-batch.h"
 
 #if defined WITH_QMI
 #include "mm-port-qmi.h"
@@ -67,6 +68,7 @@ typedef struct _MMBaseModemPrivate MMBaseModemPrivate;
 #define MM_BASE_MODEM_REPROBE             "base-modem-reprobe"
 #define MM_BASE_MODEM_DATA_NET_SUPPORTED  "base-modem-data-net-supported"
 #define MM_BASE_MODEM_DATA_TTY_SUPPORTED  "base-modem-data-tty-supported"
+#define MM_BASE_MODEM_AT_BATCHING         "base-modem-at-batching"
 
 #define MM_BASE_MODEM_SIGNAL_LINK_PORT_GRABBED  "base-modem-link-port-grabbed"
 #define MM_BASE_MODEM_SIGNAL_LINK_PORT_RELEASED "base-modem-link-port-released"
@@ -204,6 +206,8 @@ void     mm_base_modem_set_reprobe (MMBaseModem *self,
                                     gboolean reprobe);
 gboolean mm_base_modem_get_reprobe (MMBaseModem *self);
 
+gboolean mm_base_modem_get_at_batching (MMBaseModem *self);
+
 const gchar  *mm_base_modem_get_device  (MMBaseModem *self);
 const gchar **mm_base_modem_get_drivers (MMBaseModem *self);
 const gchar  *mm_base_modem_get_plugin  (MMBaseModem *self);
@@ -214,6 +218,9 @@ guint mm_base_modem_get_subsystem_vendor_id (MMBaseModem *self);
 
 GCancellable *mm_base_modem_peek_cancellable (MMBaseModem *self);
 
+/* Batched updates of the properties of the modem D-Bus interfaces */
+MMPropertyBatch *mm_base_modem_peek_property_batch (MMBaseModem *self);
+
 void     mm_base_modem_authorize        (MMBaseModem *self,
                                          GDBusMethodInvocation *invocation,
                                          const gchar *authorization,
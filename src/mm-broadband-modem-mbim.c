@@ -4992,6 +4992,8 @@ basic_connect_notification_register_state (MMBroadbandModemMbim *self,
 
     if (!common_process_register_state (self, device, notification, NULL, &error))
         mm_obj_warn (self, "%s", error->message);
+    else
+        mm_iface_modem_3gpp_unsolicited_registration_processed (MM_IFACE_MODEM_3GPP (self));
 }
 
 typedef struct {
@@ -9857,6 +9859,7 @@ iface_modem_init (MMIfaceModem *iface)
     iface->setup_carrier_config_finish = mm_shared_qmi_setup_carrier_config_finish;
     iface->load_supported_bands = mm_shared_qmi_load_supported_bands;
     iface->load_supported_bands_finish = mm_shared_qmi_load_supported_bands_finish;
+    iface->supported_modes_bands_stateful = TRUE;
     iface->load_current_bands = mm_shared_qmi_load_current_bands;
     iface->load_current_bands_finish = mm_shared_qmi_load_current_bands_finish;
     iface->set_current_bands = mm_shared_qmi_set_current_bands;
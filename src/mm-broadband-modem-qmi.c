@@ -5108,8 +5108,10 @@ system_info_indication_cb (QmiClientNas *client,
                            QmiIndicationNasSystemInfoOutput *output,
                            MMBroadbandModemQmi *self)
 {
-    if (mm_iface_modem_is_3gpp (MM_IFACE_MODEM (self)))
+    if (mm_iface_modem_is_3gpp (MM_IFACE_MODEM (self))) {
         common_process_system_info_3gpp (self, NULL, output);
+        mm_iface_modem_3gpp_unsolicited_registration_processed (MM_IFACE_MODEM_3GPP (self));
+    }
 }
 
 static void
@@ -5127,9 +5129,10 @@ serving_system_indication_cb (QmiClientNas *client,
                               QmiIndicationNasServingSystemOutput *output,
                               MMBroadbandModemQmi *self)
 {
-    if (mm_iface_modem_is_3gpp (MM_IFACE_MODEM (self)))
+    if (mm_iface_modem_is_3gpp (MM_IFACE_MODEM (self))) {
         common_process_serving_system_3gpp (self, NULL, output);
-    else if (mm_iface_modem_is_cdma (MM_IFACE_MODEM (self)))
+        mm_iface_modem_3gpp_unsolicited_registration_processed (MM_IFACE_MODEM_3GPP (self));
+    } else if (mm_iface_modem_is_cdma (MM_IFACE_MODEM (self)))
         common_process_serving_system_cdma (self, NULL, output);
 }
 
@@ -13680,6 +13683,7 @@ iface_modem_init (MMIfaceModem *iface)
     iface->load_supported_bands_finish = mm_shared_qmi_load_supported_bands_finish;
     iface->load_supported_modes = mm_shared_qmi_load_supported_modes;
     iface->load_supported_modes_finish = mm_shared_qmi_load_supported_modes_finish;
+    iface->supported_modes_bands_stateful = TRUE;
     iface->load_power_state = load_power_state;
     iface->load_power_state_finish = load_power_state_finish;
     iface->load_supported_ip_families = modem_load_supported_ip_families;
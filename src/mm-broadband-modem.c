@@ -4844,6 +4844,7 @@ registration_state_changed (MMPortSerialAt *port,
         }
         mm_iface_modem_3gpp_update_cs_registration_state (MM_IFACE_MODEM_3GPP (self), state, FALSE);
     }
+    mm_iface_modem_3gpp_unsolicited_registration_processed (MM_IFACE_MODEM_3GPP (self));
 
     /* Only update access technologies from CREG/CGREG response if the modem
      * doesn't have custom commands for access technology loading, otherwise
@@ -676,6 +676,135 @@ mm_charset_gsm_pack (const guint8 *src,
     return packed;
 }
 
+/*****************************************************************************/
+/* Direct conversions to UTF-8 into caller-provided buffers */
+
+static inline guint8
+gsm_septet_at (const guint8 *gsm,
+               guint8        start_offset,
+               guint32       i)
+{
+    guint32 start_bit;
+    guint8  offset;
+    guint8  bits_here;
+    guint8  c;
+
+    start_bit = start_offset + (i * 7);
+    offset = start_bit % 8;
+    bits_here = offset ? (8 - offset) : 7;
+
+    c = (gsm[start_bit / 8] >> offset) & (0xFF >> (8 - bits_here));
+    if (bits_here < 7)
+        c |= (gsm[(start_bit / 8) + 1] & (0xFF >> (1 + bits_here))) << bits_here;
+    return c;
+}
+
+gssize
+mm_charset_gsm_packed_to_utf8 (const guint8  *gsm,
+                               guint32        num_septets,
+                               guint8         start_offset,  /* in bits */
+                               gchar         *out,
+                               gsize          out_size,
+                               GError       **error)
+{
+    guint32 end;
+    guint32 i;
+    gsize   written = 0;
+
+    g_return_val_if_fail (out_size >= MM_CHARSET_GSM_PACKED_TO_UTF8_MAX_LEN (num_septets), -1);
+
+    /* Trailing '@' (0x00) septets are padding, see charset_gsm_unpacked_to_utf8() */
+    for (end = num_septets; end > 0 && !gsm_septet_at (gsm, start_offset, end - 1); end--);
+
+    for (i = 0; i < end; i++) {
+        guint8 c;
+        guint8 ulen = 0;
+
+        c = gsm_septet_at (gsm, start_offset, i);
+        if (c == GSM_ESCAPE_CHAR) {
+            /* Extended alphabet, decode next char */
+            if (i + 1 < end) {
+                ulen = gsm_ext_char_to_utf8 (gsm_septet_at (gsm, start_offset, i + 1), (guint8 *) &out[written]);
+                if (ulen)
+                    i += 1;
+            }
+        } else
+            ulen = gsm_def_char_to_utf8 (c, (guint8 *) &out[written]);
+
+        if (!ulen) {
+            g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
+                         "Invalid conversion from GSM7");
+            return -1;
+        }
+        written += ulen;
+    }
+
+    out[written] = '\0';
+    return (gssize) written;
+}
+
+gssize
+mm_charset_utf16be_to_utf8 (const guint8  *utf16,
+                            gsize          len,
+                            gchar         *out,
+                            gsize          out_size,
+                            GError       **error)
+{
+    gsize i;
+    gsize written = 0;
+
+    g_return_val_if_fail (out_size >= MM_CHARSET_UTF16BE_TO_UTF8_MAX_LEN (len), -1);
+
+    if (len % 2) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
+                     "Invalid conversion from UTF-16: partial character");
+        return -1;
+    }
+
+    for (i = 0; i < len; i += 2) {
+        gunichar c;
+
+        c = (utf16[i] << 8) | utf16[i + 1];
+
+        /* Embedded NUL terminates the string */
+        if (!c)
+            break;
+
+        /* Plain ASCII is by far the most common case */
+        if (c < 0x80) {
+            out[written++] = (gchar) c;
+            continue;
+        }
+
+        if (c >= 0xD800 && c <= 0xDBFF) {
+            gunichar low;
+
+            if (i + 3 >= len) {
+                g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
+                             "Invalid conversion from UTF-16: truncated surrogate pair");
+                return -1;
+            }
+            low = (utf16[i + 2] << 8) | utf16[i + 3];
+            if (low < 0xDC00 || low > 0xDFFF) {
+                g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
+                             "Invalid conversion from UTF-16: invalid surrogate pair");
+                return -1;
+            }
+            c = 0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00);
+            i += 2;
+        } else if (c >= 0xDC00 && c <= 0xDFFF) {
+            g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
+                         "Invalid conversion from UTF-16: unpaired surrogate");
+            return -1;
+        }
+
+        written += g_unichar_to_utf8 (c, &out[written]);
+    }
+
+    out[written] = '\0';
+    return (gssize) written;
+}
+
 /*****************************************************************************/
 /* Main conversion functions */
 
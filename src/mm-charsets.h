@@ -51,6 +51,30 @@ guint8 *mm_charset_gsm_pack (const guint8 *src,
                              guint8        start_offset,  /* in bits */
                              guint32      *out_packed_len);
 
+/*
+ * Convert directly into UTF-8 the given packed GSM-7 septets or UTF-16BE
+ * bytes, without intermediate allocations.
+ *
+ * The output is written NUL-terminated into the given buffer, which must be
+ * at least as big as the corresponding _MAX_LEN() size. The length of the
+ * output string is returned, or -1 on error.
+ */
+#define MM_CHARSET_GSM_PACKED_TO_UTF8_MAX_LEN(num_septets) ((num_septets) * 2 + 1)
+#define MM_CHARSET_UTF16BE_TO_UTF8_MAX_LEN(len)            (((len) / 2) * 3 + 1)
+
+gssize mm_charset_gsm_packed_to_utf8 (const guint8  *gsm,
+                                      guint32        num_septets,
+                                      guint8         start_offset,  /* in bits */
+                                      gchar         *out,
+                                      gsize          out_size,
+                                      GError       **error);
+
+gssize mm_charset_utf16be_to_utf8    (const guint8  *utf16,
+                                      gsize          len,
+                                      gchar         *out,
+                                      gsize          out_size,
+                                      GError       **error);
+
 /*****************************************************************************************/
 
 /*
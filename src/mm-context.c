@@ -21,6 +21,7 @@
 #include <libmm-glib.h>
 
 #include "mm-context.h"
+#include "mm-serial-trace.h"
 
 /*****************************************************************************/
 /* Application context */
@@ -41,6 +42,12 @@ static gboolean      debug;
 static MMFilterRule  filter_policy = MM_FILTER_POLICY_STRICT;
 static gboolean      no_auto_scan = NO_AUTO_SCAN_DEFAULT;
 static const gchar  *initial_kernel_events;
+static const gchar  *probe_cache;
+static const gchar  *modem_cache;
+static gint          serial_trace_size = MM_SERIAL_TRACE_DEFAULT_SIZE;
+static const gchar  *serial_trace_file;
+static gint          bearer_stats_interval;
+static gint          property_batch_window;
 
 static gboolean
 filter_policy_option_arg (const gchar  *option_name,
@@ -84,6 +91,36 @@ static const GOptionEntry entries[] = {
         "Path to initial kernel events file",
         "[PATH]"
     },
+    {
+        "probe-cache", 0, 0, G_OPTION_ARG_FILENAME, &probe_cache,
+        "Path to the persistent port probing results cache",
+        "[PATH]"
+    },
+    {
+        "modem-cache", 0, 0, G_OPTION_ARG_FILENAME, &modem_cache,
+        "Path to the persistent cache of static modem properties",
+        "[PATH]"
+    },
+    {
+        "serial-trace-size", 0, 0, G_OPTION_ARG_INT, &serial_trace_size,
+        "Size in bytes of the in-memory traffic trace of each serial port, 0 (default) to disable",
+        "[SIZE]"
+    },
+    {
+        "serial-trace-file", 0, 0, G_OPTION_ARG_FILENAME, &serial_trace_file,
+        "Path where serial port traces are dumped on SIGUSR1",
+        "[PATH]"
+    },
+    {
+        "bearer-stats-interval", 0, 0, G_OPTION_ARG_INT, &bearer_stats_interval,
+        "Interval in milliseconds (at least 1000) to refresh bearer stats from network interface counters",
+        "[MSECS]"
+    },
+    {
+        "property-batch-window", 0, 0, G_OPTION_ARG_INT, &property_batch_window,
+        "Time window in milliseconds to batch frequent D-Bus property updates",
+        "[MSECS]"
+    },
     {
         "debug", 0, 0, G_OPTION_ARG_NONE, &debug,
         "Run with extended debugging capabilities",
@@ -114,6 +151,47 @@ mm_context_get_initial_kernel_events (void)
     return initial_kernel_events;
 }
 
+const gchar *
+mm_context_get_probe_cache (void)
+{
+    return probe_cache;
+}
+
+const gchar *
+mm_context_get_modem_cache (void)
+{
+    return modem_cache;
+}
+
+guint
+mm_context_get_serial_trace_size (void)
+{
+    return (guint) MAX (serial_trace_size, 0);
+}
+
+const gchar *
+mm_context_get_serial_trace_file (void)
+{
+    return serial_trace_file;
+}
+
+/* Shorter intervals would just keep the daemon busy */
+#define BEARER_STATS_INTERVAL_MIN_MS 1000
+
+guint
+mm_context_get_bearer_stats_interval (void)
+{
+    if (bearer_stats_interval <= 0)
+        return 0;
+    return (guint) MAX (bearer_stats_interval, BEARER_STATS_INTERVAL_MIN_MS);
+}
+
+guint
+mm_context_get_property_batch_window (void)
+{
+    return (guint) MAX (property_batch_window, 0);
+}
+
 gboolean
 mm_context_get_no_auto_scan (void)
 {
@@ -135,6 +213,8 @@ static gboolean     log_journal;
 static gboolean     log_show_ts;
 static gboolean     log_rel_ts;
 static gboolean     log_personal_info;
+static gboolean     log_async;
+static const gchar *log_filter;
 
 static const GOptionEntry log_entries[] = {
     {
@@ -169,6 +249,16 @@ static const GOptionEntry log_entries[] = {
         "Show personal info in logs",
         NULL
     },
+    {
+        "log-async", 0, 0, G_OPTION_ARG_NONE, &log_async,
+        "Write log messages from a separate thread",
+        NULL
+    },
+    {
+        "log-filter", 0, 0, G_OPTION_ARG_STRING, &log_filter,
+        "Per object or module log levels, e.g. modem3=DEBUG,quectel=INFO",
+        "[FILTER]"
+    },
     { NULL }
 };
 
@@ -222,6 +312,18 @@ mm_context_get_log_personal_info (void)
     return log_personal_info;
 }
 
+gboolean
+mm_context_get_log_async (void)
+{
+    return log_async;
+}
+
+const gchar *
+mm_context_get_log_filter (void)
+{
+    return log_filter;
+}
+
 /*****************************************************************************/
 /* Test context */
 
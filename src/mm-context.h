@@ -30,6 +30,12 @@ void mm_context_init (gint    argc,
 
 gboolean     mm_context_get_debug                 (void);
 const gchar *mm_context_get_initial_kernel_events (void);
+const gchar *mm_context_get_probe_cache           (void);
+const gchar *mm_context_get_modem_cache           (void);
+guint        mm_context_get_serial_trace_size     (void);
+const gchar *mm_context_get_serial_trace_file     (void);
+guint        mm_context_get_bearer_stats_interval (void);
+guint        mm_context_get_property_batch_window (void);
 gboolean     mm_context_get_no_auto_scan          (void);
 
 /* Filter support */
@@ -42,6 +48,8 @@ gboolean     mm_context_get_log_journal             (void);
 gboolean     mm_context_get_log_timestamps          (void);
 gboolean     mm_context_get_log_relative_timestamps (void);
 gboolean     mm_context_get_log_personal_info       (void);
+gboolean     mm_context_get_log_async               (void);
+const gchar *mm_context_get_log_filter              (void);
 
 /* Testing support */
 gboolean     mm_context_get_test_session           (void);
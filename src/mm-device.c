@@ -25,6 +25,7 @@
 
 #include "mm-device.h"
 #include "mm-plugin.h"
+#include "mm-port-probe-cache.h"
 #include "mm-log-object.h"
 
 static void log_object_iface_init (MMLogObjectInterface *iface);
@@ -453,7 +454,9 @@ modem_valid (MMBaseModem *modem,
              MMDevice    *self)
 {
     if (!mm_base_modem_get_valid (modem)) {
-        /* Modem no longer valid */
+        /* Modem no longer valid; the probing results may be the reason, so
+         * don't reuse them next time */
+        mm_port_probe_cache_invalidate (self);
         mm_device_remove_modem (self);
         if (mm_base_modem_get_reprobe (modem))
             self->priv->reprobe_id = g_timeout_add_seconds (REPROBE_SECS, (GSourceFunc)reprobe, self);
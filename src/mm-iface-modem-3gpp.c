@@ -75,6 +75,10 @@ typedef struct {
     /* Registration checks */
     guint    check_timeout_source;
     gboolean check_running;
+    /* Watchdog verifying the unsolicited registration events */
+    guint    urc_watchdog_source;
+    guint    urc_watchdog_timeout;
+    GTask   *urc_watchdog_task;
     /* Packet service state */
     gboolean packet_service_state_update_supported;
 } Private;
@@ -89,6 +93,8 @@ private_free (Private *priv)
     }
     if (priv->check_timeout_source)
         g_source_remove (priv->check_timeout_source);
+    if (priv->urc_watchdog_source)
+        g_source_remove (priv->urc_watchdog_source);
     g_slice_free (Private, priv);
 }
 
@@ -2240,6 +2246,10 @@ update_registration_state (MMIfaceModem3gpp             *self,
             return;
     }
 
+    /* Registration changes are critical, apply any pending batched property
+     * update so that clients see them in order */
+    mm_property_batch_flush (mm_base_modem_peek_property_batch (MM_BASE_MODEM (self)));
+
     if (mm_modem_3gpp_registration_state_is_registered (new_state)) {
         MMModemState modem_state;
 
@@ -2439,6 +2449,180 @@ periodic_registration_check_enable (MMIfaceModem3gpp *self)
                                                         self);
 }
 
+/*****************************************************************************/
+/* Unsolicited registration events watchdog
+ *
+ * Once unsolicited registration events are enabled, no registration checks
+ * are run periodically, as the modem reports every change. In order to detect
+ * modems that don't really report them (or that stop doing it, e.g. if the
+ * unsolicited reporting setup is lost), the registration state is checked
+ * every now and then. If the check finds a registration state that was not
+ * reported, the periodic registration checks are enabled; otherwise the
+ * watchdog interval is doubled, up to a maximum.
+ *
+ * Unsolicited events received while the check is running update the state
+ * the check result is compared against, so that a change reported by them
+ * isn't taken as an unreported one.
+ */
+
+#define REGISTRATION_URC_WATCHDOG_MIN_TIMEOUT_SEC 120
+#define REGISTRATION_URC_WATCHDOG_MAX_TIMEOUT_SEC 1920
+
+typedef struct {
+    MMModem3gppRegistrationState state_cs;
+    MMModem3gppRegistrationState state_ps;
+    MMModem3gppRegistrationState state_eps;
+    MMModem3gppRegistrationState state_5gs;
+} RegistrationUrcWatchdogContext;
+
+static gboolean registration_urc_watchdog_check (MMIfaceModem3gpp *self);
+
+static void
+registration_urc_watchdog_schedule (MMIfaceModem3gpp *self)
+{
+    Private *priv;
+
+    priv = get_private (self);
+    g_assert (!priv->urc_watchdog_source);
+    priv->urc_watchdog_source = g_timeout_add_seconds (priv->urc_watchdog_timeout,
+                                                       (GSourceFunc)registration_urc_watchdog_check,
+                                                       self);
+}
+
+static void
+registration_urc_watchdog_check_ready (MMIfaceModem3gpp *self,
+                                       GAsyncResult     *res,
+                                       GTask            *task)
+{
+    RegistrationUrcWatchdogContext *ctx;
+    Private                        *priv;
+    g_autoptr(GError)               error = NULL;
+
+    priv = get_private (self);
+    ctx = g_task_get_task_data (task);
+    priv->check_running = FALSE;
+    priv->urc_watchdog_task = NULL;
+
+    /* Disabled while running? */
+    if (!priv->urc_watchdog_timeout)
+        goto out;
+
+    if (!mm_iface_modem_3gpp_run_registration_checks_finish (self, res, &error)) {
+        mm_obj_dbg (self, "couldn't verify 3GPP registration status: %s", error->message);
+        registration_urc_watchdog_schedule (self);
+        goto out;
+    }
+
+    if (ctx->state_cs  != priv->state_cs  ||
+        ctx->state_ps  != priv->state_ps  ||
+        ctx->state_eps != priv->state_eps ||
+        ctx->state_5gs != priv->state_5gs) {
+        mm_obj_msg (self, "3GPP registration state change not reported by unsolicited events: "
+                    "enabling periodic registration checks");
+        priv->urc_watchdog_timeout = 0;
+        periodic_registration_check_enable (self);
+        goto out;
+    }
+
+    priv->urc_watchdog_timeout = MIN (priv->urc_watchdog_timeout * 2, REGISTRATION_URC_WATCHDOG_MAX_TIMEOUT_SEC);
+    mm_obj_dbg (self, "3GPP registration status verified, next check in %us", priv->urc_watchdog_timeout);
+    registration_urc_watchdog_schedule (self);
+
+out:
+    g_object_unref (task);
+}
+
+static gboolean
+registration_urc_watchdog_check (MMIfaceModem3gpp *self)
+{
+    RegistrationUrcWatchdogContext *ctx;
+    Private                        *priv;
+    GTask                          *task;
+
+    priv = get_private (self);
+    priv->urc_watchdog_source = 0;
+
+    /* Retry later if some other check is running */
+    if (priv->check_running) {
+        registration_urc_watchdog_schedule (self);
+        return G_SOURCE_REMOVE;
+    }
+
+    /* Keep the registration state known before the check */
+    ctx = g_new0 (RegistrationUrcWatchdogContext, 1);
+    ctx->state_cs  = priv->state_cs;
+    ctx->state_ps  = priv->state_ps;
+    ctx->state_eps = priv->state_eps;
+    ctx->state_5gs = priv->state_5gs;
+
+    task = g_task_new (self, NULL, NULL, NULL);
+    g_task_set_task_data (task, ctx, g_free);
+
+    priv->check_running = TRUE;
+    priv->urc_watchdog_task = task;
+    mm_iface_modem_3gpp_run_registration_checks (
+        self,
+        (GAsyncReadyCallback)registration_urc_watchdog_check_ready,
+        task);
+    return G_SOURCE_REMOVE;
+}
+
+void
+mm_iface_modem_3gpp_unsolicited_registration_processed (MMIfaceModem3gpp *self)
+{
+    RegistrationUrcWatchdogContext *ctx;
+    Private                        *priv;
+
+    priv = get_private (self);
+    if (!priv->urc_watchdog_task)
+        return;
+
+    ctx = g_task_get_task_data (priv->urc_watchdog_task);
+    ctx->state_cs  = priv->state_cs;
+    ctx->state_ps  = priv->state_ps;
+    ctx->state_eps = priv->state_eps;
+    ctx->state_5gs = priv->state_5gs;
+}
+
+static void
+registration_urc_watchdog_disable (MMIfaceModem3gpp *self)
+{
+    Private *priv;
+
+    priv = get_private (self);
+
+    if (priv->urc_watchdog_source) {
+        g_source_remove (priv->urc_watchdog_source);
+        priv->urc_watchdog_source = 0;
+    }
+    if (priv->urc_watchdog_timeout) {
+        priv->urc_watchdog_timeout = 0;
+        mm_obj_dbg (self, "3GPP unsolicited registration events watchdog disabled");
+    }
+}
+
+static void
+registration_urc_watchdog_enable (MMIfaceModem3gpp *self)
+{
+    Private *priv;
+
+    priv = get_private (self);
+
+    /* Not needed if periodic checks are enabled */
+    if (priv->check_timeout_source)
+        return;
+
+    /* (Re)start from the minimum interval */
+    if (priv->urc_watchdog_source) {
+        g_source_remove (priv->urc_watchdog_source);
+        priv->urc_watchdog_source = 0;
+    } else if (!priv->urc_watchdog_timeout)
+        mm_obj_dbg (self, "3GPP unsolicited registration events watchdog enabled");
+
+    priv->urc_watchdog_timeout = REGISTRATION_URC_WATCHDOG_MIN_TIMEOUT_SEC;
+    registration_urc_watchdog_schedule (self);
+}
+
 /*****************************************************************************/
 
 void
@@ -2636,6 +2820,7 @@ interface_disabling_step (GTask *task)
     case DISABLING_STEP_PERIODIC_REGISTRATION_CHECKS:
         /* Disable periodic registration checks, if they were set */
         periodic_registration_check_disable (self);
+        registration_urc_watchdog_disable (self);
         ctx->step++;
         /* fall through */
 
@@ -2861,7 +3046,9 @@ enable_unsolicited_registration_events_ready (MMIfaceModem3gpp *self,
         mm_obj_dbg (self, "enabling unsolicited registration events failed: %s", error->message);
         /* If error, setup periodic registration checks */
         periodic_registration_check_enable (self);
-    }
+    } else
+        /* Otherwise, just verify every now and then that they're reported */
+        registration_urc_watchdog_enable (self);
 
     /* Go on to next step */
     ctx = g_task_get_task_data (task);
@@ -3107,6 +3294,11 @@ sync_registration_ready (MMIfaceModem3gpp *self,
     if (!mm_iface_modem_3gpp_run_registration_checks_finish (self, res, &error))
         mm_obj_dbg (self, "couldn't synchronize 3GPP registration: %s", error->message);
 
+    /* Unsolicited events may have been lost while suspended, so verify them
+     * sooner */
+    if (get_private (self)->urc_watchdog_timeout)
+        registration_urc_watchdog_enable (self);
+
     /* Go on to next step */
     ctx->step++;
     interface_syncing_step(task);
@@ -352,6 +352,11 @@ void mm_iface_modem_3gpp_update_5gs_registration_state     (MMIfaceModem3gpp
                                                             gboolean                      deferred);
 void mm_iface_modem_3gpp_apply_deferred_registration_state (MMIfaceModem3gpp             *self);
 
+/* Notify that the registration state updates given by an unsolicited event
+ * have been processed, so that they're not taken as unreported changes by
+ * the watchdog of unsolicited registration events. */
+void mm_iface_modem_3gpp_unsolicited_registration_processed (MMIfaceModem3gpp *self);
+
 void mm_iface_modem_3gpp_update_packet_service_state (MMIfaceModem3gpp              *self,
                                                       MMModem3gppPacketServiceState  state);
 
@@ -227,6 +227,36 @@ build_location_dictionary (GVariant *previous,
     return g_variant_builder_end (&builder);
 }
 
+/* Location updates may be very frequent (e.g. one NMEA trace per second), so
+ * they are batched; the pending value is the one to update */
+static void
+update_location_property (MMIfaceModemLocation *self,
+                          MmGdbusModemLocation *skeleton,
+                          MMLocation3gpp       *location_3gpp,
+                          MMLocationGpsNmea    *location_gps_nmea,
+                          MMLocationGpsRaw     *location_gps_raw,
+                          MMLocationCdmaBs     *location_cdma_bs)
+{
+    MMPropertyBatch *batch;
+    g_auto(GValue)   pending = G_VALUE_INIT;
+    GVariant        *previous;
+
+    batch = mm_base_modem_peek_property_batch (MM_BASE_MODEM (self));
+    if (mm_property_batch_peek (batch, skeleton, "location", &pending))
+        previous = g_value_get_variant (&pending);
+    else
+        previous = mm_gdbus_modem_location_get_location (skeleton);
+
+    mm_property_batch_set_variant (batch,
+                                   skeleton,
+                                   "location",
+                                   build_location_dictionary (previous,
+                                                              location_3gpp,
+                                                              location_gps_nmea,
+                                                              location_gps_raw,
+                                                              location_cdma_bs));
+}
+
 /*****************************************************************************/
 
 static void
@@ -240,13 +270,7 @@ notify_gps_location_update (MMIfaceModemLocation *self,
     /* We only update the property if we are supposed to signal
      * location */
     if (mm_gdbus_modem_location_get_signals_location (skeleton))
-        mm_gdbus_modem_location_set_location (
-            skeleton,
-            build_location_dictionary (mm_gdbus_modem_location_get_location (skeleton),
-                                       NULL,
-                                       location_gps_nmea,
-                                       location_gps_raw,
-                                       NULL));
+        update_location_property (self, skeleton, NULL, location_gps_nmea, location_gps_raw, NULL);
 }
 
 static void
@@ -358,12 +382,7 @@ notify_3gpp_location_update (MMIfaceModemLocation *self,
     /* We only update the property if we are supposed to signal
      * location */
     if (mm_gdbus_modem_location_get_signals_location (skeleton))
-        mm_gdbus_modem_location_set_location (
-            skeleton,
-            build_location_dictionary (mm_gdbus_modem_location_get_location (skeleton),
-                                       location_3gpp,
-                                       NULL, NULL,
-                                       NULL));
+        update_location_property (self, skeleton, location_3gpp, NULL, NULL, NULL);
 }
 
 void
@@ -497,12 +516,7 @@ notify_cdma_bs_location_update (MMIfaceModemLocation *self,
     /* We only update the property if we are supposed to signal
      * location */
     if (mm_gdbus_modem_location_get_signals_location (skeleton))
-        mm_gdbus_modem_location_set_location (
-            skeleton,
-            build_location_dictionary (mm_gdbus_modem_location_get_location (skeleton),
-                                       NULL,
-                                       NULL, NULL,
-                                       location_cdma_bs));
+        update_location_property (self, skeleton, NULL, NULL, NULL, location_cdma_bs);
 }
 
 void
@@ -970,6 +984,8 @@ handle_setup_auth_ready (MMBaseModem *self,
     if (mm_gdbus_modem_location_get_signals_location (ctx->skeleton) != ctx->signal_location) {
         mm_obj_dbg (self, "%s location signaling",
                     ctx->signal_location ? "enabling" : "disabling");
+        /* Pending location updates must not override these ones */
+        mm_property_batch_flush (mm_base_modem_peek_property_batch (MM_BASE_MODEM (self)));
         mm_gdbus_modem_location_set_signals_location (ctx->skeleton,
                                                       ctx->signal_location);
         if (ctx->signal_location)
@@ -482,6 +482,22 @@ sms_added (MMSmsList             *list,
     mm_gdbus_modem_messaging_emit_added (skeleton, sms_path, received);
 }
 
+static void
+sms_added_batch (MMSmsList             *list,
+                 GVariant              *added,
+                 MmGdbusModemMessaging *skeleton)
+{
+    GVariantIter  iter;
+    const gchar  *sms_path;
+    gboolean      received;
+
+    /* Update the list of messages only once for the whole batch */
+    update_message_list (skeleton, list);
+    g_variant_iter_init (&iter, added);
+    while (g_variant_iter_next (&iter, "(&sb)", &sms_path, &received))
+        mm_gdbus_modem_messaging_emit_added (skeleton, sms_path, received);
+}
+
 static void
 sms_deleted (MMSmsList             *list,
              const gchar           *sms_path,
@@ -720,9 +736,17 @@ load_initial_sms_parts_ready (MMIfaceModemMessaging *self,
 {
     EnablingContext *ctx;
     GError *error = NULL;
+    g_autoptr(MMSmsList) list = NULL;
 
     ctx = g_task_get_task_data (task);
 
+    /* Report all the SMS objects created from this storage at once */
+    g_object_get (self,
+                  MM_IFACE_MODEM_MESSAGING_SMS_LIST, &list,
+                  NULL);
+    if (list)
+        mm_sms_list_batch_end (list);
+
     MM_IFACE_MODEM_MESSAGING_GET_INTERFACE (self)->load_initial_sms_parts_finish (self, res, &error);
     if (error) {
         StorageContext *storage_ctx;
@@ -767,6 +791,7 @@ load_initial_sms_parts_from_storages (GTask *task)
     EnablingContext *ctx;
     gboolean all_loaded = FALSE;
     StorageContext *storage_ctx;
+    g_autoptr(MMSmsList) list = NULL;
 
     self = g_task_get_source_object (task);
     ctx = g_task_get_task_data (task);
@@ -792,6 +817,13 @@ load_initial_sms_parts_from_storages (GTask *task)
         return;
     }
 
+    /* Full storages may have lots of parts, so batch the additions */
+    g_object_get (self,
+                  MM_IFACE_MODEM_MESSAGING_SMS_LIST, &list,
+                  NULL);
+    if (list)
+        mm_sms_list_batch_begin (list);
+
     MM_IFACE_MODEM_MESSAGING_GET_INTERFACE (self)->load_initial_sms_parts (
         self,
         g_array_index (storage_ctx->supported_mem1,
@@ -917,6 +949,10 @@ interface_enabling_step (GTask *task)
                           MM_SMS_ADDED,
                           G_CALLBACK (sms_added),
                           ctx->skeleton);
+        g_signal_connect (list,
+                          MM_SMS_ADDED_BATCH,
+                          G_CALLBACK (sms_added_batch),
+                          ctx->skeleton);
         g_signal_connect (list,
                           MM_SMS_DELETED,
                           G_CALLBACK (sms_deleted),
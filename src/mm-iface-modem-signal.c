@@ -14,6 +14,8 @@
  * Copyright (C) 2021 Intel Corporation
  */
 
+#include <math.h>
+
 #include <ModemManager.h>
 #define _LIBMM_INSIDE_MM
 #include <libmm-glib.h>
@@ -21,6 +23,7 @@
 #include "mm-iface-modem.h"
 #include "mm-iface-modem-signal.h"
 #include "mm-log-object.h"
+#include "mm-poll-scheduler.h"
 
 #define SUPPORT_CHECKED_TAG "signal-support-checked-tag"
 #define SUPPORTED_TAG       "signal-supported-tag"
@@ -37,9 +40,12 @@ static GQuark private_quark;
 typedef struct {
     /* interface enabled */
     gboolean enabled;
-    /* polling-based reporting  */
-    guint    rate;
-    guint    timeout_source;
+    /* polling-based reporting, with the rate requested by the user being
+     * the minimum one */
+    guint            rate;
+    guint            timeout_source;
+    MMPollScheduler *scheduler;
+    guint            effective_rate;
     /* threshold-based reporting */
     guint    rssi_threshold;
     gboolean error_rate_threshold;
@@ -54,6 +60,7 @@ private_free (Private *priv)
         g_timer_destroy (priv->info_log_timer);
     if (priv->timeout_source)
         g_source_remove (priv->timeout_source);
+    mm_poll_scheduler_free (priv->scheduler);
     g_slice_free (Private, priv);
 }
 
@@ -112,7 +119,72 @@ info_log_signal_quality (MMIfaceModemSignal *self,
 
 /*****************************************************************************/
 
-static void
+/* Differences below these are not considered a change when choosing the
+ * polling interval, as the readings fluctuate on almost every poll */
+static const struct {
+    const gchar *key;
+    gdouble      tolerance;
+} signal_tolerances[] = {
+    { "rssi",       1.0 }, /* dBm */
+    { "rscp",       1.0 }, /* dBm */
+    { "io",         1.0 }, /* dBm */
+    { "rsrp",       1.0 }, /* dBm */
+    { "ecio",       0.5 }, /* dB */
+    { "rsrq",       0.5 }, /* dB */
+    { "sinr",       1.0 }, /* dB */
+    { "snr",        1.0 }, /* dB */
+    { "error-rate", 1.0 }, /* % */
+};
+
+static gboolean
+signal_value_equal (const gchar *key,
+                    GVariant    *a,
+                    GVariant    *b)
+{
+    guint i;
+
+    if (!g_variant_is_of_type (a, G_VARIANT_TYPE_DOUBLE) ||
+        !g_variant_is_of_type (b, G_VARIANT_TYPE_DOUBLE))
+        return g_variant_equal (a, b);
+
+    for (i = 0; i < G_N_ELEMENTS (signal_tolerances); i++) {
+        if (g_str_equal (key, signal_tolerances[i].key))
+            return (fabs (g_variant_get_double (a) - g_variant_get_double (b)) < signal_tolerances[i].tolerance);
+    }
+    return (g_variant_get_double (a) == g_variant_get_double (b));
+}
+
+static gboolean
+signal_dictionary_equal (GVariant *a,
+                         GVariant *b)
+{
+    GVariantIter  iter;
+    const gchar  *key;
+    GVariant     *value;
+
+    if (!a || !b)
+        return (a == b);
+    if (g_variant_n_children (a) != g_variant_n_children (b))
+        return FALSE;
+
+    g_variant_iter_init (&iter, a);
+    while (g_variant_iter_next (&iter, "{&sv}", &key, &value)) {
+        GVariant *other;
+        gboolean  equal;
+
+        other = g_variant_lookup_value (b, key, NULL);
+        equal = (other && signal_value_equal (key, value, other));
+        if (other)
+            g_variant_unref (other);
+        g_variant_unref (value);
+        if (!equal)
+            return FALSE;
+    }
+    return TRUE;
+}
+
+/* Returns TRUE if any value changed */
+static gboolean
 internal_signal_update (MMIfaceModemSignal *self,
                         MMSignal           *cdma,
                         MMSignal           *evdo,
@@ -128,25 +200,28 @@ internal_signal_update (MMIfaceModemSignal *self,
     g_autoptr(GVariant)                   dict_lte = NULL;
     g_autoptr(GVariant)                   dict_nr5g = NULL;
     g_autoptr(MmGdbusModemSignalSkeleton) skeleton = NULL;
+    gboolean                              changed = FALSE;
 
     g_object_get (self,
                   MM_IFACE_MODEM_SIGNAL_DBUS_SKELETON, &skeleton,
                   NULL);
     if (!skeleton) {
         mm_obj_warn (self, "cannot update extended signal information: couldn't get interface skeleton");
-        return;
+        return FALSE;
     }
 
     if (cdma) {
         mm_obj_dbg (self, "cdma extended signal information updated");
         dict_cdma = mm_signal_get_dictionary (cdma);
     }
+    changed |= !signal_dictionary_equal (dict_cdma, mm_gdbus_modem_signal_get_cdma (MM_GDBUS_MODEM_SIGNAL (skeleton)));
     mm_gdbus_modem_signal_set_cdma (MM_GDBUS_MODEM_SIGNAL (skeleton), dict_cdma);
 
     if (evdo) {
         mm_obj_dbg (self, "evdo extended signal information updated");
         dict_evdo = mm_signal_get_dictionary (evdo);
     }
+    changed |= !signal_dictionary_equal (dict_evdo, mm_gdbus_modem_signal_get_evdo (MM_GDBUS_MODEM_SIGNAL (skeleton)));
     mm_gdbus_modem_signal_set_evdo (MM_GDBUS_MODEM_SIGNAL (skeleton), dict_evdo);
 
     if (gsm) {
@@ -154,6 +229,7 @@ internal_signal_update (MMIfaceModemSignal *self,
         info_log_signal_quality (self, gsm, "gsm");
         dict_gsm = mm_signal_get_dictionary (gsm);
     }
+    changed |= !signal_dictionary_equal (dict_gsm, mm_gdbus_modem_signal_get_gsm (MM_GDBUS_MODEM_SIGNAL (skeleton)));
     mm_gdbus_modem_signal_set_gsm (MM_GDBUS_MODEM_SIGNAL (skeleton), dict_gsm);
 
     if (umts) {
@@ -161,6 +237,7 @@ internal_signal_update (MMIfaceModemSignal *self,
         info_log_signal_quality (self, umts, "umts");
         dict_umts = mm_signal_get_dictionary (umts);
     }
+    changed |= !signal_dictionary_equal (dict_umts, mm_gdbus_modem_signal_get_umts (MM_GDBUS_MODEM_SIGNAL (skeleton)));
     mm_gdbus_modem_signal_set_umts (MM_GDBUS_MODEM_SIGNAL (skeleton), dict_umts);
 
     if (lte) {
@@ -168,6 +245,7 @@ internal_signal_update (MMIfaceModemSignal *self,
         info_log_signal_quality (self, lte, "lte");
         dict_lte = mm_signal_get_dictionary (lte);
     }
+    changed |= !signal_dictionary_equal (dict_lte, mm_gdbus_modem_signal_get_lte (MM_GDBUS_MODEM_SIGNAL (skeleton)));
     mm_gdbus_modem_signal_set_lte (MM_GDBUS_MODEM_SIGNAL (skeleton), dict_lte);
 
     if (nr5g) {
@@ -175,10 +253,42 @@ internal_signal_update (MMIfaceModemSignal *self,
         info_log_signal_quality (self, nr5g, "5gnr");
         dict_nr5g = mm_signal_get_dictionary (nr5g);
     }
+    changed |= !signal_dictionary_equal (dict_nr5g, mm_gdbus_modem_signal_get_nr5g (MM_GDBUS_MODEM_SIGNAL (skeleton)));
     mm_gdbus_modem_signal_set_nr5g (MM_GDBUS_MODEM_SIGNAL (skeleton), dict_nr5g);
 
     /* Flush right away */
     g_dbus_interface_skeleton_flush (G_DBUS_INTERFACE_SKELETON (skeleton));
+
+    return changed;
+}
+
+static void
+signal_update (MMIfaceModemSignal *self,
+               MMSignal           *cdma,
+               MMSignal           *evdo,
+               MMSignal           *gsm,
+               MMSignal           *umts,
+               MMSignal           *lte,
+               MMSignal           *nr5g,
+               gboolean            polled)
+{
+    Private  *priv;
+    gboolean  changed;
+
+    priv = get_private (self);
+    if (!priv->enabled || (!priv->rate && !priv->rssi_threshold && !priv->error_rate_threshold)) {
+        mm_obj_dbg (self, "skipping extended signal information update...");
+        return;
+    }
+
+    changed = internal_signal_update (self, cdma, evdo, gsm, umts, lte, nr5g);
+
+    if (!priv->scheduler)
+        return;
+    if (polled)
+        mm_poll_scheduler_report_polled (priv->scheduler, changed);
+    else
+        mm_poll_scheduler_report_indication (priv->scheduler, changed);
 }
 
 void
@@ -190,15 +300,9 @@ mm_iface_modem_signal_update (MMIfaceModemSignal *self,
                               MMSignal           *lte,
                               MMSignal           *nr5g)
 {
-    Private *priv;
-
-    priv = get_private (self);
-    if (!priv->enabled || (!priv->rate && !priv->rssi_threshold && !priv->error_rate_threshold)) {
-        mm_obj_dbg (self, "skipping extended signal information update...");
-        return;
-    }
-
-    internal_signal_update (self, cdma, evdo, gsm, umts, lte, nr5g);
+    /* Updates not coming from the polling are indications reported by the
+     * modem itself (e.g. threshold-based reporting) */
+    signal_update (self, cdma, evdo, gsm, umts, lte, nr5g, FALSE);
 }
 
 /*****************************************************************************/
@@ -217,7 +321,38 @@ check_interface_reset (MMIfaceModemSignal *self)
 }
 
 /*****************************************************************************/
-/* Polling setup management */
+/* Polling setup management
+ *
+ * The rate requested by the user is the minimum one; while the values don't
+ * change the rate is reduced, and if the modem reports the values on its own
+ * the polling is stopped altogether.
+ */
+
+#define SIGNAL_POLLING_MAX_BACKOFF_FACTOR 8
+
+static gboolean query_signal_values (MMIfaceModemSignal *self);
+
+static void
+polling_schedule (MMIfaceModemSignal *self)
+{
+    Private *priv;
+    guint    rate;
+
+    priv = get_private (self);
+
+    /* Polling may have been stopped or restarted while loading values */
+    if (!priv->enabled || !priv->rate || !priv->scheduler || priv->timeout_source)
+        return;
+
+    rate = mm_poll_scheduler_get_interval (priv->scheduler);
+    if (rate != priv->effective_rate) {
+        mm_obj_dbg (self, "extended signal information effective polling rate: %u seconds%s", rate,
+                    mm_poll_scheduler_get_indications_proven (priv->scheduler) ?
+                    " (values reported via indications)" : "");
+        priv->effective_rate = rate;
+    }
+    priv->timeout_source = g_timeout_add_seconds (rate, (GSourceFunc) query_signal_values, self);
+}
 
 static void
 load_values_ready (MMIfaceModemSignal *self,
@@ -242,21 +377,32 @@ load_values_ready (MMIfaceModemSignal *self,
             &nr5g,
             &error)) {
         mm_obj_warn (self, "couldn't reload extended signal information: %s", error->message);
-        return;
-    }
+    } else
+        signal_update (self, cdma, evdo, gsm, umts, lte, nr5g, TRUE);
 
-    mm_iface_modem_signal_update (self, cdma, evdo, gsm, umts, lte, nr5g);
+    polling_schedule (self);
 }
 
 static gboolean
 query_signal_values (MMIfaceModemSignal *self)
 {
+    Private *priv;
+
+    priv = get_private (self);
+    priv->timeout_source = 0;
+
+    /* No need to poll if the values are being reported anyway */
+    if (priv->scheduler && !mm_poll_scheduler_tick (priv->scheduler)) {
+        polling_schedule (self);
+        return G_SOURCE_REMOVE;
+    }
+
     MM_IFACE_MODEM_SIGNAL_GET_INTERFACE (self)->load_values (
         self,
         NULL,
         (GAsyncReadyCallback)load_values_ready,
         NULL);
-    return G_SOURCE_CONTINUE;
+    return G_SOURCE_REMOVE;
 }
 
 static void
@@ -274,20 +420,17 @@ polling_restart (MMIfaceModemSignal *self)
         mm_obj_dbg (self, "cleaning up extended signal information polling");
 
     /* Stop polling */
-    if (!polling_setup) {
-        if (priv->timeout_source) {
-            g_source_remove (priv->timeout_source);
-            priv->timeout_source = 0;
-        }
-        return;
-    }
-
-    /* Start/restart polling */
-    if (priv->timeout_source)
+    if (priv->timeout_source) {
         g_source_remove (priv->timeout_source);
-    priv->timeout_source = g_timeout_add_seconds (priv->rate, (GSourceFunc) query_signal_values, self);
+        priv->timeout_source = 0;
+    }
+    g_clear_pointer (&priv->scheduler, mm_poll_scheduler_free);
+    priv->effective_rate = 0;
+    if (!polling_setup)
+        return;
 
-    /* Also launch right away */
+    /* Start/restart polling, launching right away */
+    priv->scheduler = mm_poll_scheduler_new (priv->rate, priv->rate * SIGNAL_POLLING_MAX_BACKOFF_FACTOR);
     query_signal_values (self);
 }
 
@@ -289,6 +289,7 @@ match_single_call_info (MMIfaceModemVoice *self,
 typedef struct {
     MMIfaceModemVoice *self;
     const MMCallInfo  *call_info;
+    MMCallState        matched_state;
 } ReportCallForeachContext;
 
 static void
@@ -304,10 +305,15 @@ report_call_foreach (MMBaseCall               *call,
         return;
 
     /* Reset call info in context if the call info matches an existing call */
+    ctx->matched_state = mm_base_call_get_state (call);
     if (match_single_call_info (ctx->self, ctx->call_info, call))
         ctx->call_info = NULL;
 }
 
+static void call_list_polling_report_event (MMIfaceModemVoice *self,
+                                            MMCallState        previous_state,
+                                            MMCallState        state);
+
 void
 mm_iface_modem_voice_report_call (MMIfaceModemVoice *self,
                                   const MMCallInfo  *call_info)
@@ -345,8 +351,10 @@ mm_iface_modem_voice_report_call (MMIfaceModemVoice *self,
     mm_call_list_foreach (list, (MMCallListForeachFunc)report_call_foreach, &ctx);
 
     /* If call info matched with an existing one, the context call info would have been reseted */
-    if (!ctx.call_info)
+    if (!ctx.call_info) {
+        call_list_polling_report_event (self, ctx.matched_state, call_info->state);
         goto out;
+    }
 
     /* If call info didn't match with any known call, it may be because we're being
      * reported a NEW incoming call. If that's not the case, we'll ignore the report. */
@@ -2352,16 +2360,36 @@ setup_in_call_event_handling (MMCallList        *call_list,
  * being established (i.e. all terminated, unknown or active), then there is
  * no polling to do.
  *
- * Any time we add a new call to the list, we'll setup polling if it's not
- * already running, and the polling logic itself will decide when the polling
- * should stop.
+ * Any time we add a new call to the list or a call changes state, we'll setup
+ * polling if it's not already running, and the polling logic itself will
+ * decide when the polling should stop.
+ *
+ * The polling is only a fallback for the call state updates not reported
+ * by the modem itself (e.g. vendor specific call state URCs):
+ *  - The polling interval depends on the phase of the calls being
+ *    established, e.g. a call being dialed changes state sooner than a
+ *    call on hold.
+ *  - Once the modem has reported call state transitions on its own while
+ *    calls are being established, the polling interval is extended, as it
+ *    only needs to catch missed updates. Generic URCs like RING, +CLIP or
+ *    NO CARRIER don't prove such support, and the extended interval only
+ *    lasts until there are no more calls being established.
+ *  - The call list isn't loaded if the modem reported call state updates
+ *    since the last poll was scheduled.
  */
 
-#define CALL_LIST_POLLING_TIMEOUT_SECS 2
+#define CALL_LIST_POLLING_TIMEOUT_DIALING_SECS  1
+#define CALL_LIST_POLLING_TIMEOUT_RINGING_SECS  2
+#define CALL_LIST_POLLING_TIMEOUT_HELD_SECS     5
+#define CALL_LIST_POLLING_EVENTS_FACTOR         5
 
 typedef struct {
     guint    polling_id;
     gboolean polling_ongoing;
+    /* Call state updates reported by the modem */
+    gboolean events_supported;
+    guint    n_events;
+    guint    n_events_polled;
 } CallListPollingContext;
 
 static void
@@ -2396,8 +2424,119 @@ get_call_list_polling_context (MMIfaceModemVoice *self)
     return ctx;
 }
 
+static void
+call_list_polling_report_event (MMIfaceModemVoice *self,
+                                MMCallState        previous_state,
+                                MMCallState        state)
+{
+    CallListPollingContext *ctx;
+
+    /* Only real progress of a call being established counts */
+    if (state == previous_state)
+        return;
+    if (state != MM_CALL_STATE_DIALING &&
+        state != MM_CALL_STATE_RINGING_OUT &&
+        state != MM_CALL_STATE_ACTIVE &&
+        state != MM_CALL_STATE_HELD)
+        return;
+
+    ctx = get_call_list_polling_context (self);
+    if (!ctx->events_supported) {
+        mm_obj_dbg (self, "call state updates reported by the modem: call list polling relaxed");
+        ctx->events_supported = TRUE;
+    }
+    ctx->n_events++;
+}
+
+static void
+call_list_foreach_get_polling_timeout (MMBaseCall *call,
+                                       gpointer    user_data)
+{
+    guint *timeout = (guint *)user_data;
+    guint  call_timeout;
+
+    switch (mm_base_call_get_state (call)) {
+    case MM_CALL_STATE_DIALING:
+    case MM_CALL_STATE_RINGING_OUT:
+        call_timeout = CALL_LIST_POLLING_TIMEOUT_DIALING_SECS;
+        break;
+    case MM_CALL_STATE_RINGING_IN:
+    case MM_CALL_STATE_WAITING:
+        call_timeout = CALL_LIST_POLLING_TIMEOUT_RINGING_SECS;
+        break;
+    case MM_CALL_STATE_HELD:
+        call_timeout = CALL_LIST_POLLING_TIMEOUT_HELD_SECS;
+        break;
+    case MM_CALL_STATE_ACTIVE:
+    case MM_CALL_STATE_TERMINATED:
+    case MM_CALL_STATE_UNKNOWN:
+    default:
+        return;
+    }
+
+    if (!*timeout || call_timeout < *timeout)
+        *timeout = call_timeout;
+}
+
+/* Returns 0 if there are no calls being established */
+static guint
+call_list_get_polling_timeout (MMIfaceModemVoice *self)
+{
+    CallListPollingContext *ctx;
+    MMCallList             *list = NULL;
+    guint                   timeout = 0;
+
+    g_object_get (MM_BASE_MODEM (self),
+                  MM_IFACE_MODEM_VOICE_CALL_LIST, &list,
+                  NULL);
+    if (!list) {
+        mm_obj_warn (self, "Cannot poll call list: missing internal call list");
+        return 0;
+    }
+
+    mm_call_list_foreach (list, (MMCallListForeachFunc) call_list_foreach_get_polling_timeout, &timeout);
+    g_object_unref (list);
+
+    ctx = get_call_list_polling_context (self);
+    if (ctx->events_supported)
+        timeout *= CALL_LIST_POLLING_EVENTS_FACTOR;
+    return timeout;
+}
+
 static gboolean call_list_poll (MMIfaceModemVoice *self);
 
+static void
+call_list_polling_stop (MMIfaceModemVoice      *self,
+                        CallListPollingContext *ctx)
+{
+    mm_obj_dbg (self, "no calls being established: call list polling stopped");
+
+    /* Call state updates must be proven again for the next calls */
+    ctx->events_supported = FALSE;
+}
+
+static void
+call_list_polling_schedule (MMIfaceModemVoice *self)
+{
+    CallListPollingContext *ctx;
+    guint                   timeout;
+
+    ctx = get_call_list_polling_context (self);
+    if (ctx->polling_id || ctx->polling_ongoing)
+        return;
+
+    timeout = call_list_get_polling_timeout (self);
+    if (!timeout) {
+        call_list_polling_stop (self, ctx);
+        return;
+    }
+
+    ctx->n_events_polled = ctx->n_events;
+    ctx->polling_id = g_timeout_add_seconds (timeout,
+                                             (GSourceFunc) call_list_poll,
+                                             self);
+}
+
 static void
 load_call_list_ready (MMIfaceModemVoice *self,
                       GAsyncResult      *res)
@@ -2419,71 +2558,39 @@ load_call_list_ready (MMIfaceModemVoice *self,
         mm_3gpp_call_info_list_free (call_info_list);
     }
 
-    /* setup the polling again, but only if it hasn't been done already while
+    /* setup the polling again, unless it has been done already while
      * we reported calls (e.g. a new incoming call may have been detected that
      * also triggers the poll setup) */
-    if (!ctx->polling_id)
-        ctx->polling_id = g_timeout_add_seconds (CALL_LIST_POLLING_TIMEOUT_SECS,
-                                                 (GSourceFunc) call_list_poll,
-                                                 self);
-}
-
-static void
-call_list_foreach_count_establishing (MMBaseCall *call,
-                                      gpointer    user_data)
-{
-    guint *n_calls_establishing = (guint *)user_data;
-
-    switch (mm_base_call_get_state (call)) {
-    case MM_CALL_STATE_DIALING:
-    case MM_CALL_STATE_RINGING_OUT:
-    case MM_CALL_STATE_RINGING_IN:
-    case MM_CALL_STATE_HELD:
-    case MM_CALL_STATE_WAITING:
-        *n_calls_establishing = *n_calls_establishing + 1;
-        break;
-    case MM_CALL_STATE_ACTIVE:
-    case MM_CALL_STATE_TERMINATED:
-    case MM_CALL_STATE_UNKNOWN:
-    default:
-        break;
-    }
+    call_list_polling_schedule (self);
 }
 
 static gboolean
 call_list_poll (MMIfaceModemVoice *self)
 {
     CallListPollingContext *ctx;
-    MMCallList             *list = NULL;
-    guint                   n_calls_establishing = 0;
 
     ctx = get_call_list_polling_context (self);
     ctx->polling_id = 0;
 
-    g_object_get (MM_BASE_MODEM (self),
-                  MM_IFACE_MODEM_VOICE_CALL_LIST, &list,
-                  NULL);
-
-    if (!list) {
-        mm_obj_warn (self, "Cannot poll call list: missing internal call list");
-        goto out;
+    /* If the modem reported call state updates since the poll was scheduled,
+     * there's no need to load the call list yet */
+    if (ctx->n_events != ctx->n_events_polled) {
+        mm_obj_dbg (self, "call state updates reported: call list polling skipped");
+        call_list_polling_schedule (self);
+        return G_SOURCE_REMOVE;
     }
 
-    mm_call_list_foreach (list, (MMCallListForeachFunc) call_list_foreach_count_establishing, &n_calls_establishing);
-
     /* If there is at least ONE call being established, we need the call list */
-    if (n_calls_establishing > 0) {
-        mm_obj_dbg (self, "%u calls being established: call list polling required", n_calls_establishing);
+    if (call_list_get_polling_timeout (self) > 0) {
+        mm_obj_dbg (self, "calls being established: call list polling required");
         ctx->polling_ongoing = TRUE;
         g_assert (MM_IFACE_MODEM_VOICE_GET_INTERFACE (self)->load_call_list);
         MM_IFACE_MODEM_VOICE_GET_INTERFACE (self)->load_call_list (self,
                                                                    (GAsyncReadyCallback)load_call_list_ready,
                                                                    NULL);
     } else
-        mm_obj_dbg (self, "no calls being established: call list polling stopped");
+        call_list_polling_stop (self, ctx);
 
-out:
-    g_clear_object (&list);
     return G_SOURCE_REMOVE;
 }
 
@@ -2492,14 +2599,35 @@ setup_call_list_polling (MMCallList        *call_list,
                          const gchar       *call_path_added,
                          MMIfaceModemVoice *self)
 {
-    CallListPollingContext *ctx;
+    MMBaseCall *call;
 
-    ctx = get_call_list_polling_context (self);
+    call = mm_call_list_get_call (call_list, call_path_added);
+    g_assert (call);
+
+    /* New calls may not be established yet (e.g. outgoing calls not started),
+     * so also setup polling once they are */
+    g_signal_connect_object (call,
+                             "state-changed",
+                             G_CALLBACK (call_list_polling_schedule),
+                             self,
+                             G_CONNECT_SWAPPED);
+
+    call_list_polling_schedule (self);
+}
 
-    if (!ctx->polling_id && !ctx->polling_ongoing)
-        ctx->polling_id = g_timeout_add_seconds (CALL_LIST_POLLING_TIMEOUT_SECS,
-                                                 (GSourceFunc) call_list_poll,
-                                                 self);
+static void
+teardown_call_polling (MMBaseCall        *call,
+                       MMIfaceModemVoice *self)
+{
+    g_signal_handlers_disconnect_by_func (call, G_CALLBACK (call_list_polling_schedule), self);
+}
+
+static void
+teardown_call_list_polling (MMCallList        *call_list,
+                            MMIfaceModemVoice *self)
+{
+    g_signal_handlers_disconnect_by_func (call_list, G_CALLBACK (setup_call_list_polling), self);
+    mm_call_list_foreach (call_list, (MMCallListForeachFunc) teardown_call_polling, self);
 }
 
 /*****************************************************************************/
@@ -3028,7 +3156,7 @@ interface_initialization_step (GTask *task)
             /* Cleanup any previously configured handler, before checking if we need to
              * add a new one, because the PERIODIC_CALL_LIST_CHECK_DISABLED flag may
              * change before and after SIM-PIN unlock */
-            g_signal_handlers_disconnect_by_func (list, G_CALLBACK (setup_call_list_polling), self);
+            teardown_call_list_polling (list, self);
 
             g_object_get (self,
                           MM_IFACE_MODEM_VOICE_PERIODIC_CALL_LIST_CHECK_DISABLED, &periodic_call_list_check_disabled,
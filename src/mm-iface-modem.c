@@ -31,6 +31,8 @@
 #include "mm-log-helpers.h"
 #include "mm-context.h"
 #include "mm-dispatcher-fcc-unlock.h"
+#include "mm-modem-cache.h"
+#include "mm-poll-scheduler.h"
 #if defined WITH_QMI
 # include "mm-broadband-modem-qmi.h"
 #endif
@@ -42,7 +44,12 @@
 
 #define SIGNAL_CHECK_INITIAL_RETRIES      5
 #define SIGNAL_CHECK_INITIAL_TIMEOUT_SEC  3
-#define SIGNAL_CHECK_TIMEOUT_SEC          30
+#define SIGNAL_CHECK_MIN_TIMEOUT_SEC      10
+#define SIGNAL_CHECK_MAX_TIMEOUT_SEC      480
+
+/* Access technologies are polled at a fixed rate, unless proven to be
+ * reported via indications */
+#define ACCESS_TECHNOLOGY_CHECK_TIMEOUT_SEC 30
 
 /*****************************************************************************/
 /* Private data context */
@@ -70,6 +77,13 @@ typedef struct {
     guint    signal_check_initial_retries;
     gboolean signal_check_initial_done;
     gboolean signal_check_running;
+    /* Polling intervals once the initial checks are done, and when each
+     * value is due to be polled next (monotonic time, in seconds) */
+    MMPollScheduler *signal_check_scheduler;
+    MMPollScheduler *access_technology_check_scheduler;
+    gint64           signal_quality_check_due;
+    gint64           access_technology_check_due;
+    guint            signal_check_interval;
 
     /* Initialization restart support */
     guint restart_initialize_idle_id;
@@ -87,6 +101,8 @@ private_free (Private *priv)
         g_source_remove (priv->signal_quality_recent_timeout_source);
     if (priv->signal_check_timeout_source)
         g_source_remove (priv->signal_check_timeout_source);
+    mm_poll_scheduler_free (priv->signal_check_scheduler);
+    mm_poll_scheduler_free (priv->access_technology_check_scheduler);
     if (priv->restart_initialize_idle_id)
         g_source_remove (priv->restart_initialize_idle_id);
     g_slice_free (Private, priv);
@@ -122,6 +138,11 @@ get_private (MMIfaceModem *self)
                       MM_IFACE_MODEM_PERIODIC_ACCESS_TECH_CHECK_DISABLED, &priv->access_technology_polling_disabled,
                       NULL);
 
+        priv->signal_check_scheduler = mm_poll_scheduler_new (SIGNAL_CHECK_MIN_TIMEOUT_SEC,
+                                                              SIGNAL_CHECK_MAX_TIMEOUT_SEC);
+        priv->access_technology_check_scheduler = mm_poll_scheduler_new (ACCESS_TECHNOLOGY_CHECK_TIMEOUT_SEC,
+                                                                         ACCESS_TECHNOLOGY_CHECK_TIMEOUT_SEC);
+
         g_object_set_qdata_full (G_OBJECT (self), private_quark, priv, (GDestroyNotify)private_free);
     }
 
@@ -1436,10 +1457,37 @@ mm_iface_modem_update_own_numbers (MMIfaceModem *self,
 
 /*****************************************************************************/
 
-void
-mm_iface_modem_update_access_technologies (MMIfaceModem *self,
-                                           MMModemAccessTechnology new_access_tech,
-                                           guint32 mask)
+/* Access technologies and signal quality are updated frequently, so the
+ * updates are batched; pending values must be looked up first */
+
+static MMModemAccessTechnology
+peek_access_technologies (MMIfaceModem *self,
+                          MmGdbusModem *skeleton)
+{
+    g_auto(GValue) value = G_VALUE_INIT;
+
+    if (mm_property_batch_peek (mm_base_modem_peek_property_batch (MM_BASE_MODEM (self)),
+                                skeleton, "access-technologies", &value))
+        return (MMModemAccessTechnology) g_value_get_uint (&value);
+    return (MMModemAccessTechnology) mm_gdbus_modem_get_access_technologies (skeleton);
+}
+
+static GVariant *
+dup_signal_quality (MMIfaceModem *self,
+                    MmGdbusModem *skeleton)
+{
+    g_auto(GValue) value = G_VALUE_INIT;
+
+    if (mm_property_batch_peek (mm_base_modem_peek_property_batch (MM_BASE_MODEM (self)),
+                                skeleton, "signal-quality", &value))
+        return g_value_dup_variant (&value);
+    return g_variant_ref (mm_gdbus_modem_get_signal_quality (skeleton));
+}
+
+static gboolean
+update_access_technologies (MMIfaceModem            *self,
+                            MMModemAccessTechnology  new_access_tech,
+                            guint32                  mask)
 {
     MmGdbusModem *skeleton = NULL;
     MMModemAccessTechnology old_access_tech;
@@ -1451,9 +1499,9 @@ mm_iface_modem_update_access_technologies (MMIfaceModem *self,
 
     /* Don't process updates if the interface is shut down */
     if (!skeleton)
-        return;
+        return FALSE;
 
-    old_access_tech = mm_gdbus_modem_get_access_technologies (skeleton);
+    old_access_tech = peek_access_technologies (self, skeleton);
 
     /* Build the new access tech */
     built_access_tech = old_access_tech;
@@ -1464,7 +1512,8 @@ mm_iface_modem_update_access_technologies (MMIfaceModem *self,
         gchar *old_access_tech_string;
         gchar *new_access_tech_string;
 
-        mm_gdbus_modem_set_access_technologies (skeleton, built_access_tech);
+        mm_property_batch_set_uint (mm_base_modem_peek_property_batch (MM_BASE_MODEM (self)),
+                                    skeleton, "access-technologies", built_access_tech);
 
         /* Log */
         old_access_tech_string = mm_modem_access_technology_build_string_from_mask (old_access_tech);
@@ -1477,6 +1526,20 @@ mm_iface_modem_update_access_technologies (MMIfaceModem *self,
     }
 
     g_object_unref (skeleton);
+    return (built_access_tech != old_access_tech);
+}
+
+void
+mm_iface_modem_update_access_technologies (MMIfaceModem            *self,
+                                           MMModemAccessTechnology  new_access_tech,
+                                           guint32                  mask)
+{
+    gboolean changed;
+
+    /* Updates not coming from the periodic checks are reported by the modem
+     * itself, e.g. along with the registration state */
+    changed = update_access_technologies (self, new_access_tech, mask);
+    mm_poll_scheduler_report_indication (get_private (self)->access_technology_check_scheduler, changed);
 }
 
 /*****************************************************************************/
@@ -1504,11 +1567,11 @@ expire_signal_quality (MMIfaceModem *self)
                   NULL);
 
     if (skeleton) {
-        GVariant *old;
-        guint     signal_quality = 0;
-        gboolean  recent = FALSE;
+        g_autoptr(GVariant) old = NULL;
+        guint               signal_quality = 0;
+        gboolean            recent = FALSE;
 
-        old = mm_gdbus_modem_get_signal_quality (MM_GDBUS_MODEM (skeleton));
+        old = dup_signal_quality (self, MM_GDBUS_MODEM (skeleton));
         g_variant_get (old,
                        "(ub)",
                        &signal_quality,
@@ -1518,10 +1581,9 @@ expire_signal_quality (MMIfaceModem *self)
         if (recent) {
             mm_obj_dbg (self, "signal quality value not updated in %us, marking as not being recent",
                         SIGNAL_QUALITY_RECENT_TIMEOUT_SEC);
-            mm_gdbus_modem_set_signal_quality (MM_GDBUS_MODEM (skeleton),
-                                               g_variant_new ("(ub)",
-                                                              signal_quality,
-                                                              FALSE));
+            mm_property_batch_set_variant (mm_base_modem_peek_property_batch (MM_BASE_MODEM (self)),
+                                           skeleton, "signal-quality",
+                                           g_variant_new ("(ub)", signal_quality, FALSE));
         }
     }
 
@@ -1531,12 +1593,15 @@ expire_signal_quality (MMIfaceModem *self)
     return G_SOURCE_REMOVE;
 }
 
-static void
+/* Returns TRUE if the signal quality level changed */
+static gboolean
 update_signal_quality (MMIfaceModem *self,
                        guint         signal_quality,
                        gboolean      expire)
 {
     g_autoptr(MmGdbusModemSkeleton)  skeleton = NULL;
+    g_autoptr(GVariant)              old = NULL;
+    guint                            old_signal_quality = 0;
     Private                         *priv;
 
     g_object_get (self,
@@ -1545,19 +1610,21 @@ update_signal_quality (MMIfaceModem *self,
 
     /* Don't process updates if the interface is shut down */
     if (!skeleton)
-        return;
+        return FALSE;
 
     priv = get_private (self);
 
+    old = dup_signal_quality (self, MM_GDBUS_MODEM (skeleton));
+    g_variant_get (old, "(ub)", &old_signal_quality, NULL);
+
     /* Note: we always set the new value, even if the signal quality level
      * is the same, in order to provide an up to date 'recent' flag.
      * The only exception being if 'expire' is FALSE; in that case we assume
      * the value won't expire and therefore can be considered obsolete
      * already. */
-    mm_gdbus_modem_set_signal_quality (MM_GDBUS_MODEM (skeleton),
-                                       g_variant_new ("(ub)",
-                                                      signal_quality,
-                                                      expire));
+    mm_property_batch_set_variant (mm_base_modem_peek_property_batch (MM_BASE_MODEM (self)),
+                                   skeleton, "signal-quality",
+                                   g_variant_new ("(ub)", signal_quality, expire));
 
     mm_obj_dbg (self, "signal quality updated (%u)", signal_quality);
 
@@ -1573,13 +1640,20 @@ update_signal_quality (MMIfaceModem *self,
                                                           SIGNAL_QUALITY_RECENT_TIMEOUT_SEC,
                                                           (GSourceFunc)expire_signal_quality,
                                                           self));
+
+    return (signal_quality != old_signal_quality);
 }
 
 void
 mm_iface_modem_update_signal_quality (MMIfaceModem *self,
                                       guint         signal_quality)
 {
-    update_signal_quality (self, signal_quality, TRUE);
+    gboolean changed;
+
+    /* Updates not coming from the periodic checks are indications reported
+     * by the modem itself */
+    changed = update_signal_quality (self, signal_quality, TRUE);
+    mm_poll_scheduler_report_indication (get_private (self)->signal_check_scheduler, changed);
 }
 
 /*****************************************************************************/
@@ -1599,11 +1673,18 @@ typedef struct {
     guint                   access_technologies_mask;
     /* Steps triggered when polling active */
     SignalCheckStep running_step;
+    /* Whether each value needs to be polled, or indications are enough */
+    gboolean        signal_quality_polling_needed;
+    gboolean        access_technology_polling_needed;
+    /* Whether signal quality was polled, and whether any value changed */
+    gboolean        polled;
+    gboolean        changed;
 } SignalCheckContext;
 
-static void     periodic_signal_check_disable (MMIfaceModem *self,
-                                               gboolean      clear);
-static gboolean periodic_signal_check_run     (MMIfaceModem *self);
+static void     periodic_signal_check_disable  (MMIfaceModem *self,
+                                                gboolean      clear);
+static gboolean periodic_signal_check_run      (MMIfaceModem *self);
+static void     periodic_signal_check_schedule (MMIfaceModem *self);
 static void     periodic_signal_check_step    (GTask        *task);
 
 static void
@@ -1649,8 +1730,9 @@ load_access_technologies_ready (MMIfaceModem *self,
             mm_obj_dbg (self, "couldn't refresh access technologies: %s", error->message);
     }
     /* We may have been disabled while this command was running. */
-    else if (priv->signal_check_enabled)
-        mm_iface_modem_update_access_technologies (self, ctx->access_technologies, ctx->access_technologies_mask);
+    else if (priv->signal_check_enabled) {
+        ctx->changed |= update_access_technologies (self, ctx->access_technologies, ctx->access_technologies_mask);
+    }
 
     /* Go on */
     ctx->running_step++;
@@ -1681,8 +1763,10 @@ load_signal_quality_ready (MMIfaceModem *self,
             mm_obj_dbg (self, "couldn't refresh signal quality: %s", error->message);
     }
     /* We may have been disabled while this command was running. */
-    else if (priv->signal_check_enabled)
-        update_signal_quality (self, ctx->signal_quality, TRUE);
+    else if (priv->signal_check_enabled) {
+        ctx->polled = TRUE;
+        ctx->changed |= update_signal_quality (self, ctx->signal_quality, TRUE);
+    }
 
     /* Go on */
     ctx->running_step++;
@@ -1707,7 +1791,8 @@ periodic_signal_check_step (GTask *task)
 
     case SIGNAL_CHECK_STEP_SIGNAL_QUALITY:
         if (priv->signal_check_enabled && priv->signal_quality_polling_supported &&
-            (!priv->signal_check_initial_done || !priv->signal_quality_polling_disabled)) {
+            (!priv->signal_check_initial_done ||
+             (!priv->signal_quality_polling_disabled && ctx->signal_quality_polling_needed))) {
             MM_IFACE_MODEM_GET_INTERFACE (self)->load_signal_quality (
                 self, (GAsyncReadyCallback)load_signal_quality_ready, task);
             return;
@@ -1717,7 +1802,8 @@ periodic_signal_check_step (GTask *task)
 
     case SIGNAL_CHECK_STEP_ACCESS_TECHNOLOGIES:
         if (priv->signal_check_enabled && priv->access_technology_polling_supported &&
-            (!priv->signal_check_initial_done || !priv->access_technology_polling_disabled)) {
+            (!priv->signal_check_initial_done ||
+             (!priv->access_technology_polling_disabled && ctx->access_technology_polling_needed))) {
             MM_IFACE_MODEM_GET_INTERFACE (self)->load_access_technologies (
                 self, (GAsyncReadyCallback)load_access_technologies_ready, task);
             return;
@@ -1764,11 +1850,10 @@ periodic_signal_check_step (GTask *task)
             mm_obj_dbg (self, "periodic signal quality and access technology checks not rescheduled: unneeded or unsupported");
             periodic_signal_check_disable (self, FALSE);
         } else {
-            mm_obj_dbg (self, "periodic signal quality and access technology checks scheduled");
-            g_assert (!priv->signal_check_timeout_source);
-            priv->signal_check_timeout_source = g_timeout_add_seconds (priv->signal_check_initial_done ? SIGNAL_CHECK_TIMEOUT_SEC : SIGNAL_CHECK_INITIAL_TIMEOUT_SEC,
-                                                                       (GSourceFunc) periodic_signal_check_run,
-                                                                       self);
+            /* Adapt the interval to how much the values change */
+            if (priv->signal_check_initial_done && ctx->polled)
+                mm_poll_scheduler_report_polled (priv->signal_check_scheduler, ctx->changed);
+            periodic_signal_check_schedule (self);
         }
 
         periodic_signal_check_complete (task);
@@ -1779,14 +1864,66 @@ periodic_signal_check_step (GTask *task)
     }
 }
 
+static gint64
+periodic_signal_check_now (void)
+{
+    return g_get_monotonic_time () / G_USEC_PER_SEC;
+}
+
+static void
+periodic_signal_check_schedule (MMIfaceModem *self)
+{
+    Private *priv;
+    guint    interval;
+
+    priv = get_private (self);
+
+    if (!priv->signal_check_initial_done)
+        interval = SIGNAL_CHECK_INITIAL_TIMEOUT_SEC;
+    else {
+        gint64 now;
+        gint64 next = G_MAXINT64;
+
+        /* Each value has its own interval; wake up for the earliest one */
+        now = periodic_signal_check_now ();
+        if (priv->signal_quality_polling_supported && !priv->signal_quality_polling_disabled) {
+            if (priv->signal_quality_check_due <= now)
+                priv->signal_quality_check_due = now + mm_poll_scheduler_get_interval (priv->signal_check_scheduler);
+            next = MIN (next, priv->signal_quality_check_due);
+        }
+        if (priv->access_technology_polling_supported && !priv->access_technology_polling_disabled) {
+            if (priv->access_technology_check_due <= now)
+                priv->access_technology_check_due = now + mm_poll_scheduler_get_interval (priv->access_technology_check_scheduler);
+            next = MIN (next, priv->access_technology_check_due);
+        }
+        g_assert (next != G_MAXINT64);
+        interval = (guint) MAX (next - now, 1);
+
+        if (interval != priv->signal_check_interval)
+            mm_obj_dbg (self, "periodic signal check interval: %us%s%s", interval,
+                        mm_poll_scheduler_get_indications_proven (priv->signal_check_scheduler) ?
+                        " (signal quality reported via indications)" : "",
+                        mm_poll_scheduler_get_indications_proven (priv->access_technology_check_scheduler) ?
+                        " (access technologies reported via indications)" : "");
+    }
+    priv->signal_check_interval = interval;
+
+    g_assert (!priv->signal_check_timeout_source);
+    priv->signal_check_timeout_source = g_timeout_add_seconds (interval,
+                                                               (GSourceFunc) periodic_signal_check_run,
+                                                               self);
+}
+
 static gboolean
 periodic_signal_check_run (MMIfaceModem *self)
 {
     GTask              *task;
     SignalCheckContext *ctx;
     Private            *priv;
+    gint64              now;
 
     priv = get_private (self);
+    now = periodic_signal_check_now ();
 
     task = g_task_new (self, NULL, NULL, NULL);
 
@@ -1795,6 +1932,11 @@ periodic_signal_check_run (MMIfaceModem *self)
     ctx->signal_quality           = 0;
     ctx->access_technologies      = MM_MODEM_ACCESS_TECHNOLOGY_UNKNOWN;
     ctx->access_technologies_mask = MM_MODEM_ACCESS_TECHNOLOGY_ANY;
+    /* Only the values whose interval expired are polled */
+    if (priv->signal_quality_check_due <= now)
+        ctx->signal_quality_polling_needed = mm_poll_scheduler_tick (priv->signal_check_scheduler);
+    if (priv->access_technology_check_due <= now)
+        ctx->access_technology_polling_needed = mm_poll_scheduler_tick (priv->access_technology_check_scheduler);
     g_task_set_task_data (task, ctx, (GDestroyNotify) g_free);
 
     g_assert (!priv->signal_check_running);
@@ -1840,6 +1982,10 @@ mm_iface_modem_refresh_signal (MMIfaceModem *self)
      * so that we poll at a higher frequency */
     priv->signal_check_initial_retries = SIGNAL_CHECK_INITIAL_RETRIES;
     priv->signal_check_initial_done    = FALSE;
+    mm_poll_scheduler_reset (priv->signal_check_scheduler);
+    mm_poll_scheduler_reset (priv->access_technology_check_scheduler);
+    priv->signal_quality_check_due    = 0;
+    priv->access_technology_check_due = 0;
 
     /* Start sequence */
     periodic_signal_check_run (self);
@@ -1859,9 +2005,9 @@ periodic_signal_check_disable (MMIfaceModem *self,
     /* Clear access technology and signal quality */
     if (clear) {
         update_signal_quality (self, 0, FALSE);
-        mm_iface_modem_update_access_technologies (self,
-                                                   MM_MODEM_ACCESS_TECHNOLOGY_UNKNOWN,
-                                                   MM_MODEM_ACCESS_TECHNOLOGY_ANY);
+        update_access_technologies (self,
+                                    MM_MODEM_ACCESS_TECHNOLOGY_UNKNOWN,
+                                    MM_MODEM_ACCESS_TECHNOLOGY_ANY);
     }
 
     /* Remove scheduled timeout */
@@ -1898,6 +2044,27 @@ periodic_signal_check_enable (MMIfaceModem *self)
     mm_iface_modem_refresh_signal (self);
 }
 
+static void
+periodic_signal_check_set_boost (MMIfaceModem *self,
+                                 gboolean      boost)
+{
+    Private *priv;
+
+    priv = get_private (self);
+    mm_poll_scheduler_set_boost (priv->signal_check_scheduler, boost);
+
+    /* If a longer signal quality check is already scheduled, reschedule it */
+    if (boost &&
+        priv->signal_check_timeout_source &&
+        priv->signal_check_initial_done &&
+        priv->signal_quality_check_due > periodic_signal_check_now () + mm_poll_scheduler_get_interval (priv->signal_check_scheduler)) {
+        g_source_remove (priv->signal_check_timeout_source);
+        priv->signal_check_timeout_source = 0;
+        priv->signal_quality_check_due = 0;
+        periodic_signal_check_schedule (self);
+    }
+}
+
 /*****************************************************************************/
 
 static void
@@ -1954,6 +2121,10 @@ update_state_internal (MMIfaceModem             *self,
                     mm_modem_state_get_string (old_state),
                     mm_modem_state_get_string (new_state));
 
+        /* Apply any pending batched property update, so that clients
+         * don't get them after the state change */
+        mm_property_batch_flush (mm_base_modem_peek_property_batch (MM_BASE_MODEM (self)));
+
         /* The property in the interface is bound to the property
          * in the skeleton, so just updating here is enough */
         g_object_set (self,
@@ -1973,6 +2144,9 @@ update_state_internal (MMIfaceModem             *self,
             mm_gdbus_modem_emit_state_changed (MM_GDBUS_MODEM (skeleton), old_state, new_state, reason);
         }
 
+        /* Check signal more often while connecting */
+        periodic_signal_check_set_boost (self, new_state == MM_MODEM_STATE_CONNECTING);
+
         /* If we go to a registered/connected state (from unregistered), setup
          * signal quality and access technologies periodic retrieval */
         if (new_state >= MM_MODEM_STATE_REGISTERED && old_state < MM_MODEM_STATE_REGISTERED)
@@ -4266,6 +4440,8 @@ mm_iface_modem_disable (MMIfaceModem *self,
      * Set signal quality to 0% and access technologies to unknown since modem is disabled
      */
     if (skeleton) {
+        /* Pending updates must not override these ones */
+        mm_property_batch_flush (mm_base_modem_peek_property_batch (MM_BASE_MODEM (self)));
         mm_gdbus_modem_set_signal_quality (MM_GDBUS_MODEM (skeleton),
                                            g_variant_new ("(ub)", 0, TRUE));
         mm_gdbus_modem_set_access_technologies (MM_GDBUS_MODEM (skeleton),
@@ -4688,6 +4864,7 @@ typedef enum {
     INITIALIZATION_STEP_SUPPORTED_CHARSETS,
     INITIALIZATION_STEP_CHARSET,
     INITIALIZATION_STEP_BEARERS,
+    /* Steps run as a dependency graph, see initialization_graph[] */
     INITIALIZATION_STEP_MANUFACTURER,
     INITIALIZATION_STEP_MODEL,
     INITIALIZATION_STEP_REVISION,
@@ -4695,6 +4872,7 @@ typedef enum {
     INITIALIZATION_STEP_HARDWARE_REVISION,
     INITIALIZATION_STEP_EQUIPMENT_ID,
     INITIALIZATION_STEP_DEVICE_ID,
+    /* Back to sequential steps */
     INITIALIZATION_STEP_SUPPORTED_MODES,
     INITIALIZATION_STEP_SUPPORTED_BANDS,
     INITIALIZATION_STEP_SUPPORTED_IP_FAMILIES,
@@ -4717,8 +4895,19 @@ struct _InitializationContext {
     MMModemCharset supported_charsets;
     const MMModemCharset *current_charset;
     GError *fatal_error;
+    /* Timing */
+    gint64 start_time;
+    gint64 graph_start_time;
+    gint64 step_start_time[INITIALIZATION_STEP_LAST];
+    /* Dependency graph state, as masks of (1 << step) */
+    gboolean graph_concurrent;
+    guint32 graph_running;
+    guint32 graph_done;
 };
 
+static void initialization_graph_node_done (GTask              *task,
+                                            InitializationStep  step);
+
 static void
 initialization_context_free (InitializationContext *ctx)
 {
@@ -4728,7 +4917,7 @@ initialization_context_free (InitializationContext *ctx)
 }
 
 #undef STR_REPLY_READY_FN
-#define STR_REPLY_READY_FN(NAME,DISPLAY)                                \
+#define STR_REPLY_READY_FN(NAME,DISPLAY,STEP)                           \
     static void                                                         \
     load_##NAME##_ready (MMIfaceModem *self,                            \
                          GAsyncResult *res,                             \
@@ -4746,9 +4935,8 @@ initialization_context_free (InitializationContext *ctx)
         if (error)                                                      \
             mm_obj_dbg (self, "couldn't load %s: %s", DISPLAY, error->message); \
                                                                         \
-        /* Go on to next step */                                        \
-        ctx->step++;                                                    \
-        interface_initialization_step (task);                           \
+        /* Let the graph schedule the next steps */                     \
+        initialization_graph_node_done (task, STEP);                    \
     }
 
 #undef UINT_REPLY_READY_FN
@@ -4864,12 +5052,12 @@ load_supported_capabilities_ready (MMIfaceModem *self,
     interface_initialization_step (task);
 }
 
-STR_REPLY_READY_FN (manufacturer, "manufacturer")
-STR_REPLY_READY_FN (model, "model")
-STR_REPLY_READY_FN (revision, "revision")
-STR_REPLY_READY_FN (hardware_revision, "hardware revision")
-STR_REPLY_READY_FN (equipment_identifier, "equipment identifier")
-STR_REPLY_READY_FN (device_identifier, "device identifier")
+STR_REPLY_READY_FN (manufacturer,         "manufacturer",         INITIALIZATION_STEP_MANUFACTURER)
+STR_REPLY_READY_FN (model,                "model",                INITIALIZATION_STEP_MODEL)
+STR_REPLY_READY_FN (revision,             "revision",             INITIALIZATION_STEP_REVISION)
+STR_REPLY_READY_FN (hardware_revision,    "hardware revision",    INITIALIZATION_STEP_HARDWARE_REVISION)
+STR_REPLY_READY_FN (equipment_identifier, "equipment identifier", INITIALIZATION_STEP_EQUIPMENT_ID)
+STR_REPLY_READY_FN (device_identifier,    "device identifier",    INITIALIZATION_STEP_DEVICE_ID)
 
 static void
 load_supported_charsets_ready (MMIfaceModem *self,
@@ -4912,6 +5100,159 @@ setup_charset_ready (MMIfaceModem *self,
     interface_initialization_step (task);
 }
 
+/*****************************************************************************/
+/* Persistent cache of the static properties
+ *
+ * Supported modes, bands and IP families don't change for a given equipment
+ * and firmware revision. When cached, they're exposed right away and loaded
+ * again in the background, updating both the modem and the cache if they
+ * turn out to be different; the background loads may well complete after
+ * the interface is exported. */
+
+#define MODEM_CACHE_SUPPORTED_MODES       "supported-modes"
+#define MODEM_CACHE_SUPPORTED_BANDS       "supported-bands"
+#define MODEM_CACHE_SUPPORTED_IP_FAMILIES "supported-ip-families"
+
+static void
+modem_cache_key_init (MMIfaceModem    *self,
+                      MmGdbusModem    *skeleton,
+                      MMModemCacheKey *key)
+{
+    key->equipment_id = mm_gdbus_modem_get_equipment_identifier (skeleton);
+    key->revision = mm_gdbus_modem_get_revision (skeleton);
+    key->plugin = mm_base_modem_get_plugin (MM_BASE_MODEM (self));
+    key->current_capabilities = mm_gdbus_modem_get_current_capabilities (skeleton);
+}
+
+static GVariant *
+modem_cache_lookup (MMIfaceModem       *self,
+                    MmGdbusModem       *skeleton,
+                    const gchar        *name,
+                    const GVariantType *type)
+{
+    MMModemCacheKey key;
+
+    modem_cache_key_init (self, skeleton, &key);
+    return mm_modem_cache_lookup (self, &key, name, type);
+}
+
+static void
+modem_cache_store (MMIfaceModem *self,
+                   MmGdbusModem *skeleton,
+                   const gchar  *name,
+                   GVariant     *value)
+{
+    MMModemCacheKey key;
+
+    modem_cache_key_init (self, skeleton, &key);
+    mm_modem_cache_store (self, &key, name, value);
+}
+
+/* The cached supported modes and bands can't be used if loading them also
+ * sets up state used right away: in implementations flagged as
+ * supported_modes_bands_stateful, and in the generic CDMA network support
+ * checks done while loading the supported modes. */
+static gboolean
+modem_cache_modes_bands_usable (MMIfaceModem *self,
+                                MmGdbusModem *skeleton)
+{
+    if (MM_IFACE_MODEM_GET_INTERFACE (self)->supported_modes_bands_stateful)
+        return FALSE;
+    return !(mm_gdbus_modem_get_current_capabilities (skeleton) & MM_MODEM_CAPABILITY_CDMA_EVDO);
+}
+
+static void
+revalidate_supported_modes_ready (MMIfaceModem *self,
+                                  GAsyncResult *res,
+                                  GTask        *task)
+{
+    InitializationContext *ctx;
+    g_autoptr(GError)      error = NULL;
+    g_autoptr(GVariant)    modes = NULL;
+    GArray                *modes_array;
+
+    ctx = g_task_get_task_data (task);
+
+    modes_array = MM_IFACE_MODEM_GET_INTERFACE (self)->load_supported_modes_finish (self, res, &error);
+    if (!modes_array) {
+        mm_obj_dbg (self, "couldn't revalidate cached supported modes: %s", error->message);
+        g_object_unref (task);
+        return;
+    }
+
+    modes = g_variant_ref_sink (mm_common_mode_combinations_garray_to_variant (modes_array));
+    g_array_unref (modes_array);
+
+    if (!g_variant_equal (modes, mm_gdbus_modem_get_supported_modes (ctx->skeleton))) {
+        mm_obj_info (self, "cached supported modes were outdated");
+        mm_gdbus_modem_set_supported_modes (ctx->skeleton, modes);
+    }
+    modem_cache_store (self, ctx->skeleton, MODEM_CACHE_SUPPORTED_MODES, modes);
+    g_object_unref (task);
+}
+
+static void
+revalidate_supported_bands_ready (MMIfaceModem *self,
+                                  GAsyncResult *res,
+                                  GTask        *task)
+{
+    InitializationContext *ctx;
+    g_autoptr(GError)      error = NULL;
+    g_autoptr(GVariant)    bands = NULL;
+    GArray                *bands_array;
+
+    ctx = g_task_get_task_data (task);
+
+    bands_array = MM_IFACE_MODEM_GET_INTERFACE (self)->load_supported_bands_finish (self, res, &error);
+    if (!bands_array) {
+        mm_obj_dbg (self, "couldn't revalidate cached supported bands: %s", error->message);
+        g_object_unref (task);
+        return;
+    }
+
+    mm_common_bands_garray_sort (bands_array);
+    bands = g_variant_ref_sink (mm_common_bands_garray_to_variant (bands_array));
+    g_array_unref (bands_array);
+
+    if (!g_variant_equal (bands, mm_gdbus_modem_get_supported_bands (ctx->skeleton))) {
+        mm_obj_info (self, "cached supported bands were outdated");
+        mm_gdbus_modem_set_supported_bands (ctx->skeleton, bands);
+    }
+    modem_cache_store (self, ctx->skeleton, MODEM_CACHE_SUPPORTED_BANDS, bands);
+    g_object_unref (task);
+}
+
+static void
+revalidate_supported_ip_families_ready (MMIfaceModem *self,
+                                        GAsyncResult *res,
+                                        GTask        *task)
+{
+    InitializationContext *ctx;
+    g_autoptr(GError)      error = NULL;
+    g_autoptr(GVariant)    value = NULL;
+    MMBearerIpFamily       ip_families;
+
+    ctx = g_task_get_task_data (task);
+
+    ip_families = MM_IFACE_MODEM_GET_INTERFACE (self)->load_supported_ip_families_finish (self, res, &error);
+    if (ip_families == MM_BEARER_IP_FAMILY_NONE) {
+        mm_obj_dbg (self, "couldn't revalidate cached supported IP families: %s",
+                    error ? error->message : "none reported");
+        g_object_unref (task);
+        return;
+    }
+
+    if (ip_families != mm_gdbus_modem_get_supported_ip_families (ctx->skeleton)) {
+        mm_obj_info (self, "cached supported IP families were outdated");
+        mm_gdbus_modem_set_supported_ip_families (ctx->skeleton, ip_families);
+    }
+    value = g_variant_ref_sink (g_variant_new_uint32 (ip_families));
+    modem_cache_store (self, ctx->skeleton, MODEM_CACHE_SUPPORTED_IP_FAMILIES, value);
+    g_object_unref (task);
+}
+
+/*****************************************************************************/
+
 static void
 load_supported_modes_ready (MMIfaceModem *self,
                             GAsyncResult *res,
@@ -4927,6 +5268,8 @@ load_supported_modes_ready (MMIfaceModem *self,
     if (modes_array != NULL) {
         mm_gdbus_modem_set_supported_modes (ctx->skeleton,
                                             mm_common_mode_combinations_garray_to_variant (modes_array));
+        modem_cache_store (self, ctx->skeleton, MODEM_CACHE_SUPPORTED_MODES,
+                           mm_gdbus_modem_get_supported_modes (ctx->skeleton));
         g_array_unref (modes_array);
     }
 
@@ -4954,6 +5297,8 @@ load_supported_bands_ready (MMIfaceModem *self,
         mm_common_bands_garray_sort (bands_array);
         mm_gdbus_modem_set_supported_bands (ctx->skeleton,
                                             mm_common_bands_garray_to_variant (bands_array));
+        modem_cache_store (self, ctx->skeleton, MODEM_CACHE_SUPPORTED_BANDS,
+                           mm_gdbus_modem_get_supported_bands (ctx->skeleton));
         g_array_unref (bands_array);
     }
 
@@ -4978,8 +5323,13 @@ load_supported_ip_families_ready (MMIfaceModem *self,
 
     ip_families = MM_IFACE_MODEM_GET_INTERFACE (self)->load_supported_ip_families_finish (self, res, &error);
 
-    if (ip_families != MM_BEARER_IP_FAMILY_NONE)
+    if (ip_families != MM_BEARER_IP_FAMILY_NONE) {
+        g_autoptr(GVariant) value = NULL;
+
         mm_gdbus_modem_set_supported_ip_families (ctx->skeleton, ip_families);
+        value = g_variant_ref_sink (g_variant_new_uint32 (ip_families));
+        modem_cache_store (self, ctx->skeleton, MODEM_CACHE_SUPPORTED_IP_FAMILIES, value);
+    }
 
     if (error)
         mm_obj_dbg (self, "couldn't load supported IP families: %s", error->message);
@@ -5269,9 +5619,8 @@ load_carrier_config_ready (MMIfaceModem *self,
         mm_gdbus_modem_set_carrier_configuration_revision (ctx->skeleton, revision);
     }
 
-    /* Go on to next step */
-    ctx->step++;
-    interface_initialization_step (task);
+    /* Let the graph schedule the next steps */
+    initialization_graph_node_done (task, INITIALIZATION_STEP_CARRIER_CONFIG);
 }
 
 static void
@@ -5297,6 +5646,182 @@ load_own_numbers_ready (MMIfaceModem *self,
     interface_initialization_step (task);
 }
 
+/*****************************************************************************/
+/* Initialization dependency graph
+ *
+ * The modem identification steps don't depend on each other, except for the
+ * device identifier, which is built from the other values. On modems
+ * controlled through QMI or MBIM each of these loads goes to its own client
+ * (DMS, PDC...), so they're run concurrently as soon as their dependencies are
+ * done. When a single AT port would serialize them anyway, they're run one by
+ * one, in the same order they're listed here.
+ */
+
+#define INITIALIZATION_STEP_BIT(step) (1u << (step))
+
+#undef STR_LOAD_START_FN
+#define STR_LOAD_START_FN(NAME)                                         \
+    static gboolean                                                     \
+    start_load_##NAME (MMIfaceModem *self,                              \
+                       GTask        *task)                              \
+    {                                                                   \
+        InitializationContext *ctx;                                     \
+                                                                        \
+        ctx = g_task_get_task_data (task);                              \
+                                                                        \
+        /* Loaded only once during the whole lifetime of the modem */   \
+        if (mm_gdbus_modem_get_##NAME (ctx->skeleton) != NULL ||        \
+            !MM_IFACE_MODEM_GET_INTERFACE (self)->load_##NAME ||        \
+            !MM_IFACE_MODEM_GET_INTERFACE (self)->load_##NAME##_finish) \
+            return FALSE;                                               \
+                                                                        \
+        MM_IFACE_MODEM_GET_INTERFACE (self)->load_##NAME (              \
+            self,                                                       \
+            (GAsyncReadyCallback)load_##NAME##_ready,                   \
+            task);                                                      \
+        return TRUE;                                                    \
+    }
+
+STR_LOAD_START_FN (manufacturer)
+STR_LOAD_START_FN (model)
+STR_LOAD_START_FN (revision)
+STR_LOAD_START_FN (hardware_revision)
+STR_LOAD_START_FN (equipment_identifier)
+STR_LOAD_START_FN (device_identifier)
+
+static gboolean
+start_load_carrier_config (MMIfaceModem *self,
+                           GTask        *task)
+{
+    InitializationContext *ctx;
+
+    ctx = g_task_get_task_data (task);
+
+    /* Loaded only once during the whole lifetime of the modem */
+    if (mm_gdbus_modem_get_carrier_configuration (ctx->skeleton) != NULL ||
+        !MM_IFACE_MODEM_GET_INTERFACE (self)->load_carrier_config ||
+        !MM_IFACE_MODEM_GET_INTERFACE (self)->load_carrier_config_finish)
+        return FALSE;
+
+    MM_IFACE_MODEM_GET_INTERFACE (self)->load_carrier_config (
+        self,
+        (GAsyncReadyCallback)load_carrier_config_ready,
+        task);
+    return TRUE;
+}
+
+typedef struct {
+    InitializationStep   step;
+    const gchar         *name;
+    guint32              depends_on;
+    /* Returns FALSE if there is nothing to load */
+    gboolean           (*start) (MMIfaceModem *self,
+                                 GTask        *task);
+} InitializationGraphNode;
+
+static const InitializationGraphNode initialization_graph[] = {
+    { INITIALIZATION_STEP_MANUFACTURER,      "manufacturer",         0, start_load_manufacturer         },
+    { INITIALIZATION_STEP_MODEL,             "model",                0, start_load_model                },
+    { INITIALIZATION_STEP_REVISION,          "revision",             0, start_load_revision             },
+    { INITIALIZATION_STEP_CARRIER_CONFIG,    "carrier config",       0, start_load_carrier_config       },
+    { INITIALIZATION_STEP_HARDWARE_REVISION, "hardware revision",    0, start_load_hardware_revision    },
+    { INITIALIZATION_STEP_EQUIPMENT_ID,      "equipment identifier", 0, start_load_equipment_identifier },
+    { INITIALIZATION_STEP_DEVICE_ID,         "device identifier",
+      (INITIALIZATION_STEP_BIT (INITIALIZATION_STEP_MANUFACTURER) |
+       INITIALIZATION_STEP_BIT (INITIALIZATION_STEP_MODEL) |
+       INITIALIZATION_STEP_BIT (INITIALIZATION_STEP_REVISION) |
+       INITIALIZATION_STEP_BIT (INITIALIZATION_STEP_EQUIPMENT_ID)),   start_load_device_identifier    },
+};
+
+G_STATIC_ASSERT (INITIALIZATION_STEP_LAST <= 32);
+
+static gboolean
+initialization_graph_allows_concurrency (MMIfaceModem *self)
+{
+#if defined WITH_QMI
+    if (MM_IS_BROADBAND_MODEM_QMI (self))
+        return TRUE;
+#endif
+#if defined WITH_MBIM
+    if (MM_IS_BROADBAND_MODEM_MBIM (self))
+        return TRUE;
+#endif
+    return FALSE;
+}
+
+static void
+initialization_graph_run (GTask *task)
+{
+    MMIfaceModem          *self;
+    InitializationContext *ctx;
+    guint                  i;
+
+    self = g_task_get_source_object (task);
+    ctx = g_task_get_task_data (task);
+
+    if (!ctx->graph_running && !ctx->graph_done) {
+        ctx->graph_concurrent = initialization_graph_allows_concurrency (self);
+        ctx->graph_start_time = g_get_monotonic_time ();
+        mm_obj_dbg (self, "loading modem identification (%s)...",
+                    ctx->graph_concurrent ? "concurrently" : "sequentially");
+    }
+
+    for (i = 0; i < G_N_ELEMENTS (initialization_graph); i++) {
+        const InitializationGraphNode *node = &initialization_graph[i];
+        guint32                        bit = INITIALIZATION_STEP_BIT (node->step);
+
+        if ((ctx->graph_running | ctx->graph_done) & bit)
+            continue;
+        if (ctx->graph_running && !ctx->graph_concurrent)
+            break;
+        if ((ctx->graph_done & node->depends_on) != node->depends_on)
+            continue;
+
+        ctx->graph_running |= bit;
+        ctx->step_start_time[node->step] = g_get_monotonic_time ();
+        if (!node->start (self, task)) {
+            ctx->graph_running &= ~bit;
+            ctx->graph_done |= bit;
+        }
+    }
+
+    /* Wait for all pending loads */
+    if (ctx->graph_running)
+        return;
+
+    mm_obj_dbg (self, "modem identification loaded in %.3f s",
+                (gdouble) (g_get_monotonic_time () - ctx->graph_start_time) / G_USEC_PER_SEC);
+
+    /* Go on with the first step after the graph */
+    ctx->step = INITIALIZATION_STEP_DEVICE_ID + 1;
+    interface_initialization_step (task);
+}
+
+static void
+initialization_graph_node_done (GTask              *task,
+                                InitializationStep  step)
+{
+    InitializationContext *ctx;
+    guint                  i;
+
+    ctx = g_task_get_task_data (task);
+
+    g_assert (ctx->graph_running & INITIALIZATION_STEP_BIT (step));
+    ctx->graph_running &= ~INITIALIZATION_STEP_BIT (step);
+    ctx->graph_done |= INITIALIZATION_STEP_BIT (step);
+
+    for (i = 0; i < G_N_ELEMENTS (initialization_graph); i++) {
+        if (initialization_graph[i].step == step) {
+            mm_obj_dbg (g_task_get_source_object (task), "%s loading took %.3f s",
+                        initialization_graph[i].name,
+                        (gdouble) (g_get_monotonic_time () - ctx->step_start_time[step]) / G_USEC_PER_SEC);
+            break;
+        }
+    }
+
+    initialization_graph_run (task);
+}
+
 static void
 interface_initialization_step (GTask *task)
 {
@@ -5515,115 +6040,15 @@ interface_initialization_step (GTask *task)
     } /* fall-through */
 
     case INITIALIZATION_STEP_MANUFACTURER:
-        /* Manufacturer is meant to be loaded only once during the whole
-         * lifetime of the modem. Therefore, if we already have them loaded,
-         * don't try to load them again. */
-        if (mm_gdbus_modem_get_manufacturer (ctx->skeleton) == NULL &&
-            MM_IFACE_MODEM_GET_INTERFACE (self)->load_manufacturer &&
-            MM_IFACE_MODEM_GET_INTERFACE (self)->load_manufacturer_finish) {
-            MM_IFACE_MODEM_GET_INTERFACE (self)->load_manufacturer (
-                self,
-                (GAsyncReadyCallback)load_manufacturer_ready,
-                task);
-            return;
-        }
-        ctx->step++;
-        /* fall-through */
-
     case INITIALIZATION_STEP_MODEL:
-        /* Model is meant to be loaded only once during the whole
-         * lifetime of the modem. Therefore, if we already have them loaded,
-         * don't try to load them again. */
-        if (mm_gdbus_modem_get_model (ctx->skeleton) == NULL &&
-            MM_IFACE_MODEM_GET_INTERFACE (self)->load_model &&
-            MM_IFACE_MODEM_GET_INTERFACE (self)->load_model_finish) {
-            MM_IFACE_MODEM_GET_INTERFACE (self)->load_model (
-                self,
-                (GAsyncReadyCallback)load_model_ready,
-                task);
-            return;
-        }
-        ctx->step++;
-        /* fall-through */
-
     case INITIALIZATION_STEP_REVISION:
-        /* Revision is meant to be loaded only once during the whole
-         * lifetime of the modem. Therefore, if we already have them loaded,
-         * don't try to load them again. */
-        if (mm_gdbus_modem_get_revision (ctx->skeleton) == NULL &&
-            MM_IFACE_MODEM_GET_INTERFACE (self)->load_revision &&
-            MM_IFACE_MODEM_GET_INTERFACE (self)->load_revision_finish) {
-            MM_IFACE_MODEM_GET_INTERFACE (self)->load_revision (
-                self,
-                (GAsyncReadyCallback)load_revision_ready,
-                task);
-            return;
-        }
-        ctx->step++;
-        /* fall-through */
-
     case INITIALIZATION_STEP_CARRIER_CONFIG:
-        /* Current carrier config is meant to be loaded only once during the whole
-         * lifetime of the modem. Therefore, if we already have them loaded,
-         * don't try to load them again. */
-        if (mm_gdbus_modem_get_carrier_configuration (ctx->skeleton) == NULL &&
-            MM_IFACE_MODEM_GET_INTERFACE (self)->load_carrier_config &&
-            MM_IFACE_MODEM_GET_INTERFACE (self)->load_carrier_config_finish) {
-            MM_IFACE_MODEM_GET_INTERFACE (self)->load_carrier_config (self,
-                                                                      (GAsyncReadyCallback)load_carrier_config_ready,
-                                                                      task);
-            return;
-        }
-        ctx->step++;
-        /* fall-through */
-
     case INITIALIZATION_STEP_HARDWARE_REVISION:
-        /* HardwareRevision is meant to be loaded only once during the whole
-         * lifetime of the modem. Therefore, if we already have them loaded,
-         * don't try to load them again. */
-        if (mm_gdbus_modem_get_hardware_revision (ctx->skeleton) == NULL &&
-            MM_IFACE_MODEM_GET_INTERFACE (self)->load_hardware_revision &&
-            MM_IFACE_MODEM_GET_INTERFACE (self)->load_hardware_revision_finish) {
-            MM_IFACE_MODEM_GET_INTERFACE (self)->load_hardware_revision (
-                self,
-                (GAsyncReadyCallback)load_hardware_revision_ready,
-                task);
-            return;
-        }
-        ctx->step++;
-        /* fall-through */
-
     case INITIALIZATION_STEP_EQUIPMENT_ID:
-        /* Equipment ID is meant to be loaded only once during the whole
-         * lifetime of the modem. Therefore, if we already have them loaded,
-         * don't try to load them again. */
-        if (mm_gdbus_modem_get_equipment_identifier (ctx->skeleton) == NULL &&
-            MM_IFACE_MODEM_GET_INTERFACE (self)->load_equipment_identifier &&
-            MM_IFACE_MODEM_GET_INTERFACE (self)->load_equipment_identifier_finish) {
-            MM_IFACE_MODEM_GET_INTERFACE (self)->load_equipment_identifier (
-                self,
-                (GAsyncReadyCallback)load_equipment_identifier_ready,
-                task);
-            return;
-        }
-        ctx->step++;
-        /* fall-through */
-
     case INITIALIZATION_STEP_DEVICE_ID:
-        /* Device ID is meant to be loaded only once during the whole
-         * lifetime of the modem. Therefore, if we already have them loaded,
-         * don't try to load them again. */
-        if (mm_gdbus_modem_get_device_identifier (ctx->skeleton) == NULL &&
-            MM_IFACE_MODEM_GET_INTERFACE (self)->load_device_identifier &&
-            MM_IFACE_MODEM_GET_INTERFACE (self)->load_device_identifier_finish) {
-            MM_IFACE_MODEM_GET_INTERFACE (self)->load_device_identifier (
-                self,
-                (GAsyncReadyCallback)load_device_identifier_ready,
-                task);
-            return;
-        }
-        ctx->step++;
-        /* fall-through */
+        /* The graph goes on with the next step once all its nodes are done */
+        initialization_graph_run (task);
+        return;
 
     case INITIALIZATION_STEP_SUPPORTED_MODES:
         if (MM_IFACE_MODEM_GET_INTERFACE (self)->load_supported_modes != NULL &&
@@ -5641,12 +6066,25 @@ interface_initialization_step (GTask *task)
                 mode = &g_array_index (supported_modes, MMModemModeCombination, 0);
             if (supported_modes->len == 0 ||
                 (mode && mode->allowed == MM_MODEM_MODE_ANY && mode->preferred == MM_MODEM_MODE_NONE)) {
+                g_autoptr(GVariant) cached = NULL;
+
+                if (modem_cache_modes_bands_usable (self, ctx->skeleton))
+                    cached = modem_cache_lookup (self, ctx->skeleton, MODEM_CACHE_SUPPORTED_MODES, G_VARIANT_TYPE ("a(uu)"));
+                if (!cached) {
+                    MM_IFACE_MODEM_GET_INTERFACE (self)->load_supported_modes (
+                        self,
+                        (GAsyncReadyCallback)load_supported_modes_ready,
+                        task);
+                    g_array_unref (supported_modes);
+                    return;
+                }
+
+                mm_obj_dbg (self, "supported modes loaded from cache, revalidating in the background");
+                mm_gdbus_modem_set_supported_modes (ctx->skeleton, cached);
                 MM_IFACE_MODEM_GET_INTERFACE (self)->load_supported_modes (
                     self,
-                    (GAsyncReadyCallback)load_supported_modes_ready,
-                    task);
-                g_array_unref (supported_modes);
-                return;
+                    (GAsyncReadyCallback)revalidate_supported_modes_ready,
+                    g_object_ref (task));
             }
 
             g_array_unref (supported_modes);
@@ -5667,17 +6105,30 @@ interface_initialization_step (GTask *task)
             g_array_index (supported_bands, MMModemBand, 0)  == MM_MODEM_BAND_UNKNOWN) {
             if (MM_IFACE_MODEM_GET_INTERFACE (self)->load_supported_bands &&
                 MM_IFACE_MODEM_GET_INTERFACE (self)->load_supported_bands_finish) {
+                g_autoptr(GVariant) cached = NULL;
+
+                if (modem_cache_modes_bands_usable (self, ctx->skeleton))
+                    cached = modem_cache_lookup (self, ctx->skeleton, MODEM_CACHE_SUPPORTED_BANDS, G_VARIANT_TYPE ("au"));
+                if (!cached) {
+                    MM_IFACE_MODEM_GET_INTERFACE (self)->load_supported_bands (
+                        self,
+                        (GAsyncReadyCallback)load_supported_bands_ready,
+                        task);
+                    g_array_unref (supported_bands);
+                    return;
+                }
+
+                mm_obj_dbg (self, "supported bands loaded from cache, revalidating in the background");
+                mm_gdbus_modem_set_supported_bands (ctx->skeleton, cached);
                 MM_IFACE_MODEM_GET_INTERFACE (self)->load_supported_bands (
                     self,
-                    (GAsyncReadyCallback)load_supported_bands_ready,
-                    task);
-                g_array_unref (supported_bands);
-                return;
+                    (GAsyncReadyCallback)revalidate_supported_bands_ready,
+                    g_object_ref (task));
+            } else {
+                /* Loading supported bands not implemented, default to UNKNOWN */
+                mm_gdbus_modem_set_supported_bands (ctx->skeleton, mm_common_build_bands_unknown ());
+                mm_gdbus_modem_set_current_bands (ctx->skeleton, mm_common_build_bands_unknown ());
             }
-
-            /* Loading supported bands not implemented, default to UNKNOWN */
-            mm_gdbus_modem_set_supported_bands (ctx->skeleton, mm_common_build_bands_unknown ());
-            mm_gdbus_modem_set_current_bands (ctx->skeleton, mm_common_build_bands_unknown ());
         }
         g_array_unref (supported_bands);
 
@@ -5691,11 +6142,23 @@ interface_initialization_step (GTask *task)
         if (MM_IFACE_MODEM_GET_INTERFACE (self)->load_supported_ip_families != NULL &&
             MM_IFACE_MODEM_GET_INTERFACE (self)->load_supported_ip_families_finish != NULL &&
             mm_gdbus_modem_get_supported_ip_families (ctx->skeleton) == MM_BEARER_IP_FAMILY_NONE) {
+            g_autoptr(GVariant) cached = NULL;
+
+            cached = modem_cache_lookup (self, ctx->skeleton, MODEM_CACHE_SUPPORTED_IP_FAMILIES, G_VARIANT_TYPE_UINT32);
+            if (!cached) {
+                MM_IFACE_MODEM_GET_INTERFACE (self)->load_supported_ip_families (
+                    self,
+                    (GAsyncReadyCallback)load_supported_ip_families_ready,
+                    task);
+                return;
+            }
+
+            mm_obj_dbg (self, "supported IP families loaded from cache, revalidating in the background");
+            mm_gdbus_modem_set_supported_ip_families (ctx->skeleton, g_variant_get_uint32 (cached));
             MM_IFACE_MODEM_GET_INTERFACE (self)->load_supported_ip_families (
                 self,
-                (GAsyncReadyCallback)load_supported_ip_families_ready,
-                task);
-            return;
+                (GAsyncReadyCallback)revalidate_supported_ip_families_ready,
+                g_object_ref (task));
         }
         ctx->step++;
         /* fall-through */
@@ -5977,6 +6440,9 @@ interface_initialization_step (GTask *task)
             mm_gdbus_object_skeleton_set_modem (MM_GDBUS_OBJECT_SKELETON (self),
                                                 MM_GDBUS_MODEM (ctx->skeleton));
 
+        mm_obj_dbg (self, "modem interface initialization took %.3f s",
+                    (gdouble) (g_get_monotonic_time () - ctx->start_time) / G_USEC_PER_SEC);
+
         if (ctx->fatal_error)
             g_task_return_error (task, g_steal_pointer (&ctx->fatal_error));
         else
@@ -6058,6 +6524,7 @@ mm_iface_modem_initialize (MMIfaceModem *self,
     ctx = g_new0 (InitializationContext, 1);
     ctx->step = INITIALIZATION_STEP_FIRST;
     ctx->skeleton = skeleton;
+    ctx->start_time = g_get_monotonic_time ();
 
     task = g_task_new (self, NULL, callback, user_data);
     g_task_set_task_data (task, ctx, (GDestroyNotify)initialization_context_free);
@@ -6106,7 +6573,7 @@ mm_iface_modem_get_access_technologies (MMIfaceModem *self)
                   NULL);
 
     if (skeleton) {
-        access_tech = mm_gdbus_modem_get_access_technologies (skeleton);
+        access_tech = peek_access_technologies (self, skeleton);
         g_object_unref (skeleton);
     }
 
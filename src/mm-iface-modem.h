@@ -164,6 +164,12 @@ struct _MMIfaceModem {
                                              GAsyncResult *res,
                                              GError **error);
 
+    /* Set when loading the supported modes or bands also sets up state in
+     * the implementation itself (e.g. to expand ANY when setting current
+     * bands), so that they're always loaded during initialization instead
+     * of being taken from the modem cache. */
+    gboolean supported_modes_bands_stateful;
+
     /* Loading of the Bands property */
     void (*load_current_bands) (MMIfaceModem *self,
                                 GAsyncReadyCallback callback,
@@ -38,7 +38,7 @@ mm_log_simple_connect_properties (gpointer                   log_object,
 {
     g_autoptr(GPtrArray) print_array = NULL;
 
-    if (!mm_log_check_level_enabled (level))
+    if (!mm_obj_log_enabled (log_object, level))
       return;
 
     print_array = mm_simple_connect_properties_print (value, mm_log_get_show_personal_info ());
@@ -53,7 +53,7 @@ mm_log_bearer_properties (gpointer            log_object,
 {
     g_autoptr(GPtrArray) print_array = NULL;
 
-    if (!mm_log_check_level_enabled (level))
+    if (!mm_obj_log_enabled (log_object, level))
       return;
 
     print_array = mm_bearer_properties_print (value, mm_log_get_show_personal_info ());
@@ -68,7 +68,7 @@ mm_log_3gpp_profile (gpointer       log_object,
 {
     g_autoptr(GPtrArray) print_array = NULL;
 
-    if (!mm_log_check_level_enabled (level))
+    if (!mm_obj_log_enabled (log_object, level))
       return;
 
     print_array = mm_3gpp_profile_print (value, mm_log_get_show_personal_info ());
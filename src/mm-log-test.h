@@ -43,4 +43,12 @@ _mm_log (gpointer     obj,
     g_free (msg);
 }
 
+gboolean
+_mm_log_check_enabled (gpointer     obj,
+                       const gchar *module,
+                       MMLogLevel   level)
+{
+    return g_test_verbose ();
+}
+
 #endif /* MM_LOG_TEST_H */
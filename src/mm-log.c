@@ -83,6 +83,59 @@ static const LogDesc level_descs[] = {
 static GString *msgbuf = NULL;
 static gsize msgbuf_once = 0;
 
+/* Per-object and per-module log levels, overriding the global one */
+typedef struct {
+    gchar   *pattern;
+    gsize    pattern_len;
+    guint32  level;
+} LogFilter;
+
+static GArray  *log_filters;
+static guint32  log_level_any = MM_LOG_LEVEL_MSG | MM_LOG_LEVEL_WARN | MM_LOG_LEVEL_ERR;
+
+/*****************************************************************************/
+/* Asynchronous logging
+ *
+ * Formatted records are queued in a bounded ring which may be filled from any
+ * thread without locking, and a dedicated writer thread drains it into the log
+ * backend, so that slow log storage doesn't stall the main loop.
+ *
+ * Each slot has a sequence number telling whether it's ready to be written by
+ * a producer (sequence == position) or read by the writer thread
+ * (sequence == position + 1). The mutex and conditions are only used to sleep
+ * when the ring is empty (writer) or full (producers).
+ *
+ * When the ring is full, DEBUG and INFO records are dropped and accounted,
+ * while records of higher levels wait until there is room for them.
+ */
+
+#define LOG_QUEUE_SIZE 1024 /* must be a power of 2 */
+#define LOG_QUEUE_MASK (LOG_QUEUE_SIZE - 1)
+
+typedef struct {
+    gint        sequence;
+    int         syslog_level;
+    const char *loc;
+    const char *func;
+    gchar      *message;
+    gsize       length;
+} LogRecord;
+
+static gint      log_async;
+static gboolean  log_file_sync = TRUE;
+static LogRecord log_queue[LOG_QUEUE_SIZE];
+static gint      log_queue_head;
+static gint      log_queue_tail;
+static gint      log_queue_dropped;
+static GThread  *log_writer;
+static gint      log_writer_waiting;
+static gint      log_writer_stopping;
+static gint      log_producers_waiting;
+static gint      log_producers_pushing;
+static GMutex    log_writer_mutex;
+static GCond     log_writer_cond;
+static GCond     log_producers_cond;
+
 static int
 mm_to_syslog_priority (MMLogLevel level)
 {
@@ -165,7 +218,10 @@ log_backend_file (const char *loc,
     ign = write (logfd, message, length);
     if (ign) {} /* whatever; really shut up about unused result */
 
-    fsync (logfd);  /* Make sure output is dumped to disk immediately  */
+    /* Make sure output is dumped to disk immediately; the async writer
+     * syncs once per batch instead */
+    if (log_file_sync)
+        fsync (logfd);
 }
 
 static void
@@ -215,6 +271,232 @@ log_backend_systemd_journal (const char *loc,
 }
 #endif
 
+/*****************************************************************************/
+
+static gboolean
+log_queue_try_push (int         syslog_level,
+                    const char *loc,
+                    const char *func,
+                    GString    *buf)
+{
+    LogRecord *record;
+    guint      pos;
+    gint       diff;
+
+    pos = (guint) g_atomic_int_get (&log_queue_head);
+    for (;;) {
+        record = &log_queue[pos & LOG_QUEUE_MASK];
+        diff = (gint) ((guint) g_atomic_int_get (&record->sequence) - pos);
+        /* full, the writer thread hasn't released this slot yet */
+        if (diff < 0)
+            return FALSE;
+        /* slot free, try to reserve it */
+        if (diff == 0 && g_atomic_int_compare_and_exchange (&log_queue_head, (gint) pos, (gint) (pos + 1)))
+            break;
+        /* some other producer took it, retry */
+        pos = (guint) g_atomic_int_get (&log_queue_head);
+    }
+
+    record->syslog_level = syslog_level;
+    record->loc          = loc;
+    record->func         = func;
+    record->length       = buf->len;
+    record->message      = g_string_free (buf, FALSE);
+    g_atomic_int_set (&record->sequence, (gint) (pos + 1));
+    return TRUE;
+}
+
+static gboolean
+log_queue_full (void)
+{
+    guint pos;
+
+    pos = (guint) g_atomic_int_get (&log_queue_head);
+    return ((gint) ((guint) g_atomic_int_get (&log_queue[pos & LOG_QUEUE_MASK].sequence) - pos) < 0);
+}
+
+static LogRecord *
+log_queue_peek (void)
+{
+    LogRecord *record;
+    guint      pos;
+
+    /* Only the writer thread updates the tail */
+    pos = (guint) g_atomic_int_get (&log_queue_tail);
+    record = &log_queue[pos & LOG_QUEUE_MASK];
+    if ((guint) g_atomic_int_get (&record->sequence) != pos + 1)
+        return NULL;
+    return record;
+}
+
+static void
+log_queue_release (LogRecord *record)
+{
+    guint pos;
+
+    pos = (guint) g_atomic_int_get (&log_queue_tail);
+    g_clear_pointer (&record->message, g_free);
+    g_atomic_int_set (&record->sequence, (gint) (pos + LOG_QUEUE_SIZE));
+    g_atomic_int_set (&log_queue_tail, (gint) (pos + 1));
+}
+
+static void
+log_writer_wake (void)
+{
+    if (!g_atomic_int_get (&log_writer_waiting))
+        return;
+    g_mutex_lock (&log_writer_mutex);
+    g_cond_signal (&log_writer_cond);
+    g_mutex_unlock (&log_writer_mutex);
+}
+
+static void
+log_producers_wake (void)
+{
+    if (!g_atomic_int_get (&log_producers_waiting))
+        return;
+    g_mutex_lock (&log_writer_mutex);
+    g_cond_broadcast (&log_producers_cond);
+    g_mutex_unlock (&log_writer_mutex);
+}
+
+static void
+log_queue_push (MMLogLevel  level,
+                const char *loc,
+                const char *func,
+                GString    *buf)
+{
+    while (!log_queue_try_push (mm_to_syslog_priority (level), loc, func, buf)) {
+        if (level & (MM_LOG_LEVEL_INFO | MM_LOG_LEVEL_DEBUG)) {
+            g_atomic_int_inc (&log_queue_dropped);
+            g_string_free (buf, TRUE);
+            return;
+        }
+
+        g_mutex_lock (&log_writer_mutex);
+        g_atomic_int_inc (&log_producers_waiting);
+        if (log_queue_full ())
+            g_cond_wait (&log_producers_cond, &log_writer_mutex);
+        g_atomic_int_add (&log_producers_waiting, -1);
+        g_mutex_unlock (&log_writer_mutex);
+    }
+    log_writer_wake ();
+}
+
+static void
+log_queue_flush (void)
+{
+    g_mutex_lock (&log_writer_mutex);
+    g_atomic_int_inc (&log_producers_waiting);
+    while (g_atomic_int_get (&log_queue_tail) != g_atomic_int_get (&log_queue_head)) {
+        g_cond_signal (&log_writer_cond);
+        g_cond_wait (&log_producers_cond, &log_writer_mutex);
+    }
+    g_atomic_int_add (&log_producers_waiting, -1);
+    g_mutex_unlock (&log_writer_mutex);
+}
+
+static void
+log_writer_report_dropped (void)
+{
+    g_autofree gchar *message = NULL;
+    gint              dropped;
+
+    dropped = g_atomic_int_get (&log_queue_dropped);
+    if (!dropped)
+        return;
+    g_atomic_int_add (&log_queue_dropped, -dropped);
+
+    message = g_strdup_printf ("%s%d log messages dropped: queue full\n",
+                               append_log_level_text ? "<wrn> " : "",
+                               dropped);
+    log_backend (NULL, NULL, LOG_WARNING, message, strlen (message));
+}
+
+static gpointer
+log_writer_thread (gpointer unused)
+{
+    LogRecord *record;
+
+    for (;;) {
+        gboolean written = FALSE;
+
+        while ((record = log_queue_peek ()) != NULL) {
+            log_backend (record->loc, record->func, record->syslog_level, record->message, record->length);
+            log_queue_release (record);
+            log_producers_wake ();
+            written = TRUE;
+        }
+        log_writer_report_dropped ();
+
+        if (written && logfd >= 0)
+            fsync (logfd);
+
+        g_mutex_lock (&log_writer_mutex);
+        /* wake up anyone flushing, the queue is empty now */
+        g_cond_broadcast (&log_producers_cond);
+        /* when stopping, keep on until producers that already decided to
+         * use the queue are done, some may be waiting for room */
+        if (g_atomic_int_get (&log_writer_stopping) &&
+            !log_queue_peek () &&
+            !g_atomic_int_get (&log_producers_pushing)) {
+            g_mutex_unlock (&log_writer_mutex);
+            break;
+        }
+        g_atomic_int_set (&log_writer_waiting, TRUE);
+        if (!log_queue_peek () && !g_atomic_int_get (&log_writer_stopping))
+            g_cond_wait (&log_writer_cond, &log_writer_mutex);
+        g_atomic_int_set (&log_writer_waiting, FALSE);
+        g_mutex_unlock (&log_writer_mutex);
+
+        if (g_atomic_int_get (&log_writer_stopping))
+            g_thread_yield ();
+    }
+
+    return NULL;
+}
+
+static void
+log_writer_start (void)
+{
+    guint i;
+
+    for (i = 0; i < LOG_QUEUE_SIZE; i++)
+        log_queue[i].sequence = (gint) i;
+    log_file_sync = FALSE;
+    log_writer = g_thread_new ("mm-log", log_writer_thread, NULL);
+    g_atomic_int_set (&log_async, TRUE);
+}
+
+static void
+log_writer_stop (void)
+{
+    LogRecord *record;
+
+    /* Stop accepting new records; from now on they're written synchronously */
+    g_mutex_lock (&log_writer_mutex);
+    g_atomic_int_set (&log_async, FALSE);
+    g_atomic_int_set (&log_writer_stopping, TRUE);
+    g_cond_signal (&log_writer_cond);
+    g_mutex_unlock (&log_writer_mutex);
+
+    g_thread_join (log_writer);
+    log_writer = NULL;
+
+    /* Write synchronously whatever was left behind */
+    while ((record = log_queue_peek ()) != NULL) {
+        log_backend (record->loc, record->func, record->syslog_level, record->message, record->length);
+        log_queue_release (record);
+    }
+    log_writer_report_dropped ();
+
+    log_file_sync = TRUE;
+    if (logfd >= 0)
+        fsync (logfd);
+}
+
+/*****************************************************************************/
+
 gboolean
 mm_log_get_show_personal_info (void)
 {
@@ -224,6 +506,43 @@ mm_log_get_show_personal_info (void)
 gboolean
 mm_log_check_level_enabled (MMLogLevel level)
 {
+    return (log_level_any & level);
+}
+
+gboolean
+_mm_log_check_enabled (gpointer     obj,
+                       const gchar *module,
+                       MMLogLevel   level)
+{
+    const gchar *id = NULL;
+    guint        i;
+
+    /* Quick check, not enabled anywhere */
+    if (!(log_level_any & level))
+        return FALSE;
+
+    if (!log_filters)
+        return TRUE;
+
+    /* The first filter matching either the module or the object wins */
+    for (i = 0; i < log_filters->len; i++) {
+        const LogFilter *filter;
+
+        filter = &g_array_index (log_filters, LogFilter, i);
+        if (module && g_str_equal (module, filter->pattern))
+            return (filter->level & level);
+
+        /* Object ids are matched including all their children, e.g. "modem0"
+         * matches "modem0/ttyUSB2/at" but not "modem01" */
+        if (obj) {
+            if (!id)
+                id = mm_log_object_get_id (MM_LOG_OBJECT (obj));
+            if (!strncmp (id, filter->pattern, filter->pattern_len) &&
+                (id[filter->pattern_len] == '\0' || id[filter->pattern_len] == '/'))
+                return (filter->level & level);
+        }
+    }
+
     return (log_level & level);
 }
 
@@ -236,24 +555,39 @@ _mm_log (gpointer     obj,
          const gchar *fmt,
          ...)
 {
-    va_list  args;
-    GTimeVal tv;
+    va_list   args;
+    GTimeVal  tv;
+    GString  *buf;
+    gboolean  async;
 
-    if (!mm_log_check_level_enabled (level))
+    if (!_mm_log_check_enabled (obj, module, level))
         return;
 
-    if (g_once_init_enter (&msgbuf_once)) {
-        msgbuf = g_string_sized_new (512);
-        g_once_init_leave (&msgbuf_once, 1);
-    } else
-        g_string_truncate (msgbuf, 0);
+    /* When logging asynchronously, each record owns its buffer until written.
+     * The producer is accounted as pushing before checking whether the queue
+     * is in use, so that the writer isn't stopped in between */
+    g_atomic_int_inc (&log_producers_pushing);
+    async = g_atomic_int_get (&log_async);
+    if (!async)
+        g_atomic_int_add (&log_producers_pushing, -1);
+
+    if (async)
+        buf = g_string_sized_new (256);
+    else {
+        if (g_once_init_enter (&msgbuf_once)) {
+            msgbuf = g_string_sized_new (512);
+            g_once_init_leave (&msgbuf_once, 1);
+        } else
+            g_string_truncate (msgbuf, 0);
+        buf = msgbuf;
+    }
 
     if (append_log_level_text)
-        g_string_append_printf (msgbuf, "%s ", log_level_description (level));
+        g_string_append_printf (buf, "%s ", log_level_description (level));
 
     if (ts_flags == TS_FLAG_WALL) {
         g_get_current_time (&tv);
-        g_string_append_printf (msgbuf, "[%09ld.%06ld] ", tv.tv_sec, tv.tv_usec);
+        g_string_append_printf (buf, "[%09ld.%06ld] ", tv.tv_sec, tv.tv_usec);
     } else if (ts_flags == TS_FLAG_REL) {
         glong secs;
         glong usecs;
@@ -266,26 +600,30 @@ _mm_log (gpointer     obj,
             usecs += 1000000;
         }
 
-        g_string_append_printf (msgbuf, "[%06ld.%06ld] ", secs, usecs);
+        g_string_append_printf (buf, "[%06ld.%06ld] ", secs, usecs);
     }
 
 #if defined MM_LOG_FUNC_LOC
     if (loc && func)
-        g_string_append_printf (msgbuf, "[%s] %s(): ", loc, func);
+        g_string_append_printf (buf, "[%s] %s(): ", loc, func);
 #endif
 
     if (obj)
-        g_string_append_printf (msgbuf, "[%s] ", mm_log_object_get_id (MM_LOG_OBJECT (obj)));
+        g_string_append_printf (buf, "[%s] ", mm_log_object_get_id (MM_LOG_OBJECT (obj)));
     if (module)
-        g_string_append_printf (msgbuf, "(%s) ", module);
+        g_string_append_printf (buf, "(%s) ", module);
 
     va_start (args, fmt);
-    g_string_append_vprintf (msgbuf, fmt, args);
+    g_string_append_vprintf (buf, fmt, args);
     va_end (args);
 
-    g_string_append_c (msgbuf, '\n');
+    g_string_append_c (buf, '\n');
 
-    log_backend (loc, func, mm_to_syslog_priority (level), msgbuf->str, msgbuf->len);
+    if (async) {
+        log_queue_push (level, loc, func, buf);
+        g_atomic_int_add (&log_producers_pushing, -1);
+    } else
+        log_backend (loc, func, mm_to_syslog_priority (level), buf->str, buf->len);
 }
 
 static void
@@ -301,35 +639,100 @@ log_handler (const gchar    *log_domain,
              glib_level_to_mm_level (glib_level),
              "%s",
              message);
+
+    /* The program is about to abort, make sure the message reaches the log */
+    if (g_atomic_int_get (&log_async) && (glib_level & (G_LOG_FLAG_FATAL | G_LOG_LEVEL_ERROR)))
+        log_queue_flush ();
 }
 
-gboolean
-mm_log_set_level (const gchar  *level,
-                  GError      **error)
+static gboolean
+log_level_parse (const gchar *str,
+                 guint32     *out_level)
 {
     guint i;
 
-    for (i = 0; i < G_N_ELEMENTS (level_descs); i++) {
-        if (!g_ascii_strcasecmp (level_descs[i].name, level)) {
-            log_level = level_descs[i].num;
-            break;
+    for (i = 0; level_descs[i].name; i++) {
+        if (!g_ascii_strcasecmp (level_descs[i].name, str)) {
+            *out_level = level_descs[i].num;
+            return TRUE;
         }
     }
+    return FALSE;
+}
 
-    if (i == G_N_ELEMENTS (level_descs)) {
-        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
-                     "Unknown log level '%s'", level);
-        return FALSE;
-    }
+static void
+log_level_any_update (void)
+{
+    guint i;
+
+    log_level_any = log_level;
+    for (i = 0; log_filters && i < log_filters->len; i++)
+        log_level_any |= g_array_index (log_filters, LogFilter, i).level;
 
 #if defined WITH_QMI
-    qmi_utils_set_traces_enabled (log_level & MM_LOG_LEVEL_DEBUG ? TRUE : FALSE);
+    qmi_utils_set_traces_enabled (log_level_any & MM_LOG_LEVEL_DEBUG ? TRUE : FALSE);
 #endif
 
 #if defined WITH_MBIM
-    mbim_utils_set_traces_enabled (log_level & MM_LOG_LEVEL_DEBUG ? TRUE : FALSE);
+    mbim_utils_set_traces_enabled (log_level_any & MM_LOG_LEVEL_DEBUG ? TRUE : FALSE);
 #endif
+}
+
+static void
+log_filter_clear (LogFilter *filter)
+{
+    g_free (filter->pattern);
+}
+
+static gboolean
+log_filters_setup (const gchar  *str,
+                   GError      **error)
+{
+    g_auto(GStrv) items = NULL;
+    guint         i;
+
+    log_filters = g_array_new (FALSE, FALSE, sizeof (LogFilter));
+    g_array_set_clear_func (log_filters, (GDestroyNotify) log_filter_clear);
+
+    items = g_strsplit (str, ",", -1);
+    for (i = 0; items[i]; i++) {
+        LogFilter  filter;
+        gchar     *sep;
+
+        g_strstrip (items[i]);
+        if (!items[i][0])
+            continue;
+
+        sep = strchr (items[i], '=');
+        if (!sep || sep == items[i] || !log_level_parse (sep + 1, &filter.level)) {
+            g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
+                         "Invalid log filter '%s': expected <object or module>=<level>", items[i]);
+            g_clear_pointer (&log_filters, g_array_unref);
+            return FALSE;
+        }
+        *sep = '\0';
+        filter.pattern = g_strdup (items[i]);
+        filter.pattern_len = strlen (filter.pattern);
+        g_array_append_val (log_filters, filter);
+    }
 
+    if (!log_filters->len)
+        g_clear_pointer (&log_filters, g_array_unref);
+    log_level_any_update ();
+    return TRUE;
+}
+
+gboolean
+mm_log_set_level (const gchar  *level,
+                  GError      **error)
+{
+    if (!log_level_parse (level, &log_level)) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
+                     "Unknown log level '%s'", level);
+        return FALSE;
+    }
+
+    log_level_any_update ();
     return TRUE;
 }
 
@@ -340,12 +743,17 @@ mm_log_setup (const gchar  *level,
               gboolean      show_timestamps,
               gboolean      rel_timestamps,
               gboolean      show_personal_info,
+              gboolean      async,
+              const gchar  *filter,
               GError      **error)
 {
     /* levels */
     if (level && strlen (level) && !mm_log_set_level (level, error))
         return FALSE;
 
+    if (filter && !log_filters_setup (filter, error))
+        return FALSE;
+
     personal_info = show_personal_info;
 
     if (show_timestamps)
@@ -378,6 +786,9 @@ mm_log_setup (const gchar  *level,
         log_backend = log_backend_file;
     }
 
+    if (async)
+        log_writer_start ();
+
     g_log_set_handler (G_LOG_DOMAIN,
                        G_LOG_LEVEL_MASK | G_LOG_FLAG_FATAL | G_LOG_FLAG_RECURSION,
                        log_handler,
@@ -412,10 +823,17 @@ mm_log_setup (const gchar  *level,
 void
 mm_log_shutdown (void)
 {
+    /* Flush all pending records before closing the backend */
+    if (log_writer)
+        log_writer_stop ();
+
     if (logfd < 0)
         closelog ();
     else
         close (logfd);
+
+    g_clear_pointer (&log_filters, g_array_unref);
+    log_level_any_update ();
 }
 
 /******************************************************************************/
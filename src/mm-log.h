@@ -35,12 +35,24 @@ typedef enum {
 # define MM_LOG_MODULE_NAME (const gchar *)NULL
 #endif
 
-#define mm_obj_log(obj, level, ...) _mm_log (obj, MM_LOG_MODULE_NAME, G_STRLOC, G_STRFUNC, level,              ## __VA_ARGS__ )
-#define mm_obj_err(obj, ...)        _mm_log (obj, MM_LOG_MODULE_NAME, G_STRLOC, G_STRFUNC, MM_LOG_LEVEL_ERR,   ## __VA_ARGS__ )
-#define mm_obj_warn(obj, ...)       _mm_log (obj, MM_LOG_MODULE_NAME, G_STRLOC, G_STRFUNC, MM_LOG_LEVEL_WARN,  ## __VA_ARGS__ )
-#define mm_obj_msg(obj, ...)        _mm_log (obj, MM_LOG_MODULE_NAME, G_STRLOC, G_STRFUNC, MM_LOG_LEVEL_MSG,   ## __VA_ARGS__ )
-#define mm_obj_info(obj, ...)       _mm_log (obj, MM_LOG_MODULE_NAME, G_STRLOC, G_STRFUNC, MM_LOG_LEVEL_INFO,  ## __VA_ARGS__ )
-#define mm_obj_dbg(obj, ...)        _mm_log (obj, MM_LOG_MODULE_NAME, G_STRLOC, G_STRFUNC, MM_LOG_LEVEL_DEBUG, ## __VA_ARGS__ )
+/* The log level is checked before evaluating the arguments, so that building
+ * strings only used in the log message is skipped when not logging them */
+#define _mm_obj_log_lazy(obj, level, ...)                                                      \
+    G_STMT_START {                                                                             \
+        if (_mm_log_check_enabled (obj, MM_LOG_MODULE_NAME, level))                            \
+            _mm_log (obj, MM_LOG_MODULE_NAME, G_STRLOC, G_STRFUNC, level, ## __VA_ARGS__ );    \
+    } G_STMT_END
+
+#define mm_obj_log(obj, level, ...) _mm_obj_log_lazy (obj, level,              ## __VA_ARGS__ )
+#define mm_obj_err(obj, ...)        _mm_obj_log_lazy (obj, MM_LOG_LEVEL_ERR,   ## __VA_ARGS__ )
+#define mm_obj_warn(obj, ...)       _mm_obj_log_lazy (obj, MM_LOG_LEVEL_WARN,  ## __VA_ARGS__ )
+#define mm_obj_msg(obj, ...)        _mm_obj_log_lazy (obj, MM_LOG_LEVEL_MSG,   ## __VA_ARGS__ )
+#define mm_obj_info(obj, ...)       _mm_obj_log_lazy (obj, MM_LOG_LEVEL_INFO,  ## __VA_ARGS__ )
+#define mm_obj_dbg(obj, ...)        _mm_obj_log_lazy (obj, MM_LOG_LEVEL_DEBUG, ## __VA_ARGS__ )
+
+/* Whether the given level is enabled for the object (and current module),
+ * considering the per-object and per-module log filters */
+#define mm_obj_log_enabled(obj, level) _mm_log_check_enabled (obj, MM_LOG_MODULE_NAME, level)
 
 /* only allow using non-object logging API if explicitly requested
  * (e.g. in the main daemon source) */
@@ -65,6 +77,9 @@ void _mm_log (gpointer     obj,
               MMLogLevel   level,
               const gchar *fmt,
               ...)  __attribute__((__format__ (__printf__, 6, 7)));
+gboolean _mm_log_check_enabled (gpointer     obj,
+                                const gchar *module,
+                                MMLogLevel   level);
 
 gboolean mm_log_set_level              (const gchar  *level,
                                         GError      **error);
@@ -74,6 +89,8 @@ gboolean mm_log_setup                  (const gchar  *level,
                                         gboolean      show_ts,
                                         gboolean      rel_ts,
                                         gboolean      show_personal_info,
+                                        gboolean      async,
+                                        const gchar  *filter,
                                         GError      **error);
 gboolean mm_log_check_level_enabled    (MMLogLevel    level);
 gboolean mm_log_get_show_personal_info (void);
@@ -0,0 +1,206 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 Telit
+ */
+
+#include <config.h>
+
+#include <ModemManager.h>
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+
+#include "mm-modem-cache.h"
+#include "mm-log-object.h"
+
+#define KEY_PLUGIN               "plugin"
+#define KEY_CURRENT_CAPABILITIES "current-capabilities"
+
+/* The cache is loaded lazily, the first time it's needed */
+static gchar    *cache_path;
+static GKeyFile *cache;
+static gboolean  cache_loaded;
+
+void
+mm_modem_cache_set_path (const gchar *path)
+{
+    g_clear_pointer (&cache, g_key_file_unref);
+    cache_loaded = FALSE;
+    g_free (cache_path);
+    cache_path = g_strdup (path);
+}
+
+static GKeyFile *
+cache_peek (gpointer log_object)
+{
+    g_autoptr(GError) error = NULL;
+
+    if (cache_loaded)
+        return cache;
+    cache_loaded = TRUE;
+
+    if (!cache_path)
+        return NULL;
+
+    cache = g_key_file_new ();
+    if (!g_key_file_load_from_file (cache, cache_path, G_KEY_FILE_NONE, &error) &&
+        !g_error_matches (error, G_FILE_ERROR, G_FILE_ERROR_NOENT))
+        mm_obj_warn (log_object, "couldn't load modem cache, starting from scratch: %s", error->message);
+    return cache;
+}
+
+static void
+cache_save (gpointer log_object)
+{
+    g_autoptr(GError) error = NULL;
+
+    if (!g_key_file_save_to_file (cache, cache_path, &error))
+        mm_obj_warn (log_object, "couldn't save modem cache: %s", error->message);
+}
+
+/*****************************************************************************/
+
+static gchar *
+build_group (const MMModemCacheKey *key)
+{
+    const gchar *aux;
+
+    if (!key->equipment_id || !key->equipment_id[0] ||
+        !key->revision || !key->revision[0] ||
+        !key->plugin)
+        return NULL;
+
+    for (aux = key->equipment_id; *aux; aux++) {
+        if (*aux == '[' || *aux == ']' || g_ascii_iscntrl (*aux))
+            return NULL;
+    }
+    for (aux = key->revision; *aux; aux++) {
+        if (*aux == '[' || *aux == ']' || g_ascii_iscntrl (*aux))
+            return NULL;
+    }
+
+    return g_strdup_printf ("%s %s", key->equipment_id, key->revision);
+}
+
+static gboolean
+cache_verify_group (GKeyFile               *keyfile,
+                    const gchar            *group,
+                    const MMModemCacheKey  *key,
+                    GError                **error)
+{
+    g_autofree gchar *plugin = NULL;
+    guint64           current_capabilities;
+
+    plugin = g_key_file_get_string (keyfile, group, KEY_PLUGIN, NULL);
+    if (g_strcmp0 (plugin, key->plugin) != 0) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                     "plugin changed (cached %s, current %s)",
+                     plugin ? plugin : "none", key->plugin);
+        return FALSE;
+    }
+
+    /* Errors loading the integer are reported as mismatches as well */
+    current_capabilities = g_key_file_get_uint64 (keyfile, group, KEY_CURRENT_CAPABILITIES, NULL);
+    if (current_capabilities != key->current_capabilities) {
+        g_autofree gchar *cached_str = NULL;
+        g_autofree gchar *current_str = NULL;
+
+        cached_str = mm_modem_capability_build_string_from_mask ((MMModemCapability) current_capabilities);
+        current_str = mm_modem_capability_build_string_from_mask (key->current_capabilities);
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                     "current capabilities changed (cached %s, current %s)",
+                     cached_str, current_str);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+GVariant *
+mm_modem_cache_lookup (gpointer               log_object,
+                       const MMModemCacheKey *key,
+                       const gchar           *name,
+                       const GVariantType    *type)
+{
+    GKeyFile          *keyfile;
+    GVariant          *value;
+    g_autofree gchar  *group = NULL;
+    g_autofree gchar  *str = NULL;
+    g_autoptr(GError)  error = NULL;
+
+    keyfile = cache_peek (log_object);
+    if (!keyfile)
+        return NULL;
+
+    group = build_group (key);
+    if (!group || !g_key_file_has_group (keyfile, group))
+        return NULL;
+
+    if (!cache_verify_group (keyfile, group, key, &error)) {
+        mm_obj_dbg (log_object, "cached modem properties invalidated: %s", error->message);
+        g_key_file_remove_group (keyfile, group, NULL);
+        cache_save (log_object);
+        return NULL;
+    }
+
+    str = g_key_file_get_string (keyfile, group, name, NULL);
+    if (!str)
+        return NULL;
+
+    value = g_variant_parse (type, str, NULL, NULL, &error);
+    if (!value) {
+        mm_obj_dbg (log_object, "couldn't parse cached %s: %s", name, error->message);
+        g_key_file_remove_key (keyfile, group, name, NULL);
+        cache_save (log_object);
+        return NULL;
+    }
+
+    return g_variant_ref_sink (value);
+}
+
+void
+mm_modem_cache_store (gpointer               log_object,
+                      const MMModemCacheKey *key,
+                      const gchar           *name,
+                      GVariant              *value)
+{
+    GKeyFile         *keyfile;
+    g_autofree gchar *group = NULL;
+    g_autofree gchar *str = NULL;
+    g_autofree gchar *previous = NULL;
+
+    keyfile = cache_peek (log_object);
+    if (!keyfile)
+        return;
+
+    group = build_group (key);
+    if (!group)
+        return;
+
+    if (g_key_file_has_group (keyfile, group) &&
+        !cache_verify_group (keyfile, group, key, NULL))
+        g_key_file_remove_group (keyfile, group, NULL);
+
+    /* Avoid rewriting the file when the value is already the cached one,
+     * which is the common case when revalidating */
+    str = g_variant_print (value, FALSE);
+    previous = g_key_file_get_string (keyfile, group, name, NULL);
+    if (!g_strcmp0 (previous, str))
+        return;
+
+    g_key_file_set_string (keyfile, group, KEY_PLUGIN, key->plugin);
+    g_key_file_set_uint64 (keyfile, group, KEY_CURRENT_CAPABILITIES, key->current_capabilities);
+    g_key_file_set_string (keyfile, group, name, str);
+
+    mm_obj_dbg (log_object, "stored %s in modem cache", name);
+    cache_save (log_object);
+}
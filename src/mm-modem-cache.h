@@ -0,0 +1,50 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 Telit
+ */
+
+#ifndef MM_MODEM_CACHE_H
+#define MM_MODEM_CACHE_H
+
+#include <glib.h>
+
+#include <ModemManager.h>
+
+/* Persistent cache of modem properties that never change for a given
+ * equipment, enabled with --modem-cache.
+ *
+ * Values are keyed by the equipment identifier and firmware revision, and
+ * are only reused if the plugin and current capabilities of the modem still
+ * match the ones stored. On any mismatch all the entries of the equipment
+ * are dropped. */
+
+typedef struct {
+    const gchar       *equipment_id;
+    const gchar       *revision;
+    const gchar       *plugin;
+    MMModemCapability  current_capabilities;
+} MMModemCacheKey;
+
+/* Path of the keyfile, NULL disables the cache */
+void      mm_modem_cache_set_path (const gchar           *path);
+
+GVariant *mm_modem_cache_lookup   (gpointer               log_object,
+                                   const MMModemCacheKey *key,
+                                   const gchar           *name,
+                                   const GVariantType    *type);
+void      mm_modem_cache_store    (gpointer               log_object,
+                                   const MMModemCacheKey *key,
+                                   const gchar           *name,
+                                   GVariant              *value);
+
+#endif /* MM_MODEM_CACHE_H */
@@ -37,6 +37,78 @@
 
 /*****************************************************************************/
 
+typedef struct {
+    gchar              *pattern;
+    GRegexCompileFlags  compile_options;
+    GRegexMatchFlags    match_options;
+} RegexCacheKey;
+
+static guint
+regex_cache_key_hash (const RegexCacheKey *key)
+{
+    return g_str_hash (key->pattern) ^ (guint) key->compile_options ^ ((guint) key->match_options << 16);
+}
+
+static gboolean
+regex_cache_key_equal (const RegexCacheKey *a,
+                       const RegexCacheKey *b)
+{
+    return (a->compile_options == b->compile_options &&
+            a->match_options == b->match_options &&
+            g_str_equal (a->pattern, b->pattern));
+}
+
+static void
+regex_cache_key_free (RegexCacheKey *key)
+{
+    g_free (key->pattern);
+    g_slice_free (RegexCacheKey, key);
+}
+
+G_LOCK_DEFINE_STATIC (regex_cache);
+static GHashTable *regex_cache;
+
+GRegex *
+mm_regex_cache_get (const gchar        *pattern,
+                    GRegexCompileFlags  compile_options,
+                    GRegexMatchFlags    match_options)
+{
+    RegexCacheKey  lookup_key;
+    RegexCacheKey *key;
+    GRegex        *regex;
+
+    lookup_key.pattern = (gchar *) pattern;
+    lookup_key.compile_options = compile_options;
+    lookup_key.match_options = match_options;
+
+    G_LOCK (regex_cache);
+
+    if (G_UNLIKELY (!regex_cache))
+        regex_cache = g_hash_table_new_full ((GHashFunc) regex_cache_key_hash,
+                                             (GEqualFunc) regex_cache_key_equal,
+                                             (GDestroyNotify) regex_cache_key_free,
+                                             (GDestroyNotify) g_regex_unref);
+
+    regex = g_hash_table_lookup (regex_cache, &lookup_key);
+    if (!regex) {
+        /* Patterns are constant, so failing to compile one is a programming error */
+        regex = g_regex_new (pattern, compile_options, match_options, NULL);
+        g_assert (regex);
+
+        key = g_slice_new (RegexCacheKey);
+        key->pattern = g_strdup (pattern);
+        key->compile_options = compile_options;
+        key->match_options = match_options;
+        g_hash_table_insert (regex_cache, key, regex);
+    }
+
+    G_UNLOCK (regex_cache);
+
+    return g_regex_ref (regex);
+}
+
+/*****************************************************************************/
+
 gchar *
 mm_strip_quotes (gchar *str)
 {
@@ -69,67 +141,404 @@ mm_strip_tag (const gchar *str, const gchar *cmd)
     return p;
 }
 
+/*****************************************************************************/
+/* AT command batching */
+
+gboolean
+mm_at_command_is_batchable (const gchar *command,
+                            gsize       *prefix_len)
+{
+    const gchar *p;
+
+    /* Standard extended commands start with '+', vendor-specific ones use
+     * other symbols, e.g. #PSNT? or $QCPDPP? */
+    if (!command || !command[0] || !strchr ("+#$%^*", command[0]))
+        return FALSE;
+
+    for (p = command + 1; g_ascii_isalnum (*p) || *p == '_'; p++);
+    if (p == command + 1)
+        return FALSE;
+
+    if (!g_str_equal (p, "?") && !g_str_equal (p, "=?"))
+        return FALSE;
+
+    if (prefix_len)
+        *prefix_len = p - command;
+    return TRUE;
+}
+
+gchar **
+mm_at_command_batch_split_response (const gchar         *response,
+                                    const gchar * const *commands,
+                                    guint                n_commands)
+{
+    g_auto(GStrv)      lines = NULL;
+    g_autofree gsize  *prefix_lens = NULL;
+    GString          **slices;
+    gchar            **split = NULL;
+    gint               owner = -1;
+    guint              i;
+
+    g_return_val_if_fail (commands != NULL, NULL);
+    g_return_val_if_fail (n_commands > 0, NULL);
+
+    prefix_lens = g_new (gsize, n_commands);
+    for (i = 0; i < n_commands; i++) {
+        if (!mm_at_command_is_batchable (commands[i], &prefix_lens[i]))
+            return NULL;
+    }
+
+    slices = g_new0 (GString *, n_commands);
+    lines = g_strsplit_set (response ? response : "", "\r\n", -1);
+    for (i = 0; lines[i]; i++) {
+        const gchar *line = lines[i];
+        guint        j;
+
+        if (!line[0])
+            continue;
+
+        /* A line tagged with the name of one of the commands starts its
+         * slice; untagged lines belong to the last tagged one. Replies come
+         * in the same order as the commands in the line. */
+        for (j = 0; j < n_commands; j++) {
+            if (!g_ascii_strncasecmp (line, commands[j], prefix_lens[j]) &&
+                line[prefix_lens[j]] == ':')
+                break;
+        }
+
+        if (j < n_commands) {
+            if ((gint) j < owner)
+                goto out;
+            owner = (gint) j;
+        } else if (owner < 0)
+            goto out;
+
+        if (!slices[owner])
+            slices[owner] = g_string_new (line);
+        else {
+            g_string_append (slices[owner], "\r\n");
+            g_string_append (slices[owner], line);
+        }
+    }
+
+    /* A command without information text can't be told apart from a reply
+     * we failed to attribute, so don't guess */
+    for (i = 0; i < n_commands; i++) {
+        if (!slices[i])
+            goto out;
+    }
+
+    split = g_new0 (gchar *, n_commands + 1);
+    for (i = 0; i < n_commands; i++) {
+        split[i] = g_string_free (slices[i], FALSE);
+        slices[i] = NULL;
+    }
+
+out:
+    for (i = 0; i < n_commands; i++) {
+        if (slices[i])
+            g_string_free (slices[i], TRUE);
+    }
+    g_free (slices);
+    return split;
+}
+
+/*****************************************************************************/
+/* 3GPP TS 27.007 list tokenizer */
+
+static inline const gchar *
+at_list_skip_blanks (const gchar *p,
+                     const gchar *end)
+{
+    /* Besides whitespace, stray closing parentheses are skipped as well, as
+     * some modems (e.g. Sony-Ericsson TM-506) include unbalanced ones:
+     *
+     *   +COPS: (2,"","T-Mobile","31026",0),(1,"AT&T","AT&T","310410"),0)
+     */
+    while (p < end && (g_ascii_isspace (*p) || *p == ')'))
+        p++;
+    return p;
+}
+
+static const gchar *
+at_list_find_group_end (const gchar *p,
+                        const gchar *end)
+{
+    guint    depth = 0;
+    gboolean quoted = FALSE;
+
+    for (; p < end; p++) {
+        if (*p == '"')
+            quoted = !quoted;
+        else if (quoted)
+            continue;
+        else if (*p == '(')
+            depth++;
+        else if (*p == ')') {
+            if (!depth)
+                return p;
+            depth--;
+        }
+    }
+
+    /* Unterminated group, take everything until the end */
+    return end;
+}
+
+void
+mm_at_list_iter_init (MMAtListIter *iter,
+                      const gchar  *str,
+                      gssize        len)
+{
+    g_assert (iter);
+
+    if (!str) {
+        str = "";
+        len = 0;
+    } else if (len < 0)
+        len = strlen (str);
+
+    iter->p = str;
+    iter->end = str + len;
+    iter->after_separator = FALSE;
+}
+
+void
+mm_at_list_iter_init_group (MMAtListIter       *iter,
+                            const MMAtListItem *group)
+{
+    g_assert (group->type == MM_AT_LIST_ITEM_GROUP);
+
+    mm_at_list_iter_init (iter, group->str, group->len);
+}
+
+gboolean
+mm_at_list_iter_next (MMAtListIter *iter,
+                      MMAtListItem *item)
+{
+    const gchar *p;
+    const gchar *item_end;
+
+    p = at_list_skip_blanks (iter->p, iter->end);
+
+    if (p == iter->end) {
+        iter->p = p;
+        /* A trailing separator still delimits one last empty item */
+        if (!iter->after_separator)
+            return FALSE;
+        iter->after_separator = FALSE;
+        item->type = MM_AT_LIST_ITEM_EMPTY;
+        item->str = p;
+        item->len = 0;
+        return TRUE;
+    }
+
+    switch (*p) {
+    case ',':
+        item->type = MM_AT_LIST_ITEM_EMPTY;
+        item->str = p;
+        item->len = 0;
+        break;
+    case '(':
+        item_end = at_list_find_group_end (p + 1, iter->end);
+        item->type = MM_AT_LIST_ITEM_GROUP;
+        item->str = p + 1;
+        item->len = item_end - item->str;
+        p = (item_end < iter->end) ? item_end + 1 : item_end;
+        break;
+    case '"':
+        item_end = memchr (p + 1, '"', iter->end - p - 1);
+        if (!item_end)
+            item_end = iter->end;
+        item->type = MM_AT_LIST_ITEM_STRING;
+        item->str = p + 1;
+        item->len = item_end - item->str;
+        p = (item_end < iter->end) ? item_end + 1 : item_end;
+        break;
+    default:
+        item->type = MM_AT_LIST_ITEM_TOKEN;
+        item->str = p;
+        while (p < iter->end && *p != ',' && *p != '(' && *p != ')')
+            p++;
+        item_end = p;
+        while (item_end > item->str && g_ascii_isspace (item_end[-1]))
+            item_end--;
+        item->len = item_end - item->str;
+        break;
+    }
+
+    /* Items are expected to be comma-separated, but adjacent ones are also
+     * accepted, e.g. two groups without separator in between, or a line break
+     * followed by a new response tag. */
+    p = at_list_skip_blanks (p, iter->end);
+    iter->after_separator = (p < iter->end && *p == ',');
+    if (iter->after_separator)
+        p++;
+    iter->p = p;
+    return TRUE;
+}
+
+gboolean
+mm_at_list_item_equal (const MMAtListItem *item,
+                       const gchar        *str)
+{
+    return (strlen (str) == item->len && !memcmp (item->str, str, item->len));
+}
+
+/* Value of a token or quoted string, without surrounding whitespace */
+static gboolean
+at_list_item_get_value (const MMAtListItem  *item,
+                        const gchar        **out_str,
+                        gsize               *out_len)
+{
+    const gchar *str;
+    gsize        len;
+
+    if (item->type != MM_AT_LIST_ITEM_TOKEN && item->type != MM_AT_LIST_ITEM_STRING)
+        return FALSE;
+
+    str = item->str;
+    len = item->len;
+    while (len && g_ascii_isspace (str[0])) {
+        str++;
+        len--;
+    }
+    while (len && g_ascii_isspace (str[len - 1]))
+        len--;
+
+    *out_str = str;
+    *out_len = len;
+    return TRUE;
+}
+
+static gboolean
+at_list_parse_uint (const gchar *str,
+                    gsize        len,
+                    guint       *out)
+{
+    guint64 num = 0;
+    gsize   i;
+
+    if (!len)
+        return FALSE;
+
+    for (i = 0; i < len; i++) {
+        if (!g_ascii_isdigit (str[i]))
+            return FALSE;
+        num = (num * 10) + (str[i] - '0');
+        if (num > G_MAXUINT)
+            return FALSE;
+    }
+
+    *out = (guint) num;
+    return TRUE;
+}
+
+gboolean
+mm_at_list_item_get_uint (const MMAtListItem *item,
+                          guint              *out)
+{
+    const gchar *str;
+    gsize        len;
+
+    return (at_list_item_get_value (item, &str, &len) &&
+            at_list_parse_uint (str, len, out));
+}
+
+gboolean
+mm_at_list_item_get_uint_range (const MMAtListItem *item,
+                                guint              *out_min,
+                                guint              *out_max)
+{
+    const gchar *str;
+    const gchar *dash;
+    gsize        len;
+    guint        min;
+    guint        max;
+
+    if (!at_list_item_get_value (item, &str, &len))
+        return FALSE;
+
+    /* Either a single number, or an interval like 1-6 */
+    dash = memchr (str, '-', len);
+    if (!dash) {
+        if (!at_list_parse_uint (str, len, &min))
+            return FALSE;
+        max = min;
+    } else {
+        const gchar *max_str = dash + 1;
+        gsize        max_len = len - (max_str - str);
+        gsize        min_len = dash - str;
+
+        while (min_len && g_ascii_isspace (str[min_len - 1]))
+            min_len--;
+        while (max_len && g_ascii_isspace (max_str[0])) {
+            max_str++;
+            max_len--;
+        }
+        if (!at_list_parse_uint (str, min_len, &min) ||
+            !at_list_parse_uint (max_str, max_len, &max))
+            return FALSE;
+    }
+
+    if (out_min)
+        *out_min = min;
+    if (out_max)
+        *out_max = max;
+    return TRUE;
+}
+
+gchar *
+mm_at_list_item_dup_string (const MMAtListItem *item)
+{
+    const gchar *str;
+    gsize        len;
+
+    if (!at_list_item_get_value (item, &str, &len) || !len)
+        return NULL;
+
+    return g_strndup (str, len);
+}
+
 /*****************************************************************************/
 
 gchar **
 mm_split_string_groups (const gchar *str)
 {
-    GPtrArray *array;
-    const gchar *start;
-    const gchar *next;
+    GPtrArray    *array;
+    MMAtListIter  iter;
+    MMAtListItem  item;
+
+    if (!str)
+        return NULL;
 
     array = g_ptr_array_new ();
 
     /*
-     * Manually parse splitting groups. Groups may be single elements, or otherwise
-     * lists given between parenthesis, e.g.:
+     * Groups may be single elements, or otherwise lists given between
+     * parenthesis, e.g.:
      *
      *    ("SM","ME"),("SM","ME"),("SM","ME")
      *    "SM","SM","SM"
      *    "SM",("SM","ME"),("SM","ME")
+     *
+     * Group contents are returned without the enclosing parenthesis; single
+     * elements are returned as given, quotes included.
      */
-
-    /* Iterate string splitting groups */
-    for (start = str; start; start = next) {
-        gchar *item;
-        gssize len = -1;
-
-        /* skip leading whitespaces */
-        while (*start == ' ')
-            start++;
-
-        if (*start == '(') {
-            start++;
-            next = strchr (start, ')');
-            if (next) {
-                len = next - start;
-                next = strchr (next, ',');
-                if (next)
-                    next++;
-            }
-        } else {
-            next = strchr (start, ',');
-            if (next) {
-                len = next - start;
-                next++;
-            }
-        }
-
-        if (len < 0)
-            item = g_strdup (start);
+    mm_at_list_iter_init (&iter, str, -1);
+    while (mm_at_list_iter_next (&iter, &item)) {
+        if (item.type == MM_AT_LIST_ITEM_STRING)
+            g_ptr_array_add (array, g_strdup_printf ("\"%.*s\"", (gint) item.len, item.str));
         else
-            item = g_strndup (start, len);
-
-        g_ptr_array_add (array, item);
+            g_ptr_array_add (array, g_strndup (item.str, item.len));
     }
 
-    if (array->len > 0) {
-        g_ptr_array_add (array, NULL);
-        return (gchar **) g_ptr_array_free (array, FALSE);
-    }
+    /* An empty string is still one empty group */
+    if (!array->len)
+        g_ptr_array_add (array, g_strdup (""));
 
-    g_ptr_array_unref (array);
-    return NULL;
+    g_ptr_array_add (array, NULL);
+    return (gchar **) g_ptr_array_free (array, FALSE);
 }
 
 /*****************************************************************************/
@@ -143,10 +552,9 @@ GArray *
 mm_parse_uint_list (const gchar  *str,
                     GError      **error)
 {
-    GArray *array;
-    gchar  *dupstr;
-    gchar  *aux;
-    GError *inner_error = NULL;
+    GArray       *array;
+    MMAtListIter  iter;
+    MMAtListItem  item;
 
     if (!str || !str[0])
         return NULL;
@@ -158,76 +566,39 @@ mm_parse_uint_list (const gchar  *str,
      *   1,2,4-6  --> 1,2,4,5,6
      */
     array = g_array_new (FALSE, FALSE, sizeof (guint));
-    aux = dupstr = g_strdup (str);
 
-    while (aux) {
-        gchar *next;
-        gchar *interval;
+    mm_at_list_iter_init (&iter, str, -1);
+    while (mm_at_list_iter_next (&iter, &item)) {
+        guint start = 0;
+        guint stop = 0;
 
-        next = strchr (aux, ',');
-        if (next) {
-            *next = '\0';
-            next++;
+        if (item.type != MM_AT_LIST_ITEM_TOKEN ||
+            !mm_at_list_item_get_uint_range (&item, &start, &stop)) {
+            g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                         "couldn't parse integer or interval: '%.*s'", (gint) item.len, item.str);
+            g_array_unref (array);
+            return NULL;
         }
 
-        interval = strchr (aux, '-');
-        if (interval) {
-            guint start = 0;
-            guint stop = 0;
-
-            *interval = '\0';
-            interval++;
-
-            if (!mm_get_uint_from_str (aux, &start)) {
-                inner_error = g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                                           "couldn't parse interval start integer: '%s'", aux);
-                goto out;
-            }
-            if (!mm_get_uint_from_str (interval, &stop)) {
-                inner_error = g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                                           "couldn't parse interval stop integer: '%s'", interval);
-                goto out;
-            }
-
-            if (start > stop) {
-                inner_error = g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                                           "interval start (%u) cannot be bigger than interval stop (%u)", start, stop);
-                goto out;
-            }
-
-            for (; start <= stop; start++)
-                g_array_append_val (array, start);
-        } else {
-            guint num;
-
-            if (!mm_get_uint_from_str (aux, &num)) {
-                inner_error = g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                                           "couldn't parse integer: '%s'", aux);
-                goto out;
-            }
-
-            g_array_append_val (array, num);
+        if (start > stop) {
+            g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                         "interval start (%u) cannot be bigger than interval stop (%u)", start, stop);
+            g_array_unref (array);
+            return NULL;
         }
 
-        aux = next;
+        for (; start <= stop; start++)
+            g_array_append_val (array, start);
     }
 
-    if (!array->len)
-        inner_error = g_error_new (MM_CORE_ERROR,
-                                   MM_CORE_ERROR_FAILED,
-                                   "couldn't parse list of integers: '%s'", str);
-    else
-        g_array_sort (array, uint_compare_func);
-
-out:
-    g_free (dupstr);
-
-    if (inner_error) {
-        g_propagate_error (error, inner_error);
+    if (!array->len) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                     "couldn't parse list of integers: '%s'", str);
         g_array_unref (array);
         return NULL;
     }
 
+    g_array_sort (array, uint_compare_func);
     return array;
 }
 
@@ -460,10 +831,9 @@ mm_voice_ring_regex_get (void)
     /* Example:
      * <CR><LF>RING<CR><LF>
      */
-    return g_regex_new ("\\r\\nRING(?:\\r)?\\r\\n",
-                        G_REGEX_RAW | G_REGEX_OPTIMIZE,
-                        0,
-                        NULL);
+    return mm_regex_cache_get ("\\r\\nRING(?:\\r)?\\r\\n",
+                               G_REGEX_RAW | G_REGEX_OPTIMIZE,
+                               0);
 }
 
 GRegex *
@@ -473,10 +843,9 @@ mm_voice_cring_regex_get (void)
      * <CR><LF>+CRING: VOICE<CR><LF>
      * <CR><LF>+CRING: DATA<CR><LF>
      */
-    return g_regex_new ("\\r\\n\\+CRING:\\s*(\\S+)\\r\\n",
-                        G_REGEX_RAW | G_REGEX_OPTIMIZE,
-                        0,
-                        NULL);
+    return mm_regex_cache_get ("\\r\\n\\+CRING:\\s*(\\S+)\\r\\n",
+                               G_REGEX_RAW | G_REGEX_OPTIMIZE,
+                               0);
 }
 
 GRegex *
@@ -490,10 +859,9 @@ mm_voice_clip_regex_get (void)
      *   <CR><LF>+CLIP: "+393351391306",145,,,,0<CR><LF>
      *                   \_ Number      \_ Type
      */
-    return g_regex_new ("\\r\\n\\+CLIP:\\s*([^,\\s]*)\\s*,\\s*(\\d+)\\s*,?(.*)\\r\\n",
-                        G_REGEX_RAW | G_REGEX_OPTIMIZE,
-                        0,
-                        NULL);
+    return mm_regex_cache_get ("\\r\\n\\+CLIP:\\s*([^,\\s]*)\\s*,\\s*(\\d+)\\s*,?(.*)\\r\\n",
+                               G_REGEX_RAW | G_REGEX_OPTIMIZE,
+                               0);
 }
 
 GRegex *
@@ -507,10 +875,9 @@ mm_voice_ccwa_regex_get (void)
      *   <CR><LF>+CCWA: "+393351391306",145,1
      *                   \_ Number      \_ Type
      */
-    return g_regex_new ("\\r\\n\\+CCWA:\\s*([^,\\s]*)\\s*,\\s*(\\d+)\\s*,\\s*(\\d+)\\s*,?(.*)\\r\\n",
-                        G_REGEX_RAW | G_REGEX_OPTIMIZE,
-                        0,
-                        NULL);
+    return mm_regex_cache_get ("\\r\\n\\+CCWA:\\s*([^,\\s]*)\\s*,\\s*(\\d+)\\s*,\\s*(\\d+)\\s*,?(.*)\\r\\n",
+                               G_REGEX_RAW | G_REGEX_OPTIMIZE,
+                               0);
 }
 
 static void
@@ -565,15 +932,14 @@ mm_3gpp_parse_clcc_response (const gchar  *str,
      *  ...
      */
 
-    r = g_regex_new ("\\+CLCC:\\s*(\\d+),\\s*(\\d+),\\s*(\\d+),\\s*(\\d+),\\s*(\\d+)" /* mandatory fields */
-                     "(?:,\\s*([^,]*),\\s*(\\d+)"                                     /* number and type */
-                     "(?:,\\s*([^,]*)"                                                /* alpha */
-                     "(?:,\\s*(\\d*)"                                                 /* priority */
-                     "(?:,\\s*(\\d*)"                                                 /* CLI validity */
-                     ")?)?)?)?$",
-                     G_REGEX_RAW | G_REGEX_MULTILINE | G_REGEX_NEWLINE_CRLF,
-                     G_REGEX_MATCH_NEWLINE_CRLF,
-                     NULL);
+    r = mm_regex_cache_get ("\\+CLCC:\\s*(\\d+),\\s*(\\d+),\\s*(\\d+),\\s*(\\d+),\\s*(\\d+)" /* mandatory fields */
+                            "(?:,\\s*([^,]*),\\s*(\\d+)"                                     /* number and type */
+                            "(?:,\\s*([^,]*)"                                                /* alpha */
+                            "(?:,\\s*(\\d*)"                                                 /* priority */
+                            "(?:,\\s*(\\d*)"                                                 /* CLI validity */
+                            ")?)?)?)?$",
+                            G_REGEX_RAW | G_REGEX_MULTILINE | G_REGEX_NEWLINE_CRLF,
+                            G_REGEX_MATCH_NEWLINE_CRLF);
     g_assert (r != NULL);
 
     g_regex_match_full (r, str, strlen (str), 0, 0, &match_info, &inner_error);
@@ -740,7 +1106,7 @@ mm_parse_ifc_test_response (const gchar  *response,
     MMFlowControl          ta_mask     = MM_FLOW_CONTROL_UNKNOWN;
     MMFlowControl          mask        = MM_FLOW_CONTROL_UNKNOWN;
 
-    r = g_regex_new ("(?:\\+IFC:)?\\s*\\((.*)\\),\\((.*)\\)(?:\\r\\n)?", 0, 0, NULL);
+    r = mm_regex_cache_get ("(?:\\+IFC:)?\\s*\\((.*)\\),\\((.*)\\)(?:\\r\\n)?", 0, 0);
     g_assert (r != NULL);
 
     g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
@@ -867,12 +1233,11 @@ mm_3gpp_creg_regex_get (gboolean solicited)
 
         if (solicited) {
             pattern = g_strdup_printf ("%s$", creg_regex[i]);
-            regex = g_regex_new (pattern, G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
+            regex = mm_regex_cache_get (pattern, G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
         } else {
             pattern = g_strdup_printf ("\\r\\n%s\\r\\n", creg_regex[i]);
-            regex = g_regex_new (pattern, G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
+            regex = mm_regex_cache_get (pattern, G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
         }
-        g_assert (regex);
         g_ptr_array_add (array, regex);
     }
     return array;
@@ -890,10 +1255,9 @@ mm_3gpp_creg_regex_destroy (GPtrArray *array)
 GRegex *
 mm_3gpp_ciev_regex_get (void)
 {
-    return g_regex_new ("\\r\\n\\+CIEV: (.*),(\\d)\\r\\n",
-                        G_REGEX_RAW | G_REGEX_OPTIMIZE,
-                        0,
-                        NULL);
+    return mm_regex_cache_get ("\\r\\n\\+CIEV: (.*),(\\d)\\r\\n",
+                               G_REGEX_RAW | G_REGEX_OPTIMIZE,
+                               0);
 }
 
 /*************************************************************************/
@@ -901,10 +1265,9 @@ mm_3gpp_ciev_regex_get (void)
 GRegex *
 mm_3gpp_cgev_regex_get (void)
 {
-    return g_regex_new ("\\r\\n\\+CGEV:\\s*(.*)\\r\\n",
-                        G_REGEX_RAW | G_REGEX_OPTIMIZE,
-                        0,
-                        NULL);
+    return mm_regex_cache_get ("\\r\\n\\+CGEV:\\s*(.*)\\r\\n",
+                               G_REGEX_RAW | G_REGEX_OPTIMIZE,
+                               0);
 }
 
 /*************************************************************************/
@@ -912,10 +1275,9 @@ mm_3gpp_cgev_regex_get (void)
 GRegex *
 mm_3gpp_cusd_regex_get (void)
 {
-    return g_regex_new ("\\r\\n\\+CUSD:\\s*(.*)\\r\\n",
-                        G_REGEX_RAW | G_REGEX_OPTIMIZE,
-                        0,
-                        NULL);
+    return mm_regex_cache_get ("\\r\\n\\+CUSD:\\s*(.*)\\r\\n",
+                               G_REGEX_RAW | G_REGEX_OPTIMIZE,
+                               0);
 }
 
 /*************************************************************************/
@@ -923,10 +1285,9 @@ mm_3gpp_cusd_regex_get (void)
 GRegex *
 mm_3gpp_cmti_regex_get (void)
 {
-    return g_regex_new ("\\r\\n\\+CMTI:\\s*\"(\\S+)\",\\s*(\\d+)\\r\\n",
-                        G_REGEX_RAW | G_REGEX_OPTIMIZE,
-                        0,
-                        NULL);
+    return mm_regex_cache_get ("\\r\\n\\+CMTI:\\s*\"(\\S+)\",\\s*(\\d+)\\r\\n",
+                               G_REGEX_RAW | G_REGEX_OPTIMIZE,
+                               0);
 }
 
 GRegex *
@@ -935,10 +1296,9 @@ mm_3gpp_cds_regex_get (void)
     /* Example:
      * <CR><LF>+CDS: 24<CR><LF>07914356060013F10659098136395339F6219011707193802190117071938030<CR><LF>
      */
-    return g_regex_new ("\\r\\n\\+CDS:\\s*(\\d+)\\r\\n(.*)\\r\\n",
-                        G_REGEX_RAW | G_REGEX_OPTIMIZE,
-                        0,
-                        NULL);
+    return mm_regex_cache_get ("\\r\\n\\+CDS:\\s*(\\d+)\\r\\n(.*)\\r\\n",
+                               G_REGEX_RAW | G_REGEX_OPTIMIZE,
+                               0);
 }
 
 /*************************************************************************/
@@ -1015,7 +1375,7 @@ mm_3gpp_parse_ws46_test_response (const gchar  *response,
     gboolean               supported_mode_25 = FALSE;
     gboolean               supported_mode_29 = FALSE;
 
-    r = g_regex_new ("(?:\\+WS46:)?\\s*\\((.*)\\)(?:\\r\\n)?", 0, 0, NULL);
+    r = mm_regex_cache_get ("(?:\\+WS46:)?\\s*\\((.*)\\)(?:\\r\\n)?", 0, 0);
     g_assert (r != NULL);
 
     g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
@@ -1198,108 +1558,116 @@ get_mm_access_tech_from_etsi_access_tech (guint    val,
     return MM_MODEM_ACCESS_TECHNOLOGY_UNKNOWN;
 }
 
-GList *
-mm_3gpp_parse_cops_test_response (const gchar     *reply,
-                                  MMModemCharset   cur_charset,
-                                  gpointer         log_object,
-                                  GError         **error)
-{
-    g_autoptr(GRegex)      r = NULL;
-    g_autoptr(GMatchInfo)  match_info = NULL;
-    GList                 *info_list = NULL;
-    gboolean               umts_format = TRUE;
+/* Fields of one (<stat>,<long>,<short>,<numeric>[,<AcT>]) group */
+typedef struct {
+    guint        status;
+    MMAtListItem operator_long;
+    MMAtListItem operator_short;
+    MMAtListItem operator_code;
+    guint        act;
+} CopsEntry;
 
-    g_return_val_if_fail (reply != NULL, NULL);
-    if (error)
-        g_return_val_if_fail (*error == NULL, NULL);
+static gboolean
+cops_entry_parse (const MMAtListItem *group,
+                  const MMAtListItem *next,
+                  gboolean            umts_format,
+                  CopsEntry          *entry)
+{
+    MMAtListIter iter;
+    MMAtListItem fields[5];
+    MMAtListItem extra;
+    guint        n_fields = 0;
+    guint        i;
+
+    mm_at_list_iter_init_group (&iter, group);
+    while (n_fields < G_N_ELEMENTS (fields) && mm_at_list_iter_next (&iter, &fields[n_fields]))
+        n_fields++;
+    if (n_fields < 4 || mm_at_list_iter_next (&iter, &extra))
+        return FALSE;
 
-    if (!strstr (reply, "+COPS: ")) {
-        g_set_error_literal (error,
-                             MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                             "Could not parse scan results.");
-        return NULL;
+    if (!mm_at_list_item_get_uint (&fields[0], &entry->status))
+        return FALSE;
+    for (i = 1; i < 4; i++) {
+        if (fields[i].type == MM_AT_LIST_ITEM_GROUP)
+            return FALSE;
     }
+    entry->operator_long = fields[1];
+    entry->operator_short = fields[2];
+    entry->operator_code = fields[3];
 
-    reply = strstr (reply, "+COPS: ") + 7;
+    /* Pre-UMTS format doesn't include the cell access technology after
+     * the numeric operator element. */
+    if (!umts_format)
+        return (n_fields == 4);
 
-    /* Cell access technology (GSM, UTRAN, etc) got added later and not all
-     * modems implement it.  Some modesm have quirks that make it hard to
-     * use one regular experession for matching both pre-UMTS and UMTS
-     * responses.  So try UMTS-format first and fall back to pre-UMTS if
-     * we get no UMTS-formst matches.
-     */
+    /* The UMTS format always gives the long operator name quoted */
+    if (entry->operator_long.type != MM_AT_LIST_ITEM_STRING)
+        return FALSE;
+
+    if (n_fields == 5)
+        return mm_at_list_item_get_uint (&fields[4], &entry->act);
 
-    /* Quirk: Sony-Ericsson TM-506 sometimes includes a stray ')' like so,
-     *        which is what makes it hard to match both pre-UMTS and UMTS in
-     *        the same regex:
+    /* Quirk: Sony-Ericsson TM-506 sometimes includes a stray ')' before the
+     * access technology, which therefore ends up out of the group:
      *
      *       +COPS: (2,"","T-Mobile","31026",0),(1,"AT&T","AT&T","310410"),0)
      */
+    return (next &&
+            next->type == MM_AT_LIST_ITEM_TOKEN &&
+            mm_at_list_item_get_uint (next, &entry->act));
+}
 
-    r = g_regex_new ("\\((\\d),\"([^\"\\)]*)\",([^,\\)]*),([^,\\)]*)[\\)]?,(\\d+)\\)", G_REGEX_UNGREEDY, 0, NULL);
-    g_assert (r);
-
-    /* If we didn't get any hits, try the pre-UMTS format match */
-    if (!g_regex_match (r, reply, 0, &match_info)) {
-        g_clear_pointer (&r, g_regex_unref);
-        g_clear_pointer (&match_info, g_match_info_free);
-
-        /* Pre-UMTS format doesn't include the cell access technology after
-         * the numeric operator element.
-         *
-         * Ex: Motorola C-series (BUSlink SCWi275u) like so:
-         *
-         *       +COPS: (2,"T-Mobile","","310260"),(0,"Cingular Wireless","","310410")
-         */
-
-        /* Quirk: Some Nokia phones (N80) don't send the quotes for empty values:
-         *
-         *       +COPS: (2,"T - Mobile",,"31026"),(1,"Einstein PCS",,"31064"),(1,"Cingular",,"31041"),,(0,1,3),(0,2)
-         */
-
-        r = g_regex_new ("\\((\\d),([^,\\)]*),([^,\\)]*),([^\\)]*)\\)", G_REGEX_UNGREEDY, 0, NULL);
-        g_assert (r);
+static GList *
+cops_parse_entries (const gchar    *reply,
+                    gboolean        umts_format,
+                    MMModemCharset  cur_charset,
+                    gpointer        log_object,
+                    guint          *n_entries)
+{
+    GList        *info_list = NULL;
+    MMAtListIter  iter;
+    MMAtListItem  item;
+    MMAtListItem  next = { 0 };
+    gboolean      has_item;
+    gboolean      has_next;
 
-        g_regex_match (r, reply, 0, &match_info);
-        umts_format = FALSE;
-    }
+    *n_entries = 0;
 
-    /* Parse the results */
-    while (g_match_info_matches (match_info)) {
+    mm_at_list_iter_init (&iter, reply, -1);
+    for (has_item = mm_at_list_iter_next (&iter, &item); has_item; has_item = has_next, item = next) {
         MM3gppNetworkInfo *info;
-        guint              net_value = 0;
+        CopsEntry          entry;
         gboolean           valid = FALSE;
 
-        info = g_new0 (MM3gppNetworkInfo, 1);
+        has_next = mm_at_list_iter_next (&iter, &next);
+
+        if (item.type != MM_AT_LIST_ITEM_GROUP ||
+            !cops_entry_parse (&item, has_next ? &next : NULL, umts_format, &entry))
+            continue;
 
-        /* the regex makes sure this is a number, it won't fail */
-        mm_get_uint_from_match_info (match_info, 1, &net_value);
-        info->status = get_mm_network_availability_from_3gpp_network_availability (net_value, log_object);
+        (*n_entries)++;
 
-        info->operator_long = mm_get_string_unquoted_from_match_info (match_info, 2);
-        info->operator_short = mm_get_string_unquoted_from_match_info (match_info, 3);
-        info->operator_code = mm_get_string_unquoted_from_match_info (match_info, 4);
+        info = g_new0 (MM3gppNetworkInfo, 1);
+        info->status = get_mm_network_availability_from_3gpp_network_availability (entry.status, log_object);
+        info->operator_long = mm_at_list_item_dup_string (&entry.operator_long);
+        info->operator_short = mm_at_list_item_dup_string (&entry.operator_short);
+        info->operator_code = mm_at_list_item_dup_string (&entry.operator_code);
 
         /* The returned strings may be given in e.g. UCS2 */
         mm_3gpp_normalize_operator (&info->operator_long,  cur_charset, log_object);
         mm_3gpp_normalize_operator (&info->operator_short, cur_charset, log_object);
         mm_3gpp_normalize_operator (&info->operator_code,  cur_charset, log_object);
 
-        /* Only try for access technology with UMTS-format matches.
+        /* Only try for access technology with UMTS-format entries.
          * If none give, assume GSM */
-        if (umts_format) {
-            guint act_value = 0;
-
-            /* the regex makes sure this is a number, it won't fail */
-            mm_get_uint_from_match_info (match_info, 5, &act_value);
-            info->access_tech = get_mm_access_tech_from_etsi_access_tech (act_value, log_object);
-        } else
+        if (umts_format)
+            info->access_tech = get_mm_access_tech_from_etsi_access_tech (entry.act, log_object);
+        else
             info->access_tech = MM_MODEM_ACCESS_TECHNOLOGY_GSM;
 
         /* If the operator number isn't valid (ie, at least 5 digits),
          * ignore the scan result; it's probably the parameter stuff at the
-         * end of the +COPS response.  The regex will sometimes catch this
-         * but there's no good way to ignore it.
+         * end of the +COPS response.
          */
         if (info->operator_code && (strlen (info->operator_code) >= 5)) {
             gchar *tmp;
@@ -1329,10 +1697,55 @@ mm_3gpp_parse_cops_test_response (const gchar     *reply,
         }
         else
             mm_3gpp_network_info_free (info);
+    }
 
-        g_match_info_next (match_info, NULL);
+    return info_list;
+}
+
+GList *
+mm_3gpp_parse_cops_test_response (const gchar     *reply,
+                                  MMModemCharset   cur_charset,
+                                  gpointer         log_object,
+                                  GError         **error)
+{
+    GList *info_list;
+    guint  n_entries;
+
+    g_return_val_if_fail (reply != NULL, NULL);
+    if (error)
+        g_return_val_if_fail (*error == NULL, NULL);
+
+    if (!strstr (reply, "+COPS: ")) {
+        g_set_error_literal (error,
+                             MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                             "Could not parse scan results.");
+        return NULL;
     }
 
+    reply = strstr (reply, "+COPS: ") + 7;
+
+    /* Cell access technology (GSM, UTRAN, etc) got added later and not all
+     * modems implement it.  So try UMTS-format first and fall back to
+     * pre-UMTS if we get no UMTS-format entries.
+     *
+     * Ex: Motorola C-series (BUSlink SCWi275u) like so:
+     *
+     *       +COPS: (2,"T-Mobile","","310260"),(0,"Cingular Wireless","","310410")
+     *
+     * Quirk: Some Nokia phones (N80) don't send the quotes for empty values:
+     *
+     *       +COPS: (2,"T - Mobile",,"31026"),(1,"Einstein PCS",,"31064"),(1,"Cingular",,"31041"),,(0,1,3),(0,2)
+     *
+     * Some modems send one +COPS line per operator; the additional response
+     * tags end up as tokens between groups, and are ignored.
+     */
+    info_list = cops_parse_entries (reply, TRUE, cur_charset, log_object, &n_entries);
+
+    /* Don't fall back to the pre-UMTS format if UMTS-format entries
+     * were found, even if none of them was valid */
+    if (!n_entries)
+        info_list = cops_parse_entries (reply, FALSE, cur_charset, log_object, &n_entries);
+
     return info_list;
 }
 
@@ -1363,7 +1776,7 @@ mm_3gpp_parse_cops_read_response (const gchar              *response,
      * or:
      *   +COPS: <mode>,<format>,<oper>,<AcT>
      */
-    r = g_regex_new ("\\+COPS:\\s*(\\d+),(\\d+),([^,]*)(?:,(\\d+))?(?:\\r\\n)?", 0, 0, NULL);
+    r = mm_regex_cache_get ("\\+COPS:\\s*(\\d+),(\\d+),([^,]*)(?:,(\\d+))?(?:\\r\\n)?", 0, 0);
     g_assert (r != NULL);
 
     g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
@@ -1742,10 +2155,9 @@ mm_3gpp_parse_cgdcont_test_response (const gchar  *response,
         return NULL;
     }
 
-    r = g_regex_new ("\\+CGDCONT:\\s*\\(\\s*(\\d+)\\s*-?\\s*(\\d+)?[^\\)]*\\)\\s*,\\s*\\(?\"(\\S+)\"",
-                     G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW,
-                     0, &inner_error);
-    g_assert (r != NULL);
+    r = mm_regex_cache_get ("\\+CGDCONT:\\s*\\(\\s*(\\d+)\\s*-?\\s*(\\d+)?[^\\)]*\\)\\s*,\\s*\\(?\"(\\S+)\"",
+                            G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW,
+                            0);
 
     g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
     while (!inner_error && g_match_info_matches (match_info)) {
@@ -1817,53 +2229,60 @@ GList *
 mm_3gpp_parse_cgdcont_read_response (const gchar *reply,
                                      GError **error)
 {
-    GError                *inner_error = NULL;
-    g_autoptr(GRegex)      r = NULL;
-    g_autoptr(GMatchInfo)  match_info = NULL;
-    GList                 *list = NULL;
+    const gchar *p;
+    GList       *list = NULL;
 
     if (!reply || !reply[0])
         /* No APNs configured, all done */
         return NULL;
 
-    r = g_regex_new ("\\+CGDCONT:\\s*(\\d+)\\s*,([^, \\)]*)\\s*,([^, \\)]*)\\s*,([^, \\)]*)",
-                     G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW,
-                     0, NULL);
-    g_assert (r);
+    /* One context per line, e.g.:
+     *
+     *    +CGDCONT: 1,"IP","nate.sktelecom.com","",0,0
+     */
+    for (p = strstr (reply, "+CGDCONT:"); p; p = strstr (p, "+CGDCONT:")) {
+        MMAtListIter      iter;
+        MMAtListItem      fields[4];
+        guint             n_fields = 0;
+        gsize             line_len;
+        g_autofree gchar *pdp_type_str = NULL;
+        MMBearerIpFamily  ip_family;
+        MM3gppPdpContext *pdp;
+
+        p += strlen ("+CGDCONT:");
+        line_len = strcspn (p, "\r\n");
+        mm_at_list_iter_init (&iter, p, line_len);
+        p += line_len;
+
+        while (n_fields < G_N_ELEMENTS (fields) && mm_at_list_iter_next (&iter, &fields[n_fields]))
+            n_fields++;
+        if (n_fields < G_N_ELEMENTS (fields) ||
+            fields[0].type != MM_AT_LIST_ITEM_TOKEN ||
+            fields[1].type == MM_AT_LIST_ITEM_GROUP ||
+            fields[2].type == MM_AT_LIST_ITEM_GROUP)
+            continue;
 
-    g_regex_match_full (r, reply, strlen (reply), 0, 0, &match_info, &inner_error);
-    while (!inner_error && g_match_info_matches (match_info)) {
-        gchar *str;
-        MMBearerIpFamily ip_family;
-
-        str = mm_get_string_unquoted_from_match_info (match_info, 2);
-        ip_family = mm_3gpp_get_ip_family_from_pdp_type (str);
-        if (ip_family != MM_BEARER_IP_FAMILY_NONE) {
-            MM3gppPdpContext *pdp;
-
-            pdp = g_slice_new0 (MM3gppPdpContext);
-            if (!mm_get_uint_from_match_info (match_info, 1, &pdp->cid)) {
-                inner_error = g_error_new (MM_CORE_ERROR,
-                                           MM_CORE_ERROR_FAILED,
-                                           "Couldn't parse CID from reply: '%s'",
-                                           reply);
-                break;
-            }
-            pdp->pdp_type = ip_family;
-            pdp->apn = mm_get_string_unquoted_from_match_info (match_info, 3);
+        pdp_type_str = mm_at_list_item_dup_string (&fields[1]);
+        ip_family = mm_3gpp_get_ip_family_from_pdp_type (pdp_type_str);
+        if (ip_family == MM_BEARER_IP_FAMILY_NONE)
+            continue;
 
-            list = g_list_prepend (list, pdp);
+        pdp = g_slice_new0 (MM3gppPdpContext);
+        if (!mm_at_list_item_get_uint (&fields[0], &pdp->cid)) {
+            g_slice_free (MM3gppPdpContext, pdp);
+            mm_3gpp_pdp_context_list_free (list);
+            g_set_error (error,
+                         MM_CORE_ERROR,
+                         MM_CORE_ERROR_FAILED,
+                         "Couldn't properly parse list of PDP contexts. "
+                         "Couldn't parse CID from reply: '%s'",
+                         reply);
+            return NULL;
         }
+        pdp->pdp_type = ip_family;
+        pdp->apn = mm_at_list_item_dup_string (&fields[2]);
 
-        g_free (str);
-        g_match_info_next (match_info, &inner_error);
-    }
-
-    if (inner_error) {
-        mm_3gpp_pdp_context_list_free (list);
-        g_propagate_error (error, inner_error);
-        g_prefix_error (error, "Couldn't properly parse list of PDP contexts. ");
-        return NULL;
+        list = g_list_prepend (list, pdp);
     }
 
     return g_list_sort (list, (GCompareFunc)mm_3gpp_pdp_context_cmp);
@@ -1903,9 +2322,8 @@ mm_3gpp_parse_cgact_read_response (const gchar *reply,
         /* Nothing configured, all done */
         return NULL;
 
-    r = g_regex_new ("\\+CGACT:\\s*(\\d+),(\\d+)",
-                     G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0, &inner_error);
-    g_assert (r);
+    r = mm_regex_cache_get ("\\+CGACT:\\s*(\\d+),(\\d+)",
+                            G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0);
 
     g_regex_match_full (r, reply, strlen (reply), 0, 0, &match_info, &inner_error);
     while (!inner_error && g_match_info_matches (match_info)) {
@@ -2146,9 +2564,7 @@ mm_3gpp_parse_cmgf_test_response (const gchar *reply,
     while (isspace (*reply))
         reply++;
 
-    r = g_regex_new ("\\(?\\s*(\\d+)\\s*[-,]?\\s*(\\d+)?\\s*\\)?", 0, 0, error);
-    if (!r)
-        return FALSE;
+    r = mm_regex_cache_get ("\\(?\\s*(\\d+)\\s*[-,]?\\s*(\\d+)?\\s*\\)?", 0, 0);
 
     if (!g_regex_match (r, reply, 0, &match_info)) {
         g_set_error (error,
@@ -2194,7 +2610,7 @@ mm_3gpp_parse_cmgr_read_response (const gchar *reply,
 
     /* +CMGR: <stat>,<alpha>,<length>(whitespace)<pdu> */
     /* The <alpha> and <length> fields are matched, but not currently used */
-    r = g_regex_new ("\\+CMGR:\\s*(\\d+)\\s*,([^,]*),\\s*(\\d+)\\s*([^\\r\\n]*)", 0, 0, NULL);
+    r = mm_regex_cache_get ("\\+CMGR:\\s*(\\d+)\\s*,([^,]*),\\s*(\\d+)\\s*([^\\r\\n]*)", 0, 0);
     g_assert (r);
 
     if (!g_regex_match (r, reply, 0, &match_info)) {
@@ -2270,8 +2686,8 @@ mm_3gpp_parse_crsm_response (const gchar *reply,
         return FALSE;
     }
 
-    r = g_regex_new ("\\+CRSM:\\s*(\\d+)\\s*,\\s*(\\d+)\\s*,\\s*\"?([0-9a-fA-F]+)\"?",
-                     G_REGEX_RAW, 0, NULL);
+    r = mm_regex_cache_get ("\\+CRSM:\\s*(\\d+)\\s*,\\s*(\\d+)\\s*,\\s*\"?([0-9a-fA-F]+)\"?",
+                            G_REGEX_RAW, 0);
     g_assert (r != NULL);
 
     if (g_regex_match (r, reply, 0, &match_info) &&
@@ -2382,16 +2798,16 @@ mm_3gpp_parse_cgcontrdp_response (const gchar  *response,
      * The format of the response changed in TS 27.007 v9.4.0, we try to detect
      * both formats ('a' if >= v9.4.0, 'b' if < v9.4.0) with a single regex here.
      */
-    r = g_regex_new ("\\+CGCONTRDP: "
-                     "(\\d+),(\\d+),([^,]*)" /* cid, bearer id, apn */
-                     "(?:,([^,]*))?" /* (a)ip+mask        or (b)ip */
-                     "(?:,([^,]*))?" /* (a)gateway        or (b)mask */
-                     "(?:,([^,]*))?" /* (a)dns1           or (b)gateway */
-                     "(?:,([^,]*))?" /* (a)dns2           or (b)dns1 */
-                     "(?:,([^,]*))?" /* (a)p-cscf primary or (b)dns2 */
-                     "(?:,(.*))?"    /* others, ignored */
-                     "(?:\\r\\n)?",
-                     0, 0, NULL);
+    r = mm_regex_cache_get ("\\+CGCONTRDP: "
+                            "(\\d+),(\\d+),([^,]*)" /* cid, bearer id, apn */
+                            "(?:,([^,]*))?" /* (a)ip+mask        or (b)ip */
+                            "(?:,([^,]*))?" /* (a)gateway        or (b)mask */
+                            "(?:,([^,]*))?" /* (a)dns1           or (b)gateway */
+                            "(?:,([^,]*))?" /* (a)dns2           or (b)dns1 */
+                            "(?:,([^,]*))?" /* (a)p-cscf primary or (b)dns2 */
+                            "(?:,(.*))?"    /* others, ignored */
+                            "(?:\\r\\n)?",
+                            0, 0);
     g_assert (r != NULL);
 
     g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
@@ -2478,7 +2894,7 @@ mm_3gpp_parse_cfun_query_response (const gchar  *response,
      * +CFUN: 1,0
      *   ..but we don't care about the second number
      */
-    r = g_regex_new ("\\+CFUN: (\\d+)(?:,(?:\\d+))?(?:\\r\\n)?", 0, 0, NULL);
+    r = mm_regex_cache_get ("\\+CFUN: (\\d+)(?:,(?:\\d+))?(?:\\r\\n)?", 0, 0);
     g_assert (r != NULL);
 
     g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
@@ -2542,7 +2958,7 @@ mm_3gpp_parse_cesq_response (const gchar  *response,
     /* Response may be e.g.:
      * +CESQ: 99,99,255,255,20,80
      */
-    r = g_regex_new ("\\+CESQ: (\\d+),(\\d+),(\\d+),(\\d+),(\\d+),(\\d+)(?:\\r\\n)?", 0, 0, NULL);
+    r = mm_regex_cache_get ("\\+CESQ: (\\d+),(\\d+),(\\d+),(\\d+),(\\d+),(\\d+)(?:\\r\\n)?", 0, 0);
     g_assert (r != NULL);
 
     g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
@@ -2847,10 +3263,9 @@ mm_3gpp_parse_ccwa_service_query_response (const gchar  *response,
      *
      * We're only interested in class 1 (voice)
      */
-    r = g_regex_new ("\\+CCWA:\\s*(\\d+),\\s*(\\d+)$",
-                     G_REGEX_RAW | G_REGEX_MULTILINE | G_REGEX_NEWLINE_CRLF,
-                     G_REGEX_MATCH_NEWLINE_CRLF,
-                     NULL);
+    r = mm_regex_cache_get ("\\+CCWA:\\s*(\\d+),\\s*(\\d+)$",
+                            G_REGEX_RAW | G_REGEX_MULTILINE | G_REGEX_NEWLINE_CRLF,
+                            G_REGEX_MATCH_NEWLINE_CRLF);
     g_assert (r != NULL);
 
     g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
@@ -2924,24 +3339,44 @@ mm_3gpp_build_cgatt_set_request (MMModem3gppPacketServiceState state)
 
 /*************************************************************************/
 
+static const struct {
+    const gchar  *str;
+    MMSmsStorage  storage;
+} storage_names[] = {
+    { "SM", MM_SMS_STORAGE_SM },
+    { "ME", MM_SMS_STORAGE_ME },
+    { "MT", MM_SMS_STORAGE_MT },
+    { "SR", MM_SMS_STORAGE_SR },
+    { "BM", MM_SMS_STORAGE_BM },
+    { "TA", MM_SMS_STORAGE_TA },
+};
+
 static MMSmsStorage
 storage_from_str (const gchar *str)
 {
-    if (g_str_equal (str, "SM"))
-        return MM_SMS_STORAGE_SM;
-    if (g_str_equal (str, "ME"))
-        return MM_SMS_STORAGE_ME;
-    if (g_str_equal (str, "MT"))
-        return MM_SMS_STORAGE_MT;
-    if (g_str_equal (str, "SR"))
-        return MM_SMS_STORAGE_SR;
-    if (g_str_equal (str, "BM"))
-        return MM_SMS_STORAGE_BM;
-    if (g_str_equal (str, "TA"))
-        return MM_SMS_STORAGE_TA;
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS (storage_names); i++) {
+        if (g_str_equal (str, storage_names[i].str))
+            return storage_names[i].storage;
+    }
     return MM_SMS_STORAGE_UNKNOWN;
 }
 
+static MMSmsStorage
+storage_from_item (const MMAtListItem *item)
+{
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS (storage_names); i++) {
+        if (mm_at_list_item_equal (item, storage_names[i].str))
+            return storage_names[i].storage;
+    }
+    return MM_SMS_STORAGE_UNKNOWN;
+}
+
+#define N_EXPECTED_GROUPS 3
+
 gboolean
 mm_3gpp_parse_cpms_test_response (const gchar  *reply,
                                   GArray      **mem1,
@@ -2949,88 +3384,70 @@ mm_3gpp_parse_cpms_test_response (const gchar  *reply,
                                   GArray      **mem3,
                                   GError      **error)
 {
-    guint i;
-    g_autoptr(GRegex) r = NULL;
-    g_autoptr(GArray) tmp1 = NULL;
-    g_autoptr(GArray) tmp2 = NULL;
-    g_autoptr(GArray) tmp3 = NULL;
-    g_auto(GStrv)     split = NULL;
+    MMAtListIter  iter;
+    MMAtListItem  item;
+    GArray       *tmp[N_EXPECTED_GROUPS] = { NULL, };
+    guint         n_groups = 0;
+    guint         i;
 
     g_assert (mem1 != NULL);
     g_assert (mem2 != NULL);
     g_assert (mem3 != NULL);
 
-#define N_EXPECTED_GROUPS 3
-
-    split = mm_split_string_groups (mm_strip_tag (reply, "+CPMS:"));
-    if (!split) {
-        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                     "Couldn't split +CPMS test response in groups");
-        return FALSE;
-    }
-
-    if (g_strv_length (split) != N_EXPECTED_GROUPS) {
-        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                     "Cannot parse +CPMS test response: invalid number of groups (%u != %u)",
-                     g_strv_length (split), N_EXPECTED_GROUPS);
-        return FALSE;
-    }
-
-    r = g_regex_new ("\\s*\"([^,\\)]+)\"\\s*", 0, 0, NULL);
-    g_assert (r);
-
-    for (i = 0; i < N_EXPECTED_GROUPS; i++) {
-        g_autoptr(GMatchInfo)  match_info = NULL;
-        GArray                *array;
+    /* Each group is either a list of quoted storages given between
+     * parenthesis, or a single quoted storage, e.g.:
+     *
+     *    ("ME","MT"),"ME",("SM")
+     */
+    mm_at_list_iter_init (&iter, mm_strip_tag (reply, "+CPMS:"), -1);
+    while (mm_at_list_iter_next (&iter, &item)) {
+        MMAtListIter  group_iter;
+        MMAtListItem  storage_item;
+        MMSmsStorage  storage;
+        GArray       *array;
+
+        /* Keep on counting, to report how many groups were found */
+        if (n_groups >= N_EXPECTED_GROUPS) {
+            n_groups++;
+            continue;
+        }
 
         /* We always return a valid array, even if it may be empty */
-        array = g_array_new (FALSE, FALSE, sizeof (MMSmsStorage));
-
-        /* Got a range group to match */
-        if (g_regex_match (r, split[i], 0, &match_info)) {
-            while (g_match_info_matches (match_info)) {
-                gchar *str;
-
-                str = g_match_info_fetch (match_info, 1);
-                if (str) {
-                    MMSmsStorage storage;
-
-                    storage = storage_from_str (str);
-                    g_array_append_val (array, storage);
-                    g_free (str);
-                }
-
-                g_match_info_next (match_info, NULL);
+        array = tmp[n_groups++] = g_array_new (FALSE, FALSE, sizeof (MMSmsStorage));
+
+        if (item.type == MM_AT_LIST_ITEM_STRING && item.len > 0) {
+            storage = storage_from_item (&item);
+            g_array_append_val (array, storage);
+        } else if (item.type == MM_AT_LIST_ITEM_GROUP) {
+            mm_at_list_iter_init_group (&group_iter, &item);
+            while (mm_at_list_iter_next (&group_iter, &storage_item)) {
+                if (storage_item.type != MM_AT_LIST_ITEM_STRING || !storage_item.len)
+                    continue;
+                storage = storage_from_item (&storage_item);
+                g_array_append_val (array, storage);
             }
         }
-
-        if (!tmp1)
-            tmp1 = array;
-        else if (!tmp2)
-            tmp2 = array;
-        else if (!tmp3)
-            tmp3 = array;
-        else
-            g_assert_not_reached ();
     }
 
-    /* Only return TRUE if all sets have been parsed correctly
-     * (even if the arrays may be empty) */
-    if (tmp1 && tmp2 && tmp3) {
-        *mem1 = g_steal_pointer (&tmp1);
-        *mem2 = g_steal_pointer (&tmp2);
-        *mem3 = g_steal_pointer (&tmp3);
-        return TRUE;
+    if (n_groups != N_EXPECTED_GROUPS) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                     "Cannot parse +CPMS test response: invalid number of groups (%u != %u)",
+                     n_groups, N_EXPECTED_GROUPS);
+        for (i = 0; i < N_EXPECTED_GROUPS; i++) {
+            if (tmp[i])
+                g_array_unref (tmp[i]);
+        }
+        return FALSE;
     }
 
-    g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                 "Cannot parse +CPMS test response: mem1 %s, mem2 %s, mem3 %s",
-                 tmp1 ? "yes" : "no",
-                 tmp2 ? "yes" : "no",
-                 tmp3 ? "yes" : "no");
-    return FALSE;
+    *mem1 = tmp[0];
+    *mem2 = tmp[1];
+    *mem3 = tmp[2];
+    return TRUE;
 }
 
+#undef N_EXPECTED_GROUPS
+
 /**********************************************************************
  * AT+CPMS?
  * +CPMS: <memr>,<usedr>,<totalr>,<memw>,<usedw>,<totalw>, <mems>,<useds>,<totals>
@@ -3047,7 +3464,7 @@ mm_3gpp_parse_cpms_query_response (const gchar *reply,
     g_autoptr(GRegex)     r = NULL;
     g_autoptr(GMatchInfo) match_info = NULL;
 
-    r = g_regex_new (CPMS_QUERY_REGEX, G_REGEX_RAW, 0, NULL);
+    r = mm_regex_cache_get (CPMS_QUERY_REGEX, G_REGEX_RAW, 0);
     g_assert (r);
 
     if (!g_regex_match (r, reply, 0, &match_info)) {
@@ -3126,7 +3543,7 @@ mm_3gpp_parse_cscs_test_response (const gchar *reply,
     }
 
     /* Now parse each charset */
-    r = g_regex_new ("\\s*([^,\\)]+)\\s*", 0, 0, NULL);
+    r = mm_regex_cache_get ("\\s*([^,\\)]+)\\s*", 0, 0);
     g_assert (r);
 
     if (g_regex_match (r, p, 0, &match_info)) {
@@ -3165,7 +3582,7 @@ mm_3gpp_parse_clck_test_response (const gchar *reply,
     reply = mm_strip_tag (reply, "+CLCK:");
 
     /* Now parse each facility */
-    r = g_regex_new ("\\s*\"([^,\\)]+)\"\\s*", 0, 0, NULL);
+    r = mm_regex_cache_get ("\\s*\"([^,\\)]+)\"\\s*", 0, 0);
     g_assert (r != NULL);
 
     *out_facilities = MM_MODEM_3GPP_FACILITY_NONE;
@@ -3200,7 +3617,7 @@ mm_3gpp_parse_clck_write_response (const gchar *reply,
 
     reply = mm_strip_tag (reply, "+CLCK:");
 
-    r = g_regex_new ("\\s*([01])\\s*", 0, 0, NULL);
+    r = mm_regex_cache_get ("\\s*([01])\\s*", 0, 0);
     g_assert (r != NULL);
 
     if (g_regex_match (r, reply, 0, &match_info)) {
@@ -3236,8 +3653,8 @@ mm_3gpp_parse_cnum_exec_response (const gchar *reply)
     if (!reply || !reply[0])
         return NULL;
 
-    r = g_regex_new ("\\+CNUM:\\s*((\"([^\"]|(\\\"))*\")|([^,]*)),\"(?<num>\\S+)\",\\d",
-                     G_REGEX_UNGREEDY, 0, NULL);
+    r = mm_regex_cache_get ("\\+CNUM:\\s*((\"([^\"]|(\\\"))*\")|([^,]*)),\"(?<num>\\S+)\",\\d",
+                            G_REGEX_UNGREEDY, 0);
     g_assert (r != NULL);
 
     array = g_ptr_array_new ();
@@ -3382,21 +3799,21 @@ struct MM3gppCindResponse {
 };
 
 static MM3gppCindResponse *
-cind_response_new (const gchar *desc, guint idx, gint min, gint max)
+cind_response_new (const gchar *desc, gsize desc_len, guint idx, gint min, gint max)
 {
     MM3gppCindResponse *r;
     gchar *p;
+    gsize i;
 
     g_return_val_if_fail (desc != NULL, NULL);
 
     r = g_malloc0 (sizeof (MM3gppCindResponse));
 
     /* Strip quotes */
-    r->desc = p = g_malloc0 (strlen (desc) + 1);
-    while (*desc) {
-        if (*desc != '"' && !isspace (*desc))
-            *p++ = tolower (*desc);
-        desc++;
+    r->desc = p = g_malloc0 (desc_len + 1);
+    for (i = 0; i < desc_len; i++) {
+        if (desc[i] != '"' && !isspace (desc[i]))
+            *p++ = tolower (desc[i]);
     }
 
     r->idx = idx;
@@ -3449,14 +3866,40 @@ mm_3gpp_cind_response_get_max (MM3gppCindResponse *r)
 
 #define CIND_TAG "+CIND:"
 
+/* Either (<min>-<max>) or (<min>,<max>[,...]) */
+static gboolean
+cind_range_parse (const MMAtListItem *range,
+                  gint               *out_min,
+                  gint               *out_max)
+{
+    MMAtListIter iter;
+    MMAtListItem item;
+    guint        min;
+    guint        max;
+
+    mm_at_list_iter_init_group (&iter, range);
+    if (!mm_at_list_iter_next (&iter, &item) ||
+        !mm_at_list_item_get_uint_range (&item, &min, &max))
+        return FALSE;
+
+    if (!memchr (item.str, '-', item.len) &&
+        (!mm_at_list_iter_next (&iter, &item) ||
+         !mm_at_list_item_get_uint_range (&item, &max, NULL)))
+        return FALSE;
+
+    *out_min = (gint) min;
+    *out_max = (gint) max;
+    return TRUE;
+}
+
 GHashTable *
 mm_3gpp_parse_cind_test_response (const gchar *reply,
                                   GError **error)
 {
-    g_autoptr(GRegex)      r = NULL;
-    g_autoptr(GMatchInfo)  match_info = NULL;
-    GHashTable            *hash;
-    guint                  idx = 1;
+    MMAtListIter  iter;
+    MMAtListItem  item;
+    GHashTable   *hash;
+    guint         idx = 1;
 
     g_return_val_if_fail (reply != NULL, NULL);
 
@@ -3466,35 +3909,32 @@ mm_3gpp_parse_cind_test_response (const gchar *reply,
     while (isspace (*reply))
         reply++;
 
-    r = g_regex_new ("\\(([^,]*),\\((\\d+)[-,](\\d+).*\\)", G_REGEX_UNGREEDY, 0, NULL);
-    g_assert (r);
-
     hash = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) cind_response_free);
 
-    if (g_regex_match (r, reply, 0, &match_info)) {
-        while (g_match_info_matches (match_info)) {
-            MM3gppCindResponse *resp;
-            gchar *desc, *tmp;
-            gint min = 0, max = 0;
-
-            desc = g_match_info_fetch (match_info, 1);
-
-            tmp = g_match_info_fetch (match_info, 2);
-            min = atoi (tmp);
-            g_free (tmp);
-
-            tmp = g_match_info_fetch (match_info, 3);
-            max = atoi (tmp);
-            g_free (tmp);
-
-            resp = cind_response_new (desc, idx++, min, max);
-            if (resp)
-                g_hash_table_insert (hash, g_strdup (resp->desc), resp);
+    /* E.g.: ("battchg",(0-5)),("signal",(0-5)),("service",(0,1)) */
+    mm_at_list_iter_init (&iter, reply, -1);
+    while (mm_at_list_iter_next (&iter, &item)) {
+        MM3gppCindResponse *resp;
+        MMAtListIter        group_iter;
+        MMAtListItem        desc;
+        MMAtListItem        range;
+        gint                min = 0;
+        gint                max = 0;
+
+        if (item.type != MM_AT_LIST_ITEM_GROUP)
+            continue;
 
-            g_free (desc);
+        mm_at_list_iter_init_group (&group_iter, &item);
+        if (!mm_at_list_iter_next (&group_iter, &desc) ||
+            desc.type == MM_AT_LIST_ITEM_GROUP ||
+            !mm_at_list_iter_next (&group_iter, &range) ||
+            range.type != MM_AT_LIST_ITEM_GROUP ||
+            !cind_range_parse (&range, &min, &max))
+            continue;
 
-            g_match_info_next (match_info, NULL);
-        }
+        resp = cind_response_new (desc.str, desc.len, idx++, min, max);
+        if (resp)
+            g_hash_table_insert (hash, g_strdup (resp->desc), resp);
     }
 
     return hash;
@@ -3523,7 +3963,7 @@ mm_3gpp_parse_cind_read_response (const gchar *reply,
 
     reply = mm_strip_tag (reply, CIND_TAG);
 
-    r = g_regex_new ("(\\d+)[^0-9]+", G_REGEX_UNGREEDY, 0, NULL);
+    r = mm_regex_cache_get ("(\\d+)[^0-9]+", G_REGEX_UNGREEDY, 0);
     g_assert (r != NULL);
 
     if (!g_regex_match (r, reply, 0, &match_info)) {
@@ -3675,11 +4115,11 @@ mm_3gpp_parse_cgev_indication_pdp (const gchar  *str,
               type == MM_3GPP_CGEV_NW_DEACT_PDP ||
               type == MM_3GPP_CGEV_ME_DEACT_PDP);
 
-    r = g_regex_new ("(?:"
-                     "REJECT|"
-                     "NW REACT|"
-                     "NW DEACT|ME DEACT"
-                     ")\\s*([^,]*),\\s*([^,]*)(?:,\\s*([0-9]+))?", 0, 0, NULL);
+    r = mm_regex_cache_get ("(?:"
+                            "REJECT|"
+                            "NW REACT|"
+                            "NW DEACT|ME DEACT"
+                            ")\\s*([^,]*),\\s*([^,]*)(?:,\\s*([0-9]+))?", 0, 0);
     g_assert (r);
 
     str = mm_strip_tag (str, "+CGEV:");
@@ -3750,10 +4190,10 @@ mm_3gpp_parse_cgev_indication_primary (const gchar  *str,
               (type == MM_3GPP_CGEV_NW_DEACT_PRIMARY) ||
               (type == MM_3GPP_CGEV_ME_DEACT_PRIMARY));
 
-    r = g_regex_new ("(?:"
-                     "NW PDN ACT|ME PDN ACT|"
-                     "NW PDN DEACT|ME PDN DEACT|"
-                     ")\\s*([0-9]+)", 0, 0, NULL);
+    r = mm_regex_cache_get ("(?:"
+                            "NW PDN ACT|ME PDN ACT|"
+                            "NW PDN DEACT|ME PDN DEACT|"
+                            ")\\s*([0-9]+)", 0, 0);
 
     str = mm_strip_tag (str, "+CGEV:");
     g_regex_match_full (r, str, strlen (str), 0, 0, &match_info, &inner_error);
@@ -3807,10 +4247,10 @@ mm_3gpp_parse_cgev_indication_secondary (const gchar  *str,
               type == MM_3GPP_CGEV_NW_DEACT_SECONDARY ||
               type == MM_3GPP_CGEV_ME_DEACT_SECONDARY);
 
-    r = g_regex_new ("(?:"
-                     "NW ACT|ME ACT|"
-                     "NW DEACT|ME DEACT"
-                     ")\\s*([0-9]+),\\s*([0-9]+),\\s*([0-9]+)", 0, 0, NULL);
+    r = mm_regex_cache_get ("(?:"
+                            "NW ACT|ME ACT|"
+                            "NW DEACT|ME DEACT"
+                            ")\\s*([0-9]+),\\s*([0-9]+),\\s*([0-9]+)", 0, 0);
 
     str = mm_strip_tag (str, "+CGEV:");
     g_regex_match_full (r, str, strlen (str), 0, 0, &match_info, &inner_error);
@@ -3883,8 +4323,8 @@ mm_3gpp_parse_pdu_cmgl_response (const gchar *str,
      *
      * We just read <index>, <stat> and the PDU itself.
      */
-    r = g_regex_new ("\\+CMGL:\\s*(\\d+)\\s*,\\s*(\\d+)\\s*,(.*)\\r\\n([^\\r\\n]*)(\\r\\n)?",
-                     G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
+    r = mm_regex_cache_get ("\\+CMGL:\\s*(\\d+)\\s*,\\s*(\\d+)\\s*,(.*)\\r\\n([^\\r\\n]*)(\\r\\n)?",
+                            G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
     g_assert (r != NULL);
 
     g_regex_match_full (r, str, strlen (str), 0, 0, &match_info, &inner_error);
@@ -4656,10 +5096,9 @@ mm_cdma_parse_crm_test_response (const gchar *reply,
      *   <--- +CRM: (0-2)
      */
 
-    r = g_regex_new ("\\+CRM:\\s*\\((\\d+)-(\\d+)\\)",
-                     G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW,
-                     0, error);
-    g_assert (r != NULL);
+    r = mm_regex_cache_get ("\\+CRM:\\s*\\((\\d+)-(\\d+)\\)",
+                            G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW,
+                            0);
 
     if (g_regex_match_full (r, reply, strlen (reply), 0, 0, &match_info, &match_error)) {
         gchar *aux;
@@ -4945,7 +5384,7 @@ mm_parse_cclk_response (const char *response,
      *  +CCLK: "15/03/05,14:14:26-32"
      *  +CCLK: 17/07/26,11:42:15+01
      */
-    r = g_regex_new ("\\+CCLK:\\s*\"?(\\d+)/(\\d+)/(\\d+),(\\d+):(\\d+):(\\d+)([-+]\\d+)?\"?", 0, 0, NULL);
+    r = mm_regex_cache_get ("\\+CCLK:\\s*\"?(\\d+)/(\\d+)/(\\d+),(\\d+):(\\d+):(\\d+)([-+]\\d+)?\"?", 0, 0);
     g_assert (r != NULL);
 
     if (!g_regex_match_full (r, response, -1, 0, 0, &match_info, &match_error)) {
@@ -5033,7 +5472,7 @@ mm_parse_csim_response (const gchar *response,
     guint                  hex_code;
     GError                *inner_error = NULL;
 
-    r = g_regex_new ("\\+CSIM:\\s*[0-9]+,\\s*\".*([0-9a-fA-F]{4})\"", G_REGEX_RAW, 0, NULL);
+    r = mm_regex_cache_get ("\\+CSIM:\\s*[0-9]+,\\s*\".*([0-9a-fA-F]{4})\"", G_REGEX_RAW, 0);
     g_regex_match (r, response, 0, &match_info);
 
     if (!g_match_info_matches (match_info)) {
@@ -5177,13 +5616,13 @@ mm_sim_parse_cpol_query_response (const gchar  *response,
     guint                  act = 0;
     guint                  match_count;
 
-    r = g_regex_new ("\\+CPOL:\\s*(\\d+),\\s*(\\d+),\\s*\"?(\\d+)\"?"
-                     "(?:,\\s*(\\d+))?"     /* GSM_AcTn */
-                     "(?:,\\s*(\\d+))?"     /* GSM_Compact_AcTn */
-                     "(?:,\\s*(\\d+))?"     /* UTRAN_AcTn */
-                     "(?:,\\s*(\\d+))?"     /* E-UTRAN_AcTn */
-                     "(?:,\\s*(\\d+))?",    /* NG-RAN_AcTn */
-                     G_REGEX_RAW, 0, NULL);
+    r = mm_regex_cache_get ("\\+CPOL:\\s*(\\d+),\\s*(\\d+),\\s*\"?(\\d+)\"?"
+                            "(?:,\\s*(\\d+))?"     /* GSM_AcTn */
+                            "(?:,\\s*(\\d+))?"     /* GSM_Compact_AcTn */
+                            "(?:,\\s*(\\d+))?"     /* UTRAN_AcTn */
+                            "(?:,\\s*(\\d+))?"     /* E-UTRAN_AcTn */
+                            "(?:,\\s*(\\d+))?",    /* NG-RAN_AcTn */
+                            G_REGEX_RAW, 0);
     g_regex_match (r, response, 0, &match_info);
 
     if (!g_match_info_matches (match_info)) {
@@ -5264,8 +5703,8 @@ mm_sim_parse_cpol_test_response (const gchar  *response,
     guint                  min_index;
     guint                  max_index;
 
-    r = g_regex_new ("\\+CPOL:\\s*\\((\\d+)\\s*-\\s*(\\d+)\\)",
-                     G_REGEX_RAW, 0, NULL);
+    r = mm_regex_cache_get ("\\+CPOL:\\s*\\((\\d+)\\s*-\\s*(\\d+)\\)",
+                            G_REGEX_RAW, 0);
     g_regex_match (r, response, 0, &match_info);
 
     if (!g_match_info_matches (match_info)) {
@@ -5297,6 +5736,34 @@ mm_sim_parse_cpol_test_response (const gchar  *response,
     return TRUE;
 }
 
+/*****************************************************************************/
+/* Network interface traffic counters */
+
+void
+mm_interface_stats_counter_init (MMInterfaceStatsCounter *counter,
+                                 guint64                  value)
+{
+    counter->base = value;
+    counter->last = value;
+    counter->offset = 0;
+}
+
+guint64
+mm_interface_stats_counter_update (MMInterfaceStatsCounter *counter,
+                                   guint64                  value)
+{
+    /* Counters going backwards mean the interface was reset, and so they
+     * restarted from 0; keep on counting from the last reported value */
+    if (value < counter->last) {
+        counter->offset += counter->last - counter->base;
+        counter->base = 0;
+    }
+    counter->last = value;
+    return counter->offset + (value - counter->base);
+}
+
+/*****************************************************************************/
+
 #define EID_BYTE_LENGTH 16
 
 gchar *
@@ -44,10 +44,65 @@
      MM_MODEM_CAPABILITY_LTE |          \
      MM_MODEM_CAPABILITY_5GNR)
 
+/* Process-wide registry of compiled regular expressions. Each pattern is
+ * compiled (and optimized, if requested) only once, the first time it's
+ * needed; a new reference to the shared GRegex is returned. */
+GRegex *mm_regex_cache_get (const gchar        *pattern,
+                            GRegexCompileFlags  compile_options,
+                            GRegexMatchFlags    match_options);
+
 gchar       *mm_strip_quotes (gchar *str);
 const gchar *mm_strip_tag    (const gchar *str,
                               const gchar *cmd);
 
+/* Extended read (+XXX?) and test (+XXX=?) commands have no side effects and
+ * their information text is always tagged with the command name, so several
+ * of them may be merged in a single command line (e.g. AT+COPS?;+CREG?) and
+ * the combined response split back into the per-command ones. */
+gboolean   mm_at_command_is_batchable         (const gchar         *command,
+                                               gsize               *prefix_len);
+gchar    **mm_at_command_batch_split_response (const gchar         *response,
+                                               const gchar * const *commands,
+                                               guint                n_commands);
+
+/* Zero-copy tokenizer for the list grammar used in 3GPP TS 27.007 responses,
+ * e.g. (2,"T-Mobile","TMO","31026",0),,(0-4),"SM". Items are handed out as
+ * slices of the original string, which must outlive the iterator. */
+typedef enum {
+    MM_AT_LIST_ITEM_EMPTY,  /* nothing between two separators */
+    MM_AT_LIST_ITEM_TOKEN,  /* bare value, e.g. 7, 0-5 or 4F */
+    MM_AT_LIST_ITEM_STRING, /* quoted string, quotes not included */
+    MM_AT_LIST_ITEM_GROUP,  /* parenthesized list, parentheses not included */
+} MMAtListItemType;
+
+typedef struct {
+    MMAtListItemType  type;
+    const gchar      *str;
+    gsize             len;
+} MMAtListItem;
+
+typedef struct {
+    const gchar *p;
+    const gchar *end;
+    gboolean     after_separator;
+} MMAtListIter;
+
+void     mm_at_list_iter_init           (MMAtListIter       *iter,
+                                         const gchar        *str,
+                                         gssize              len);
+void     mm_at_list_iter_init_group     (MMAtListIter       *iter,
+                                         const MMAtListItem *group);
+gboolean mm_at_list_iter_next           (MMAtListIter       *iter,
+                                         MMAtListItem       *item);
+gboolean mm_at_list_item_equal          (const MMAtListItem *item,
+                                         const gchar        *str);
+gboolean mm_at_list_item_get_uint       (const MMAtListItem *item,
+                                         guint              *out);
+gboolean mm_at_list_item_get_uint_range (const MMAtListItem *item,
+                                         guint              *out_min,
+                                         guint              *out_max);
+gchar   *mm_at_list_item_dup_string     (const MMAtListItem *item);
+
 gchar **mm_split_string_groups (const gchar *str);
 
 GArray *mm_parse_uint_list (const gchar  *str,
@@ -581,6 +636,23 @@ gboolean mm_sim_parse_cpol_test_response (const gchar  *response,
 #define MM_RSRP_TO_QUALITY(rsrp)                                   \
     (guint8)(100 - ((CLAMP (rsrp, -110, -60) + 60) * 100 / (-110 + 60)))
 
+/*****************************************************************************/
+/* Network interface traffic counters */
+
+/* Byte counter of a network interface, reported relative to the value it had
+ * when the connection started. The kernel counters go back to 0 if the
+ * interface is reset, so the amount counted until then is kept as offset. */
+typedef struct {
+    guint64 base;
+    guint64 last;
+    guint64 offset;
+} MMInterfaceStatsCounter;
+
+void    mm_interface_stats_counter_init   (MMInterfaceStatsCounter *counter,
+                                           guint64                  value);
+guint64 mm_interface_stats_counter_update (MMInterfaceStatsCounter *counter,
+                                           guint64                  value);
+
 /*****************************************************************************/
 
 /* Helper function to decode eid read from esim */
@@ -32,14 +32,22 @@
 #include "mm-utils.h"
 #include "mm-netlink.h"
 
+/* Big enough for the multipart messages of link dumps */
+#define NETLINK_RECEIVE_BUFFER_SIZE 32768
+
+typedef struct _Transaction Transaction;
+
 struct _MMNetlink {
     GObject parent;
     /* Netlink socket */
     GSocket *socket;
     GSource *source;
+    guint8  *receive_buffer;
     /* Netlink state */
     guint       current_sequence_id;
     GHashTable *transactions;
+    /* Ongoing link stats dump, if any */
+    Transaction *link_stats_tr;
 };
 
 struct _MMNetlinkClass {
@@ -160,6 +168,16 @@ netlink_message_new_setlink (guint    ifindex,
     return msg;
 }
 
+static NetlinkMessage *
+netlink_message_new_getlink_dump (void)
+{
+    NetlinkMessage *msg;
+
+    msg = netlink_message_new (0, RTM_GETLINK);
+    netlink_message_header (msg)->msghdr.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    return msg;
+}
+
 static void
 netlink_message_free (NetlinkMessage *msg)
 {
@@ -169,45 +187,72 @@ netlink_message_free (NetlinkMessage *msg)
 /*****************************************************************************/
 /* Netlink transactions */
 
-typedef struct {
-    MMNetlink *self;
-    guint32    sequence_id;
-    GSource   *timeout_source;
-    GTask     *completion_task;
-} Transaction;
+struct _Transaction {
+    MMNetlink  *self;
+    guint32     sequence_id;
+    GSource    *timeout_source;
+    GTask      *completion_task;
+    /* Link stats dumps only: results collected so far, and additional
+     * requests waiting for the same dump */
+    GHashTable *link_stats;
+    GList      *waiting_tasks;
+};
 
-static gboolean
-transaction_timed_out (Transaction *tr)
+static void
+transaction_complete_with_error (Transaction *tr,
+                                 GError      *error)
 {
     GTask *task;
-    guint32 sequence_id;
+    GList *waiting_tasks;
+    GList *l;
 
     task = g_steal_pointer (&tr->completion_task);
-    sequence_id = tr->sequence_id;
+    waiting_tasks = g_steal_pointer (&tr->waiting_tasks);
 
+    if (tr->self->link_stats_tr == tr)
+        tr->self->link_stats_tr = NULL;
     g_hash_table_remove (tr->self->transactions,
                          GUINT_TO_POINTER (tr->sequence_id));
 
-    g_task_return_new_error (task, G_IO_ERROR, G_IO_ERROR_TIMED_OUT,
-                             "Netlink message with sequence ID %u timed out",
-                             sequence_id);
+    for (l = waiting_tasks; l; l = g_list_next (l))
+        g_task_return_error (G_TASK (l->data), g_error_copy (error));
+    g_list_free_full (waiting_tasks, g_object_unref);
 
+    g_task_return_error (task, error);
     g_object_unref (task);
+}
+
+static gboolean
+transaction_timed_out (Transaction *tr)
+{
+    transaction_complete_with_error (tr,
+                                     g_error_new (G_IO_ERROR, G_IO_ERROR_TIMED_OUT,
+                                                  "Netlink message with sequence ID %u timed out",
+                                                  tr->sequence_id));
     return G_SOURCE_REMOVE;
 }
 
 static void
-transaction_complete_with_error (Transaction *tr,
-                                 GError      *error)
+transaction_complete_link_stats (Transaction *tr)
 {
-    GTask *task;
+    GTask      *task;
+    GList      *waiting_tasks;
+    GHashTable *link_stats;
+    GList      *l;
 
     task = g_steal_pointer (&tr->completion_task);
+    waiting_tasks = g_steal_pointer (&tr->waiting_tasks);
+    link_stats = g_steal_pointer (&tr->link_stats);
 
+    tr->self->link_stats_tr = NULL;
     g_hash_table_remove (tr->self->transactions,
                          GUINT_TO_POINTER (tr->sequence_id));
 
-    g_task_return_error (task, error);
+    for (l = waiting_tasks; l; l = g_list_next (l))
+        g_task_return_pointer (G_TASK (l->data), g_hash_table_ref (link_stats), (GDestroyNotify) g_hash_table_unref);
+    g_list_free_full (waiting_tasks, g_object_unref);
+
+    g_task_return_pointer (task, link_stats, (GDestroyNotify) g_hash_table_unref);
     g_object_unref (task);
 }
 
@@ -239,6 +284,8 @@ static void
 transaction_free (Transaction *tr)
 {
     g_assert (tr->completion_task == NULL);
+    g_assert (tr->waiting_tasks == NULL);
+    g_clear_pointer (&tr->link_stats, g_hash_table_unref);
     g_source_destroy (tr->timeout_source);
     g_source_unref (tr->timeout_source);
     g_slice_free (Transaction, tr);
@@ -327,13 +374,105 @@ mm_netlink_setlink (MMNetlink           *self,
 
 /*****************************************************************************/
 
+GHashTable *
+mm_netlink_get_link_stats_finish (MMNetlink     *self,
+                                  GAsyncResult  *res,
+                                  GError       **error)
+{
+    return g_task_propagate_pointer (G_TASK (res), error);
+}
+
+void
+mm_netlink_get_link_stats (MMNetlink           *self,
+                           GCancellable        *cancellable,
+                           GAsyncReadyCallback  callback,
+                           gpointer             user_data)
+{
+    GTask          *task;
+    NetlinkMessage *msg;
+    Transaction    *tr;
+    gssize          bytes_sent;
+    GError         *error = NULL;
+
+    task = g_task_new (self, cancellable, callback, user_data);
+
+    if (!self->socket) {
+        g_task_return_new_error (task, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                                 "netlink support not available");
+        g_object_unref (task);
+        return;
+    }
+
+    /* Join the ongoing dump, if any; the task ownership is transferred to
+     * the transaction. */
+    if (self->link_stats_tr) {
+        self->link_stats_tr->waiting_tasks = g_list_append (self->link_stats_tr->waiting_tasks, task);
+        return;
+    }
+
+    msg = netlink_message_new_getlink_dump ();
+
+    /* The task ownership is transferred to the transaction. */
+    tr = transaction_new (self, msg, 5, task);
+    tr->link_stats = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, g_free);
+    self->link_stats_tr = tr;
+
+    bytes_sent = g_socket_send (self->socket,
+                                (const gchar *) msg->data,
+                                msg->len,
+                                cancellable,
+                                &error);
+    netlink_message_free (msg);
+
+    if (bytes_sent < 0)
+        transaction_complete_with_error (tr, error);
+
+    g_object_unref (task);
+}
+
+static void
+link_stats_add (GHashTable      *link_stats,
+                struct nlmsghdr *hdr)
+{
+    struct ifinfomsg   *ifi;
+    struct rtattr      *attr;
+    gint                attr_len;
+    MMNetlinkLinkStats *stats;
+
+    if (hdr->nlmsg_len < NLMSG_LENGTH (sizeof (struct ifinfomsg)))
+        return;
+
+    ifi = NLMSG_DATA (hdr);
+    attr_len = IFLA_PAYLOAD (hdr);
+    for (attr = IFLA_RTA (ifi); RTA_OK (attr, attr_len); attr = RTA_NEXT (attr, attr_len)) {
+        struct rtnl_link_stats64 stats64 = { 0 };
+
+        if (attr->rta_type != IFLA_STATS64)
+            continue;
+
+        /* The struct may be smaller or bigger depending on the kernel version */
+        memcpy (&stats64, RTA_DATA (attr), MIN (RTA_PAYLOAD (attr), sizeof (stats64)));
+
+        stats = g_new0 (MMNetlinkLinkStats, 1);
+        stats->rx_bytes   = stats64.rx_bytes;
+        stats->tx_bytes   = stats64.tx_bytes;
+        stats->rx_packets = stats64.rx_packets;
+        stats->tx_packets = stats64.tx_packets;
+        stats->rx_dropped = stats64.rx_dropped;
+        stats->tx_dropped = stats64.tx_dropped;
+        g_hash_table_insert (link_stats, GUINT_TO_POINTER (ifi->ifi_index), stats);
+        return;
+    }
+}
+
+/*****************************************************************************/
+
 static gboolean
 netlink_message_cb (GSocket      *socket,
                     GIOCondition  condition,
                     MMNetlink    *self)
 {
     g_autoptr(GError) error = NULL;
-    gchar             buf[512];
     gssize            bytes_received;
     guint             buffer_len;
     struct nlmsghdr  *hdr;
@@ -343,28 +482,49 @@ netlink_message_cb (GSocket      *socket,
         return G_SOURCE_REMOVE;
     }
 
-    bytes_received = g_socket_receive (socket, buf, sizeof (buf), NULL, &error);
+    bytes_received = g_socket_receive (socket,
+                                       (gchar *) self->receive_buffer,
+                                       NETLINK_RECEIVE_BUFFER_SIZE,
+                                       NULL,
+                                       &error);
     if (bytes_received < 0) {
         mm_obj_warn (self, "socket i/o failure: %s", error->message);
         return G_SOURCE_REMOVE;
     }
 
     buffer_len = (guint) bytes_received;
-    for (hdr = (struct nlmsghdr *) buf; NLMSG_OK (hdr, buffer_len);
-         NLMSG_NEXT (hdr, buffer_len)) {
+    for (hdr = (struct nlmsghdr *) self->receive_buffer; NLMSG_OK (hdr, buffer_len);
+         hdr = NLMSG_NEXT (hdr, buffer_len)) {
         Transaction     *tr;
         struct nlmsgerr *err;
 
-        if (hdr->nlmsg_type != NLMSG_ERROR)
-            continue;
-
         tr = g_hash_table_lookup (self->transactions,
                                   GUINT_TO_POINTER (hdr->nlmsg_seq));
         if (!tr)
             continue;
 
-        err = NLMSG_DATA (buf);
-        transaction_complete (tr, err->error);
+        switch (hdr->nlmsg_type) {
+        case NLMSG_ERROR:
+            err = NLMSG_DATA (hdr);
+            if (!tr->link_stats)
+                transaction_complete (tr, err->error);
+            else if (err->error)
+                transaction_complete_with_error (tr,
+                                                 g_error_new (G_IO_ERROR, g_io_error_from_errno (-err->error),
+                                                              "Netlink link dump with transaction %u failed",
+                                                              tr->sequence_id));
+            break;
+        case RTM_NEWLINK:
+            if (tr->link_stats)
+                link_stats_add (tr->link_stats, hdr);
+            break;
+        case NLMSG_DONE:
+            if (tr->link_stats)
+                transaction_complete_link_stats (tr);
+            break;
+        default:
+            break;
+        }
     }
     return G_SOURCE_CONTINUE;
 }
@@ -397,6 +557,7 @@ setup_netlink_socket (MMNetlink  *self,
                            NULL);
     g_source_attach (self->source, NULL);
 
+    self->receive_buffer = g_malloc (NETLINK_RECEIVE_BUFFER_SIZE);
     return TRUE;
 }
 
@@ -439,6 +600,7 @@ dispose (GObject *object)
         g_source_destroy (self->source);
     g_clear_pointer (&self->source, g_source_unref);
     g_clear_object (&self->socket);
+    g_clear_pointer (&self->receive_buffer, g_free);
 
     G_OBJECT_CLASS (mm_netlink_parent_class)->dispose (object);
 }
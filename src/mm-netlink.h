@@ -49,6 +49,27 @@ gboolean mm_netlink_setlink_finish (MMNetlink            *self,
                                     GAsyncResult         *res,
                                     GError              **error);
 
+/* Kernel counters of a network interface */
+typedef struct {
+    guint64 rx_bytes;
+    guint64 tx_bytes;
+    guint64 rx_packets;
+    guint64 tx_packets;
+    guint64 rx_dropped;
+    guint64 tx_dropped;
+} MMNetlinkLinkStats;
+
+/* Loads the counters of all network interfaces in a single dump, shared
+ * by all the requests issued while the dump is ongoing. The result maps
+ * interface indices to MMNetlinkLinkStats. */
+void        mm_netlink_get_link_stats        (MMNetlink            *self,
+                                              GCancellable         *cancellable,
+                                              GAsyncReadyCallback   callback,
+                                              gpointer              user_data);
+GHashTable *mm_netlink_get_link_stats_finish (MMNetlink            *self,
+                                              GAsyncResult         *res,
+                                              GError              **error);
+
 G_END_DECLS
 
 #endif  /* MM_MODEM_HELPERS_NETLINK_H */
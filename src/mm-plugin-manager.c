@@ -29,6 +29,7 @@
 
 #include "mm-plugin-manager.h"
 #include "mm-plugin.h"
+#include "mm-port-probe-cache.h"
 #include "mm-shared.h"
 #include "mm-utils.h"
 #include "mm-log-object.h"
@@ -224,6 +225,11 @@ struct _PortContext {
     MMPlugin *best_plugin;
     /* A plugin was suggested for this port. */
     MMPlugin *suggested_plugin;
+    /* The plugin stored along with the cached probing results, if any. */
+    MMPlugin *cached_plugin;
+    /* Whether a single specific plugin may support this port, so that a
+     * positive result decides the plugin for the whole device. */
+    gboolean conclusive;
 
     /* The probe has been deferred */
     guint defer_id;
@@ -246,6 +252,8 @@ port_context_unref (PortContext *port_context)
             g_object_unref (port_context->best_plugin);
         if (port_context->suggested_plugin)
             g_object_unref (port_context->suggested_plugin);
+        if (port_context->cached_plugin)
+            g_object_unref (port_context->cached_plugin);
         if (port_context->plugins)
             g_list_free_full (port_context->plugins, g_object_unref);
         if (port_context->cancellable)
@@ -635,6 +643,19 @@ port_context_run (MMPluginManager     *self,
     port_context->plugins = g_list_copy_deep (plugins, (GCopyFunc) g_object_ref, NULL);
     port_context->current = port_context->plugins;
 
+    /* If only one specific plugin is left after the pre-probing filters, no
+     * other port in the device can be supported by a different one */
+    {
+        GList *l;
+        guint  n_specific = 0;
+
+        for (l = port_context->plugins; l; l = g_list_next (l)) {
+            if (!mm_plugin_is_generic (MM_PLUGIN (l->data)))
+                n_specific++;
+        }
+        port_context->conclusive = (n_specific == 1);
+    }
+
     /* If we got one suggested, it will be the first one */
     if (suggested) {
         port_context->suggested_plugin = g_object_ref (suggested);
@@ -784,6 +805,18 @@ struct _DeviceContext {
      * is reset to 0. */
     guint extra_probing_time_id;
 
+    /* Number of ports in the persistent probing results cache for this device,
+     * and how many of them have already been grabbed with valid cached results.
+     * Once all cached ports are available, there is no need to wait for more. */
+    guint n_cached_ports_expected;
+    guint n_cached_ports;
+    /* Whether a port without valid cached results was grabbed. */
+    gboolean cache_miss;
+
+    /* Whether a conclusive port result decided the plugin for the whole
+     * device, so that there is no need to wait for the probing timeouts. */
+    gboolean decided;
+
     /* Signal connection ids for the grabbed/released signals from the device.
      * These are the signals that will give us notifications of what ports are
      * available (or suddenly unavailable) in the device. */
@@ -957,6 +990,31 @@ device_context_suggest_plugin (DeviceContext *device_context,
     g_list_free (listdup);
 }
 
+static void
+device_context_decided (DeviceContext *device_context,
+                        PortContext   *port_context)
+{
+    MMPluginManager *self;
+
+    self = g_task_get_source_object (device_context->task);
+
+    mm_obj_dbg (self, "task %s: plugin decided by port %s, not waiting for more ports",
+                device_context->name, mm_kernel_device_get_name (port_context->port));
+    device_context->decided = TRUE;
+
+    /* The probing times only give the kernel room to expose ports while we
+     * don't know which plugin handles the device. Ports grabbed while the
+     * remaining probes run are still checked, with the decided plugin only. */
+    if (device_context->min_probing_time_id) {
+        g_source_remove (device_context->min_probing_time_id);
+        device_context->min_probing_time_id = 0;
+    }
+    if (device_context->extra_probing_time_id) {
+        g_source_remove (device_context->extra_probing_time_id);
+        device_context->extra_probing_time_id = 0;
+    }
+}
+
 static void
 device_context_set_best_plugin (DeviceContext *device_context,
                                 PortContext   *port_context,
@@ -1004,6 +1062,9 @@ device_context_set_best_plugin (DeviceContext *device_context,
         /* Store and suggest this plugin also to other port probes */
         device_context->best_plugin = g_object_ref (best_plugin);
         device_context_suggest_plugin (device_context, port_context, best_plugin);
+        /* If the result is conclusive, don't hold the device any longer */
+        if (port_context->conclusive && !mm_plugin_is_generic (best_plugin))
+            device_context_decided (device_context, port_context);
         return;
     }
 
@@ -1189,10 +1250,20 @@ device_context_run_port_context (DeviceContext *device_context,
      * (so that per-driver filters work correctly) */
     plugins = plugin_manager_build_plugins_list (self, device_context->device, port_context->port);
 
+    /* Once the plugin is decided for the device, don't check any other one,
+     * if the port may be handled by it at all */
+    if (device_context->decided && g_list_find (plugins, device_context->best_plugin)) {
+        g_list_free_full (plugins, g_object_unref);
+        plugins = g_list_append (NULL, g_object_ref (device_context->best_plugin));
+    }
+
     /* If we got one already set in the device context, it will be the first one,
      * unless it is the generic plugin */
     if (device_context->best_plugin && !mm_plugin_is_generic (device_context->best_plugin))
         suggested = device_context->best_plugin;
+    /* Otherwise, try first with the one that supported the port last time */
+    else if (port_context->cached_plugin && !mm_plugin_is_generic (port_context->cached_plugin))
+        suggested = port_context->cached_plugin;
 
     port_context_run (self,
                       port_context,
@@ -1275,6 +1346,65 @@ device_context_port_released (DeviceContext  *device_context,
                 device_context->name, mm_kernel_device_get_name (port));
 }
 
+static void
+device_context_load_cached_port (DeviceContext *device_context,
+                                 PortContext   *port_context)
+{
+    MMPluginManager  *self;
+    MMPortProbe      *probe;
+    g_autofree gchar *plugin_name = NULL;
+    guint             n_ports = 0;
+
+    self = MM_PLUGIN_MANAGER (device_context->self);
+
+    probe = MM_PORT_PROBE (mm_device_peek_port_probe (device_context->device, port_context->port));
+    if (!probe || !mm_port_probe_cache_load (device_context->device, probe, &plugin_name, &n_ports)) {
+        device_context->cache_miss = TRUE;
+        return;
+    }
+
+    if (plugin_name) {
+        MMPlugin *plugin;
+
+        plugin = mm_plugin_manager_peek_plugin (self, plugin_name);
+        if (plugin)
+            port_context->cached_plugin = g_object_ref (plugin);
+    }
+
+    device_context->n_cached_ports_expected = n_ports;
+    device_context->n_cached_ports++;
+    mm_obj_dbg (self, "task %s: cached probing results loaded (%u/%u ports, plugin %s)",
+                port_context->name,
+                device_context->n_cached_ports,
+                device_context->n_cached_ports_expected,
+                plugin_name ? plugin_name : "unknown");
+}
+
+static void
+device_context_check_cached_ports (DeviceContext *device_context)
+{
+    MMPluginManager *self;
+
+    if (device_context->cache_miss ||
+        !device_context->n_cached_ports ||
+        device_context->n_cached_ports < device_context->n_cached_ports_expected)
+        return;
+
+    /* Only the port probing is skipped; the min and extra probing times are
+     * kept, as the device may expose more ports than the ones cached (e.g.
+     * after a firmware update keeping the same revision string), and those
+     * must still be grabbed. */
+    if (!device_context->min_wait_time_id)
+        return;
+
+    self = MM_PLUGIN_MANAGER (device_context->self);
+    mm_obj_dbg (self, "task %s: all cached ports available, launching port contexts right away",
+                device_context->name);
+
+    g_source_remove (device_context->min_wait_time_id);
+    device_context_min_wait_time_elapsed (device_context);
+}
+
 static void
 device_context_port_grabbed (DeviceContext  *device_context,
                              MMKernelDevice *port)
@@ -1304,12 +1434,14 @@ device_context_port_grabbed (DeviceContext  *device_context,
         return;
     }
 
-    /* Refresh the extra probing timeout. */
-    if (device_context->extra_probing_time_id)
-        g_source_remove (device_context->extra_probing_time_id);
-    device_context->extra_probing_time_id = g_timeout_add (EXTRA_PROBING_TIME_MSECS,
-                                                           (GSourceFunc) device_context_extra_probing_time_elapsed,
-                                                           device_context);
+    /* Refresh the extra probing timeout, unless the plugin is already decided */
+    if (!device_context->decided) {
+        if (device_context->extra_probing_time_id)
+            g_source_remove (device_context->extra_probing_time_id);
+        device_context->extra_probing_time_id = g_timeout_add (EXTRA_PROBING_TIME_MSECS,
+                                                               (GSourceFunc) device_context_extra_probing_time_elapsed,
+                                                               device_context);
+    }
 
     /* Setup a new port context for the newly grabbed port */
     port_context = port_context_new (self,
@@ -1320,21 +1452,26 @@ device_context_port_grabbed (DeviceContext  *device_context,
     mm_obj_dbg (self, "task %s: new support task for port",
                 port_context->name);
 
+    /* Preload the probing results from the persistent cache, if any */
+    device_context_load_cached_port (device_context, port_context);
+
     /* Îf still waiting the min wait time, store it in the waiting list */
     if (device_context->min_wait_time_id) {
         mm_obj_dbg (self, "task %s: deferred until min wait time elapsed",
                     port_context->name);
         /* Store the port reference in the list within the device */
         device_context->wait_port_contexts = g_list_prepend (device_context->wait_port_contexts, port_context);
-        return;
-    }
+    } else {
+        /* Store the port reference in the list within the device */
+        device_context->port_contexts = g_list_prepend (device_context->port_contexts, port_context) ;
 
-    /* Store the port reference in the list within the device */
-    device_context->port_contexts = g_list_prepend (device_context->port_contexts, port_context) ;
+        /* If the port has been grabbed after the min wait timeout expired, launch
+         * probing directly */
+        device_context_run_port_context (device_context, port_context);
+    }
 
-    /* If the port has been grabbed after the min wait timeout expired, launch
-     * probing directly */
-    device_context_run_port_context (device_context, port_context);
+    /* If all the ports in the cache are now available, don't wait for more */
+    device_context_check_cached_ports (device_context);
 }
 
 static gboolean
@@ -0,0 +1,115 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 Telit
+ */
+
+#include "mm-poll-scheduler.h"
+
+struct _MMPollScheduler {
+    guint    min_interval;
+    guint    max_interval;
+    /* Current interval, when polling */
+    guint    interval;
+    gboolean boost;
+    /* Indications received since the last tick */
+    guint    n_indications;
+    /* Consecutive ticks with indications received */
+    guint    n_indication_ticks;
+};
+
+MMPollScheduler *
+mm_poll_scheduler_new (guint min_interval,
+                       guint max_interval)
+{
+    MMPollScheduler *self;
+
+    g_assert (min_interval > 0);
+
+    self = g_slice_new0 (MMPollScheduler);
+    self->min_interval = min_interval;
+    self->max_interval = MAX (min_interval, max_interval);
+    self->interval = min_interval;
+    return self;
+}
+
+void
+mm_poll_scheduler_free (MMPollScheduler *self)
+{
+    if (self)
+        g_slice_free (MMPollScheduler, self);
+}
+
+void
+mm_poll_scheduler_reset (MMPollScheduler *self)
+{
+    self->interval = self->min_interval;
+    self->n_indications = 0;
+    self->n_indication_ticks = 0;
+}
+
+void
+mm_poll_scheduler_set_boost (MMPollScheduler *self,
+                             gboolean         boost)
+{
+    self->boost = boost;
+}
+
+void
+mm_poll_scheduler_report_polled (MMPollScheduler *self,
+                                 gboolean         changed)
+{
+    if (changed)
+        self->interval = self->min_interval;
+    else if (self->interval < self->max_interval)
+        self->interval = MIN (self->interval * 2, self->max_interval);
+}
+
+void
+mm_poll_scheduler_report_indication (MMPollScheduler *self,
+                                     gboolean         changed)
+{
+    self->n_indications++;
+    /* Stable values reported via indications shouldn't back off the polling,
+     * only changes matter */
+    if (changed)
+        self->interval = self->min_interval;
+}
+
+gboolean
+mm_poll_scheduler_get_indications_proven (MMPollScheduler *self)
+{
+    return (self->n_indication_ticks >= MM_POLL_SCHEDULER_INDICATIONS_PROVEN_TICKS);
+}
+
+gboolean
+mm_poll_scheduler_tick (MMPollScheduler *self)
+{
+    if (self->n_indications > 0) {
+        if (self->n_indication_ticks < MM_POLL_SCHEDULER_INDICATIONS_PROVEN_TICKS)
+            self->n_indication_ticks++;
+    } else
+        self->n_indication_ticks = 0;
+    self->n_indications = 0;
+
+    return !mm_poll_scheduler_get_indications_proven (self);
+}
+
+guint
+mm_poll_scheduler_get_interval (MMPollScheduler *self)
+{
+    if (mm_poll_scheduler_get_indications_proven (self))
+        return self->max_interval;
+    if (self->boost)
+        return self->min_interval;
+    return self->interval;
+}
@@ -0,0 +1,66 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 Telit
+ */
+
+#ifndef MM_POLL_SCHEDULER_H
+#define MM_POLL_SCHEDULER_H
+
+#include <glib.h>
+
+/*
+ * Adaptive polling interval.
+ *
+ * The interval starts at the minimum, and is doubled, up to the maximum, each
+ * time a poll reports a value that didn't change. Any change in the values
+ * goes back to the minimum. While boosted (e.g. while connecting) the minimum
+ * interval is always used.
+ *
+ * If the same values are also reported via indications (e.g. unsolicited
+ * messages), and indications are received during several consecutive
+ * intervals, they are considered proven and polling is no longer needed.
+ * The maximum interval is then used to check whether indications keep on
+ * arriving; if they don't, polling is resumed.
+ */
+
+/* Number of consecutive intervals with indications before trusting them */
+#define MM_POLL_SCHEDULER_INDICATIONS_PROVEN_TICKS 3
+
+typedef struct _MMPollScheduler MMPollScheduler;
+
+MMPollScheduler *mm_poll_scheduler_new                (guint            min_interval,
+                                                       guint            max_interval);
+void             mm_poll_scheduler_free               (MMPollScheduler *self);
+
+/* Back to the minimum interval, forgetting about indications */
+void             mm_poll_scheduler_reset              (MMPollScheduler *self);
+void             mm_poll_scheduler_set_boost          (MMPollScheduler *self,
+                                                       gboolean         boost);
+
+/* Report new values, polled or received via indications */
+void             mm_poll_scheduler_report_polled      (MMPollScheduler *self,
+                                                       gboolean         changed);
+void             mm_poll_scheduler_report_indication  (MMPollScheduler *self,
+                                                       gboolean         changed);
+
+/* To be called each time the interval expires; returns TRUE if polling is
+ * needed */
+gboolean         mm_poll_scheduler_tick               (MMPollScheduler *self);
+
+/* Interval to wait until the next tick */
+guint            mm_poll_scheduler_get_interval       (MMPollScheduler *self);
+gboolean         mm_poll_scheduler_get_indications_proven (MMPollScheduler *self);
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (MMPollScheduler, mm_poll_scheduler_free)
+
+#endif /* MM_POLL_SCHEDULER_H */
@@ -0,0 +1,288 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 Telit
+ */
+
+#include <config.h>
+#include <string.h>
+
+#include <ModemManager.h>
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+
+#include "mm-port-probe-cache.h"
+#include "mm-plugin.h"
+#include "mm-context.h"
+#include "mm-log-object.h"
+
+#define DEVICE_KEY_PLUGIN         "plugin"
+#define DEVICE_KEY_VENDOR_ID      "vendor-id"
+#define DEVICE_KEY_PRODUCT_ID     "product-id"
+#define DEVICE_KEY_REVISION       "revision"
+#define DEVICE_KEY_PORTS          "ports"
+#define PORT_KEY_INTERFACE_NUMBER "interface-number"
+
+/* The cache is loaded lazily, the first time it's needed */
+static GKeyFile *cache;
+static gboolean  cache_loaded;
+
+static GKeyFile *
+cache_peek (MMDevice *device)
+{
+    const gchar       *path;
+    g_autoptr(GError)  error = NULL;
+
+    if (cache_loaded)
+        return cache;
+    cache_loaded = TRUE;
+
+    path = mm_context_get_probe_cache ();
+    if (!path)
+        return NULL;
+
+    cache = g_key_file_new ();
+    if (!g_key_file_load_from_file (cache, path, G_KEY_FILE_NONE, &error) &&
+        !g_error_matches (error, G_FILE_ERROR, G_FILE_ERROR_NOENT))
+        mm_obj_warn (device, "couldn't load port probing cache, starting from scratch: %s", error->message);
+    return cache;
+}
+
+static void
+cache_save (MMDevice *device)
+{
+    g_autoptr(GError) error = NULL;
+
+    if (!g_key_file_save_to_file (cache, mm_context_get_probe_cache (), &error))
+        mm_obj_warn (device, "couldn't save port probing cache: %s", error->message);
+}
+
+/*****************************************************************************/
+
+static gboolean
+group_name_valid (const gchar *group)
+{
+    const gchar *aux;
+
+    for (aux = group; *aux; aux++) {
+        if (*aux == '[' || *aux == ']' || g_ascii_iscntrl (*aux))
+            return FALSE;
+    }
+    return TRUE;
+}
+
+static gchar *
+build_port_group (const gchar    *uid,
+                  MMKernelDevice *port)
+{
+    return g_strdup_printf ("%s %s/%s",
+                            uid,
+                            mm_kernel_device_get_subsystem (port),
+                            mm_kernel_device_get_name (port));
+}
+
+static gboolean
+cache_remove_device (GKeyFile    *keyfile,
+                     const gchar *uid)
+{
+    g_auto(GStrv)     groups = NULL;
+    g_autofree gchar *prefix = NULL;
+    gboolean          removed = FALSE;
+    guint             i;
+
+    prefix = g_strdup_printf ("%s ", uid);
+    groups = g_key_file_get_groups (keyfile, NULL);
+    for (i = 0; groups[i]; i++) {
+        if (g_str_equal (groups[i], uid) || g_str_has_prefix (groups[i], prefix))
+            removed |= g_key_file_remove_group (keyfile, groups[i], NULL);
+    }
+    return removed;
+}
+
+static gboolean
+cache_verify_port (GKeyFile        *keyfile,
+                   const gchar     *uid,
+                   const gchar     *port_group,
+                   MMKernelDevice  *port,
+                   GError         **error)
+{
+    gint vid;
+    gint pid;
+    gint revision;
+    gint interface_number;
+
+    /* Errors loading the integers are reported as mismatches as well */
+    vid              = g_key_file_get_integer (keyfile, uid,        DEVICE_KEY_VENDOR_ID,      NULL);
+    pid              = g_key_file_get_integer (keyfile, uid,        DEVICE_KEY_PRODUCT_ID,     NULL);
+    revision         = g_key_file_get_integer (keyfile, uid,        DEVICE_KEY_REVISION,       NULL);
+    interface_number = g_key_file_get_integer (keyfile, port_group, PORT_KEY_INTERFACE_NUMBER, NULL);
+
+    if ((vid != mm_kernel_device_get_physdev_vid (port)) || (pid != mm_kernel_device_get_physdev_pid (port))) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                     "device changed (cached %04x:%04x, current %04x:%04x)",
+                     vid, pid,
+                     mm_kernel_device_get_physdev_vid (port),
+                     mm_kernel_device_get_physdev_pid (port));
+        return FALSE;
+    }
+
+    if (revision != mm_kernel_device_get_physdev_revision (port)) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                     "device revision changed (cached %04x, current %04x)",
+                     revision, mm_kernel_device_get_physdev_revision (port));
+        return FALSE;
+    }
+
+    if (interface_number != mm_kernel_device_get_interface_number (port)) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                     "port interface number changed (cached %d, current %d)",
+                     interface_number, mm_kernel_device_get_interface_number (port));
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+gboolean
+mm_port_probe_cache_load (MMDevice     *device,
+                          MMPortProbe  *probe,
+                          gchar       **out_plugin,
+                          guint        *out_n_ports)
+{
+    GKeyFile          *keyfile;
+    MMKernelDevice    *port;
+    const gchar       *uid;
+    g_autofree gchar  *port_group = NULL;
+    g_auto(GStrv)      ports = NULL;
+    g_autoptr(GError)  error = NULL;
+
+    if (mm_device_is_virtual (device))
+        return FALSE;
+
+    keyfile = cache_peek (device);
+    if (!keyfile)
+        return FALSE;
+
+    uid = mm_device_get_uid (device);
+    if (!g_key_file_has_group (keyfile, uid))
+        return FALSE;
+
+    port = mm_port_probe_peek_port (probe);
+    port_group = build_port_group (uid, port);
+    if (!g_key_file_has_group (keyfile, port_group)) {
+        mm_obj_dbg (probe, "no cached probing results for port");
+        return FALSE;
+    }
+
+    /* If the device isn't exactly the one we cached, the results can't be trusted
+     * for any of its ports */
+    if (!cache_verify_port (keyfile, uid, port_group, port, &error) ||
+        !mm_port_probe_load_results (probe, keyfile, port_group, &error)) {
+        mm_obj_dbg (probe, "cached probing results invalidated: %s", error->message);
+        cache_remove_device (keyfile, uid);
+        cache_save (device);
+        return FALSE;
+    }
+
+    ports = g_key_file_get_string_list (keyfile, uid, DEVICE_KEY_PORTS, NULL, NULL);
+
+    if (out_plugin)
+        *out_plugin = g_key_file_get_string (keyfile, uid, DEVICE_KEY_PLUGIN, NULL);
+    if (out_n_ports)
+        *out_n_ports = ports ? g_strv_length (ports) : 0;
+    return TRUE;
+}
+
+void
+mm_port_probe_cache_store (MMDevice *device)
+{
+    GKeyFile             *keyfile;
+    GObject              *plugin;
+    GList                *probes;
+    GList                *l;
+    const gchar          *uid;
+    MMKernelDevice       *first_port;
+    MMAsyncMethod        *custom_init = NULL;
+    g_autoptr(GPtrArray)  ports = NULL;
+
+    if (mm_device_is_virtual (device))
+        return;
+
+    keyfile = cache_peek (device);
+    if (!keyfile)
+        return;
+
+    uid    = mm_device_get_uid (device);
+    plugin = mm_device_peek_plugin (device);
+    probes = mm_device_peek_port_probe_list (device);
+    if (!plugin || !probes || !group_name_valid (uid))
+        return;
+
+    /* Plugins with a custom AT port initialization may keep additional
+     * per-port state in the probes, which can't be restored from the cache */
+    g_object_get (plugin, MM_PLUGIN_CUSTOM_INIT, &custom_init, NULL);
+    if (custom_init) {
+        mm_obj_dbg (device, "not caching probing results: plugin requires custom port initialization");
+        g_boxed_free (MM_TYPE_ASYNC_METHOD, custom_init);
+        return;
+    }
+
+    cache_remove_device (keyfile, uid);
+
+    ports = g_ptr_array_new_with_free_func (g_free);
+    for (l = probes; l; l = g_list_next (l)) {
+        MMPortProbe      *probe;
+        MMKernelDevice   *port;
+        g_autofree gchar *port_group = NULL;
+
+        probe = MM_PORT_PROBE (l->data);
+        port = mm_port_probe_peek_port (probe);
+        port_group = build_port_group (uid, port);
+        if (!group_name_valid (port_group))
+            continue;
+
+        mm_port_probe_save_results (probe, keyfile, port_group);
+        g_key_file_set_integer (keyfile, port_group, PORT_KEY_INTERFACE_NUMBER,
+                                mm_kernel_device_get_interface_number (port));
+        g_ptr_array_add (ports, g_strdup_printf ("%s/%s",
+                                                 mm_kernel_device_get_subsystem (port),
+                                                 mm_kernel_device_get_name (port)));
+    }
+    g_ptr_array_add (ports, NULL);
+
+    /* All ports share the same physical device */
+    first_port = mm_port_probe_peek_port (MM_PORT_PROBE (probes->data));
+    g_key_file_set_string  (keyfile, uid, DEVICE_KEY_PLUGIN, mm_plugin_get_name (MM_PLUGIN (plugin)));
+    g_key_file_set_integer (keyfile, uid, DEVICE_KEY_VENDOR_ID,  mm_kernel_device_get_physdev_vid (first_port));
+    g_key_file_set_integer (keyfile, uid, DEVICE_KEY_PRODUCT_ID, mm_kernel_device_get_physdev_pid (first_port));
+    g_key_file_set_integer (keyfile, uid, DEVICE_KEY_REVISION,   mm_kernel_device_get_physdev_revision (first_port));
+    g_key_file_set_string_list (keyfile, uid, DEVICE_KEY_PORTS,
+                                (const gchar * const *) ports->pdata, ports->len - 1);
+
+    mm_obj_dbg (device, "stored probing results of %u ports in cache", ports->len - 1);
+    cache_save (device);
+}
+
+void
+mm_port_probe_cache_invalidate (MMDevice *device)
+{
+    GKeyFile *keyfile;
+
+    keyfile = cache_peek (device);
+    if (!keyfile)
+        return;
+
+    if (cache_remove_device (keyfile, mm_device_get_uid (device))) {
+        mm_obj_dbg (device, "cached probing results invalidated");
+        cache_save (device);
+    }
+}
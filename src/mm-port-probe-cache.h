@@ -0,0 +1,38 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 Telit
+ */
+
+#ifndef MM_PORT_PROBE_CACHE_H
+#define MM_PORT_PROBE_CACHE_H
+
+#include <glib.h>
+
+#include "mm-device.h"
+#include "mm-port-probe.h"
+
+/* Persistent cache of port probing results, enabled with --probe-cache.
+ *
+ * Results are keyed by the physical device UID and the port subsystem/name,
+ * and are only reused if the physical device VID/PID/revision and the port
+ * interface number still match the ones stored. On any mismatch all the
+ * entries of the device are dropped and the device is fully probed again. */
+
+gboolean mm_port_probe_cache_load       (MMDevice     *device,
+                                         MMPortProbe  *probe,
+                                         gchar       **out_plugin,
+                                         guint        *out_n_ports);
+void     mm_port_probe_cache_store      (MMDevice     *device);
+void     mm_port_probe_cache_invalidate (MMDevice     *device);
+
+#endif /* MM_PORT_PROBE_CACHE_H */
@@ -332,6 +332,82 @@ mm_port_probe_set_result_mbim (MMPortProbe *self,
 
 /*****************************************************************************/
 
+#define RESULTS_KEY_FLAGS   "flags"
+#define RESULTS_KEY_AT      "at"
+#define RESULTS_KEY_QCDM    "qcdm"
+#define RESULTS_KEY_QMI     "qmi"
+#define RESULTS_KEY_MBIM    "mbim"
+#define RESULTS_KEY_ICERA   "icera"
+#define RESULTS_KEY_XMM     "xmm"
+#define RESULTS_KEY_VENDOR  "vendor"
+#define RESULTS_KEY_PRODUCT "product"
+
+void
+mm_port_probe_save_results (MMPortProbe *self,
+                            GKeyFile    *keyfile,
+                            const gchar *group)
+{
+    g_key_file_set_integer (keyfile, group, RESULTS_KEY_FLAGS, (gint) self->priv->flags);
+    g_key_file_set_boolean (keyfile, group, RESULTS_KEY_AT,    self->priv->is_at);
+    g_key_file_set_boolean (keyfile, group, RESULTS_KEY_QCDM,  self->priv->is_qcdm);
+    g_key_file_set_boolean (keyfile, group, RESULTS_KEY_QMI,   self->priv->is_qmi);
+    g_key_file_set_boolean (keyfile, group, RESULTS_KEY_MBIM,  self->priv->is_mbim);
+    g_key_file_set_boolean (keyfile, group, RESULTS_KEY_ICERA, self->priv->is_icera);
+    g_key_file_set_boolean (keyfile, group, RESULTS_KEY_XMM,   self->priv->is_xmm);
+    if (self->priv->vendor)
+        g_key_file_set_string (keyfile, group, RESULTS_KEY_VENDOR, self->priv->vendor);
+    if (self->priv->product)
+        g_key_file_set_string (keyfile, group, RESULTS_KEY_PRODUCT, self->priv->product);
+}
+
+gboolean
+mm_port_probe_load_results (MMPortProbe  *self,
+                            GKeyFile     *keyfile,
+                            const gchar  *group,
+                            GError      **error)
+{
+    GError *inner_error = NULL;
+    gint    flags;
+
+    flags = g_key_file_get_integer (keyfile, group, RESULTS_KEY_FLAGS, &inner_error);
+    if (inner_error) {
+        g_propagate_error (error, inner_error);
+        return FALSE;
+    }
+
+    if (flags & ~(MM_PORT_PROBE_AT |
+                  MM_PORT_PROBE_AT_VENDOR |
+                  MM_PORT_PROBE_AT_PRODUCT |
+                  MM_PORT_PROBE_AT_ICERA |
+                  MM_PORT_PROBE_AT_XMM |
+                  MM_PORT_PROBE_QCDM |
+                  MM_PORT_PROBE_QMI |
+                  MM_PORT_PROBE_MBIM)) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
+                     "invalid probing flags: 0x%x", flags);
+        return FALSE;
+    }
+
+    /* Missing booleans default to FALSE, which is also what the probe would
+     * report for results not flagged as available */
+    self->priv->flags    = (guint32) flags;
+    self->priv->is_at    = g_key_file_get_boolean (keyfile, group, RESULTS_KEY_AT,    NULL);
+    self->priv->is_qcdm  = g_key_file_get_boolean (keyfile, group, RESULTS_KEY_QCDM,  NULL);
+    self->priv->is_qmi   = g_key_file_get_boolean (keyfile, group, RESULTS_KEY_QMI,   NULL);
+    self->priv->is_mbim  = g_key_file_get_boolean (keyfile, group, RESULTS_KEY_MBIM,  NULL);
+    self->priv->is_icera = g_key_file_get_boolean (keyfile, group, RESULTS_KEY_ICERA, NULL);
+    self->priv->is_xmm   = g_key_file_get_boolean (keyfile, group, RESULTS_KEY_XMM,   NULL);
+    g_free (self->priv->vendor);
+    self->priv->vendor   = g_key_file_get_string (keyfile, group, RESULTS_KEY_VENDOR,  NULL);
+    g_free (self->priv->product);
+    self->priv->product  = g_key_file_get_string (keyfile, group, RESULTS_KEY_PRODUCT, NULL);
+
+    mm_obj_dbg (self, "probing results loaded from cache");
+    return TRUE;
+}
+
+/*****************************************************************************/
+
 typedef struct {
     /* ---- Generic task context ---- */
     guint32 flags;
@@ -665,6 +741,11 @@ common_serial_port_setup (MMPortProbe  *self,
                           NULL);
         }
     }
+
+    if (mm_kernel_device_get_property_as_boolean (self->priv->port, ID_MM_TTY_BURST_WRITE))
+        g_object_set (serial,
+                      MM_PORT_SERIAL_BURST_WRITE, TRUE,
+                      NULL);
 }
 
 /***************************************************************/
@@ -1262,13 +1343,16 @@ serial_flash_ready (MMPortSerial *port,
 }
 
 static void
-serial_buffer_full (MMPortSerial *serial,
-                    GByteArray   *buffer,
-                    MMPortProbe  *self)
+serial_buffer_full (MMPortSerial   *serial,
+                    MMSerialBuffer *buffer,
+                    MMPortProbe    *self)
 {
     PortProbeRunContext *ctx;
+    const guint8        *data;
+    gsize                len;
 
-    if (!is_non_at_response (buffer->data, buffer->len))
+    data = mm_serial_buffer_peek (buffer, &len);
+    if (!is_non_at_response (data, len))
         return;
 
     g_assert (self->priv->task);
@@ -109,6 +109,15 @@ void mm_port_probe_set_result_qmi        (MMPortProbe *self,
 void mm_port_probe_set_result_mbim       (MMPortProbe *self,
                                           gboolean mbim);
 
+/* Probing results persistence */
+void     mm_port_probe_save_results (MMPortProbe  *self,
+                                     GKeyFile     *keyfile,
+                                     const gchar  *group);
+gboolean mm_port_probe_load_results (MMPortProbe  *self,
+                                     GKeyFile     *keyfile,
+                                     const gchar  *group,
+                                     GError      **error);
+
 /* Run probing */
 void     mm_port_probe_run        (MMPortProbe *self,
                                    MMPortProbeFlag flags,
@@ -43,6 +43,11 @@ struct _MMPortSerialAtPrivate {
 
     GSList *unsolicited_msg_handlers;
 
+    /* Line tokenizer state for unsolicited message parsing */
+    GArray   *urc_line_starts;
+    guint8    urc_line_first_chars[32];
+    gboolean  urc_lines_valid;
+
     MMPortSerialAtFlag flags;
 
     /* Properties */
@@ -96,34 +101,57 @@ mm_port_serial_at_set_response_parser (MMPortSerialAt *self,
     self->priv->response_parser_notify = notify;
 }
 
-void
-mm_port_serial_at_remove_echo (GByteArray *response)
+/* Returns the amount of bytes to skip in the beginning of the response */
+static gsize
+echo_len (const guint8 *data,
+          gsize         len)
 {
-    guint i;
+    gsize i;
 
-    if (response->len <= 2)
-        return;
+    if (len <= 2)
+        return 0;
 
-    for (i = 0; i < (response->len - 1); i++) {
+    for (i = 0; i < (len - 1); i++) {
         /* If there is any content before the first
          * <CR><LF>, assume it's echo or garbage, and skip it */
-        if (response->data[i] == '\r' && response->data[i + 1] == '\n') {
-            if (i > 0)
-                g_byte_array_remove_range (response, 0, i);
-            /* else, good, we're already started with <CR><LF> */
-            break;
-        }
+        if (data[i] == '\r' && data[i + 1] == '\n')
+            return i;
     }
+    return 0;
+}
+
+void
+mm_port_serial_at_remove_echo (GByteArray *response)
+{
+    gsize len;
+
+    len = echo_len (response->data, response->len);
+    if (len > 0)
+        g_byte_array_remove_range (response, 0, len);
+}
+
+static void
+remove_echo (MMSerialBuffer *response)
+{
+    const guint8 *data;
+    gsize         len;
+
+    data = mm_serial_buffer_peek (response, &len);
+    len = echo_len (data, len);
+    if (len > 0)
+        mm_serial_buffer_consume (response, len);
 }
 
 static MMPortSerialResponseType
 parse_response (MMPortSerial *port,
-                GByteArray *response,
+                MMSerialBuffer *response,
                 GByteArray **parsed_response,
                 GError **error)
 {
     MMPortSerialAt *self = MM_PORT_SERIAL_AT (port);
     GString *string;
+    const guint8 *data;
+    gsize len;
     gsize parsed_len;
     GError *inner_error = NULL;
 
@@ -131,26 +159,27 @@ parse_response (MMPortSerial *port,
 
     /* Remove echo */
     if (self->priv->remove_echo)
-        mm_port_serial_at_remove_echo (response);
+        remove_echo (response);
 
     /* If there's no response to receive, we're done; e.g. if we only got
      * unsolicited messages */
-    if (!response->len)
+    data = mm_serial_buffer_peek (response, &len);
+    if (!len)
         return MM_PORT_SERIAL_RESPONSE_NONE;
 
     /* Construct the string that AT-parsing functions expect */
-    string = g_string_sized_new (response->len + 1);
-    g_string_append_len (string, (const char *) response->data, response->len);
+    string = g_string_sized_new (len + 1);
+    g_string_append_len (string, (const char *) data, len);
 
-    /* Fully cleanup the response array, we'll consider the contents we got
+    /* Fully cleanup the response buffer, we'll consider the contents we got
      * as the full reply that the command may expect. */
-    g_byte_array_remove_range (response, 0, response->len);
+    mm_serial_buffer_clear (response);
 
     /* Parse it; returns FALSE if there is nothing we can do with this
      * response yet. */
     if (!self->priv->response_parser_fn (self->priv->response_parser_user_data, string, self, &inner_error)) {
         /* Copy what we got back in the response buffer. */
-        g_byte_array_append (response, (const guint8 *) string->str, string->len);
+        mm_serial_buffer_append (response, (const guint8 *) string->str, string->len);
         g_string_free (string, TRUE);
         return MM_PORT_SERIAL_RESPONSE_NONE;
     }
@@ -172,12 +201,107 @@ parse_response (MMPortSerial *port,
 
 typedef struct {
     GRegex *regex;
+    /* Literal text every match must have right after a leading <CR><LF>,
+     * or NULL if none could be derived from the regex pattern */
+    gchar *prefix;
+    gsize prefix_len;
     MMPortSerialAtUnsolicitedMsgFn callback;
     gboolean enable;
     gpointer user_data;
     GDestroyNotify notify;
 } MMAtUnsolicitedMsgHandler;
 
+/* Most URC regexes are of the form "\r\n\+CREG:(.*)\r\n", i.e. they require
+ * a fixed tag right at the beginning of a line. If we're able to know that tag
+ * in advance, we can skip running the regex completely when no line in the
+ * buffer starts with it. */
+static gchar *
+unsolicited_msg_handler_build_prefix (GRegex *regex)
+{
+    const gchar *pattern;
+    const gchar *p;
+    GString     *prefix;
+    gint         depth = 0;
+
+    /* Case-insensitive or extended (whitespace-ignoring) patterns cannot be
+     * compared byte by byte */
+    if (g_regex_get_compile_flags (regex) & (G_REGEX_CASELESS | G_REGEX_EXTENDED))
+        return NULL;
+
+    pattern = g_regex_get_pattern (regex);
+    if (!g_str_has_prefix (pattern, "\\r\\n"))
+        return NULL;
+
+    /* A top-level alternation means the leading <CR><LF> is not required
+     * in every match */
+    for (p = pattern; *p; p++) {
+        if (*p == '\\') {
+            if (!*(++p))
+                break;
+        } else if (*p == '[') {
+            p++;
+            if (*p == '^')
+                p++;
+            if (*p == ']')
+                p++;
+            while (*p && *p != ']') {
+                if (*p == '\\' && p[1])
+                    p++;
+                p++;
+            }
+            if (!*p)
+                break;
+        } else if (*p == '(')
+            depth++;
+        else if (*p == ')')
+            depth--;
+        else if (*p == '|' && depth == 0)
+            return NULL;
+    }
+
+    prefix = g_string_new (NULL);
+    for (p = pattern + strlen ("\\r\\n"); *p; ) {
+        const gchar *next;
+        gchar        c;
+
+        if (*p == '\\') {
+            /* Character types (\s, \d...) and back references end the literal */
+            if (!p[1] || g_ascii_isalnum (p[1]))
+                break;
+            c = p[1];
+            next = p + 2;
+        } else if (strchr (".[]()|?*+{}^$", *p))
+            break;
+        else {
+            c = *p;
+            next = p + 1;
+        }
+
+        /* A quantifier allowing zero repetitions makes this char optional */
+        if (*next == '?' || *next == '*' || *next == '{')
+            break;
+
+        g_string_append_c (prefix, c);
+        p = next;
+    }
+
+    if (!prefix->len) {
+        g_string_free (prefix, TRUE);
+        return NULL;
+    }
+    return g_string_free (prefix, FALSE);
+}
+
+static void
+unsolicited_msg_handler_free (MMAtUnsolicitedMsgHandler *handler)
+{
+    if (handler->notify)
+        handler->notify (handler->user_data);
+    g_regex_unref (handler->regex);
+    g_free (handler->prefix);
+    g_slice_free (MMAtUnsolicitedMsgHandler, handler);
+}
+
 static gint
 unsolicited_msg_handler_cmp (MMAtUnsolicitedMsgHandler *handler,
                              GRegex *regex)
@@ -213,6 +337,8 @@ mm_port_serial_at_add_unsolicited_msg_handler (MMPortSerialAt *self,
          * plugin. */
         handler = g_slice_new (MMAtUnsolicitedMsgHandler);
         handler->regex = g_regex_ref (regex);
+        handler->prefix = unsolicited_msg_handler_build_prefix (regex);
+        handler->prefix_len = handler->prefix ? strlen (handler->prefix) : 0;
         self->priv->unsolicited_msg_handlers = g_slist_prepend (self->priv->unsolicited_msg_handlers, handler);
     }
 
@@ -257,27 +383,102 @@ remove_eval_cb (const GMatchInfo *match_info,
     return FALSE;
 }
 
+/* Single pass over the buffer to find where each complete line starts, i.e.
+ * the offsets right after every <CR><LF>, plus a bitmap of the first chars
+ * found in those lines so that most handlers are discarded without even
+ * looking at the line list. */
+static void
+urc_lines_tokenize (MMPortSerialAt *self,
+                    const guint8   *data,
+                    gsize           len)
+{
+    guint i;
+
+    g_array_set_size (self->priv->urc_line_starts, 0);
+    memset (self->priv->urc_line_first_chars, 0, sizeof (self->priv->urc_line_first_chars));
+
+    for (i = 0; i + 2 < len; i++) {
+        const guint8 *cr;
+        guint         line_start;
+        guint8        first;
+
+        cr = memchr (&data[i], '\r', len - 2 - i);
+        if (!cr)
+            break;
+        i = cr - data;
+        if (data[i + 1] != '\n')
+            continue;
+
+        line_start = i + 2;
+        first = data[line_start];
+        g_array_append_val (self->priv->urc_line_starts, line_start);
+        self->priv->urc_line_first_chars[first >> 3] |= (1 << (first & 7));
+        i++;
+    }
+
+    self->priv->urc_lines_valid = TRUE;
+}
+
+static gboolean
+urc_lines_have_prefix (MMPortSerialAt            *self,
+                       const guint8              *data,
+                       gsize                      len,
+                       MMAtUnsolicitedMsgHandler *handler)
+{
+    guint8 first;
+    guint  i;
+
+    if (!self->priv->urc_lines_valid)
+        urc_lines_tokenize (self, data, len);
+
+    first = (guint8) handler->prefix[0];
+    if (!(self->priv->urc_line_first_chars[first >> 3] & (1 << (first & 7))))
+        return FALSE;
+
+    for (i = 0; i < self->priv->urc_line_starts->len; i++) {
+        guint line_start;
+
+        line_start = g_array_index (self->priv->urc_line_starts, guint, i);
+        if ((len - line_start) >= handler->prefix_len &&
+            memcmp (&data[line_start], handler->prefix, handler->prefix_len) == 0)
+            return TRUE;
+    }
+    return FALSE;
+}
+
 static void
-parse_unsolicited (MMPortSerial *port, GByteArray *response)
+parse_unsolicited (MMPortSerial *port, MMSerialBuffer *response)
 {
     MMPortSerialAt *self = MM_PORT_SERIAL_AT (port);
     GSList *iter;
 
     /* Remove echo */
     if (self->priv->remove_echo)
-        mm_port_serial_at_remove_echo (response);
+        remove_echo (response);
+
+    /* Lines are tokenized lazily, only if there is any handler with prefix */
+    self->priv->urc_lines_valid = FALSE;
 
     for (iter = self->priv->unsolicited_msg_handlers; iter; iter = iter->next) {
         MMAtUnsolicitedMsgHandler *handler = (MMAtUnsolicitedMsgHandler *) iter->data;
         g_autoptr(GMatchInfo)      match_info = NULL;
         gboolean                   matches;
+        const guint8              *data;
+        gsize                      len;
 
         if (!handler->enable)
             continue;
 
+        data = mm_serial_buffer_peek (response, &len);
+
+        /* Skip the regex completely if the buffer has no line with the
+         * expected prefix */
+        if (handler->prefix && !urc_lines_have_prefix (self, data, len, handler))
+            continue;
+
         matches = g_regex_match_full (handler->regex,
-                                      (const char *) response->data,
-                                      response->len,
+                                      (const char *) data,
+                                      len,
                                       0, 0, &match_info, NULL);
         if (handler->callback) {
             while (g_match_info_matches (match_info)) {
@@ -289,16 +490,18 @@ parse_unsolicited (MMPortSerial *port, GByteArray *response)
         if (matches) {
             /* Remove matches */
             g_autofree gchar *str = NULL;
-            gint              result_len = response->len;
+            gint              result_len = len;
 
             str = g_regex_replace_eval (handler->regex,
-                                        (const char *) response->data,
-                                        response->len,
+                                        (const char *) data,
+                                        len,
                                         0, 0,
                                         remove_eval_cb, &result_len, NULL);
 
-            g_byte_array_remove_range (response, 0, response->len);
-            g_byte_array_append (response, (const guint8 *) str, result_len);
+            mm_serial_buffer_replace (response, (const guint8 *) str, result_len);
+
+            /* Buffer contents changed, line offsets need to be recomputed */
+            self->priv->urc_lines_valid = FALSE;
         }
     }
 }
@@ -524,6 +727,8 @@ mm_port_serial_at_init (MMPortSerialAt *self)
 {
     self->priv = G_TYPE_INSTANCE_GET_PRIVATE (self, MM_TYPE_PORT_SERIAL_AT, MMPortSerialAtPrivate);
 
+    self->priv->urc_line_starts = g_array_new (FALSE, FALSE, sizeof (guint));
+
     /* By default, remove echo */
     self->priv->remove_echo = TRUE;
     /* By default, run init sequence during first port opening */
@@ -594,13 +799,7 @@ finalize (GObject *object)
     MMPortSerialAt *self = MM_PORT_SERIAL_AT (object);
 
     while (self->priv->unsolicited_msg_handlers) {
-        MMAtUnsolicitedMsgHandler *handler = (MMAtUnsolicitedMsgHandler *) self->priv->unsolicited_msg_handlers->data;
-
-        if (handler->notify)
-            handler->notify (handler->user_data);
-
-        g_regex_unref (handler->regex);
-        g_slice_free (MMAtUnsolicitedMsgHandler, handler);
+        unsolicited_msg_handler_free ((MMAtUnsolicitedMsgHandler *) self->priv->unsolicited_msg_handlers->data);
         self->priv->unsolicited_msg_handlers = g_slist_delete_link (self->priv->unsolicited_msg_handlers,
                                                                     self->priv->unsolicited_msg_handlers);
     }
@@ -609,6 +808,7 @@ finalize (GObject *object)
         self->priv->response_parser_notify (self->priv->response_parser_user_data);
 
     g_strfreev (self->priv->init_sequence);
+    g_array_unref (self->priv->urc_line_starts);
 
     G_OBJECT_CLASS (mm_port_serial_at_parent_class)->finalize (object);
 }
@@ -32,16 +32,43 @@
 G_DEFINE_TYPE (MMPortSerialQcdm, mm_port_serial_qcdm, MM_TYPE_PORT_SERIAL)
 
 struct _MMPortSerialQcdmPrivate {
-    GSList *unsolicited_msg_handlers;
+    GSList                    *unsolicited_msg_handlers;
+    MMPortSerialQcdmFrameScan  frame_scan;
 };
 
 /*****************************************************************************/
 
-static gboolean
-find_qcdm_start (GByteArray *response, gsize *start)
+void
+mm_port_serial_qcdm_frame_scan_reset (MMPortSerialQcdmFrameScan *scan)
+{
+    scan->offset = 0;
+    scan->scanned = 0;
+    scan->last = -1;
+}
+
+gboolean
+mm_port_serial_qcdm_find_frame_start (MMPortSerialQcdmFrameScan *scan,
+                                      MMSerialBuffer            *buffer,
+                                      gsize                     *start)
 {
-    guint i;
-    gint  last = -1;
+    const guint8 *data;
+    const guint8 *marker;
+    gsize         len;
+    guint64       offset;
+    gsize         i;
+    gssize        last;
+
+    data = mm_serial_buffer_peek (buffer, &len);
+    offset = mm_serial_buffer_get_offset (buffer);
+
+    /* Restart from scratch if the pending data changed at the head */
+    if (scan->offset != offset || scan->scanned > len) {
+        scan->offset = offset;
+        scan->scanned = 0;
+        scan->last = -1;
+    }
+    i = scan->scanned;
+    last = scan->last;
 
     /* Look for 3 bytes and a QCDM frame marker, ie enough data for a valid
      * frame.  There will usually be three cases here; (1) a QCDM frame
@@ -49,33 +76,38 @@ find_qcdm_start (GByteArray *response, gsize *start)
      * with 0x7E and ending with 0x7E, and (3) a non-QCDM frame that still
      * uses HDLC framing (like Sierra CnS) that starts and ends with 0x7E.
      */
-    for (i = 0; i < response->len; i++) {
-        /* Marker found */
-        if (response->data[i] == 0x7E) {
-            /* If we didn't get an initial marker, count at least 3 bytes since
-             * origin; if we did get an initial marker, count at least 3 bytes
-             * since the marker.
-             */
-            if (((last == -1) && (i >= 3)) || ((last >= 0) && (i > (guint)(last + 3)))) {
-                /* Got a full QCDM frame; 3 non-0x7E bytes and a terminator */
-                if (start)
-                    *start = last + 1;
-                return TRUE;
-            }
-
-            /* Save position of the last QCDM frame marker */
-            last = i;
+    while ((marker = memchr (&data[i], DIAG_CONTROL_CHAR, len - i)) != NULL) {
+        i = marker - data;
+
+        /* If we didn't get an initial marker, count at least 3 bytes since
+         * origin; if we did get an initial marker, count at least 3 bytes
+         * since the marker.
+         */
+        if (((last == -1) && (i >= 3)) || ((last >= 0) && (i > (gsize)(last + 3)))) {
+            /* Got a full QCDM frame; 3 non-0x7E bytes and a terminator */
+            if (start)
+                *start = last + 1;
+            return TRUE;
         }
+
+        /* Save position of the last QCDM frame marker */
+        last = i++;
     }
+
+    scan->scanned = len;
+    scan->last = last;
     return FALSE;
 }
 
 static MMPortSerialResponseType
-parse_qcdm (GByteArray *response,
+parse_qcdm (MMSerialBuffer *response,
+            MMPortSerialQcdmFrameScan *scan,
             gboolean want_log,
             GByteArray **parsed_response,
             GError **error)
 {
+    const guint8 *data;
+    gsize len;
     gsize start = 0;
     gsize used = 0;
     gsize unescaped_len = 0;
@@ -83,7 +115,7 @@ parse_qcdm (GByteArray *response,
     qcdmbool more = FALSE;
 
     /* Get the offset into the buffer of where the QCDM frame starts */
-    if (!find_qcdm_start (response, &start)) {
+    if (!mm_port_serial_qcdm_find_frame_start (scan, response, &start)) {
         /* Discard the unparsable data right away, we do need a QCDM
          * start, and anything that comes before it is unknown data
          * that we'll never use. */
@@ -91,14 +123,15 @@ parse_qcdm (GByteArray *response,
     }
 
     /* If there is anything before the start marker, remove it */
-    g_byte_array_remove_range (response, 0, start);
-    if (response->len == 0)
+    mm_serial_buffer_consume (response, start);
+    data = mm_serial_buffer_peek (response, &len);
+    if (len == 0)
         return MM_PORT_SERIAL_RESPONSE_NONE;
 
     /* Try to decapsulate the response into a buffer */
     unescaped_buffer = g_malloc (1024);
-    if (!dm_decapsulate_buffer ((const char *)(response->data),
-                                response->len,
+    if (!dm_decapsulate_buffer ((const char *)data,
+                                len,
                                 (char *)unescaped_buffer,
                                 1024,
                                 &unescaped_len,
@@ -139,17 +172,21 @@ parse_qcdm (GByteArray *response,
     /* Remove the data we used from the input buffer, leaving out any
      * additional data that may already been received (e.g. from the following
      * message). */
-    g_byte_array_remove_range (response, 0, used);
+    mm_serial_buffer_consume (response, used);
     return MM_PORT_SERIAL_RESPONSE_BUFFER;
 }
 
 static MMPortSerialResponseType
 parse_response (MMPortSerial *port,
-                GByteArray *response,
+                MMSerialBuffer *response,
                 GByteArray **parsed_response,
                 GError **error)
 {
-    return parse_qcdm (response, FALSE, parsed_response, error);
+    return parse_qcdm (response,
+                       &MM_PORT_SERIAL_QCDM (port)->priv->frame_scan,
+                       FALSE,
+                       parsed_response,
+                       error);
 }
 
 /*****************************************************************************/
@@ -297,13 +334,14 @@ mm_port_serial_qcdm_enable_unsolicited_msg_handler (MMPortSerialQcdm *self,
 }
 
 static void
-parse_unsolicited (MMPortSerial *port, GByteArray *response)
+parse_unsolicited (MMPortSerial *port, MMSerialBuffer *response)
 {
     MMPortSerialQcdm *self = MM_PORT_SERIAL_QCDM (port);
     GByteArray *log_buffer = NULL;
     GSList *iter;
 
     if (parse_qcdm (response,
+                    &self->priv->frame_scan,
                     TRUE,
                     &log_buffer,
                     NULL) != MM_PORT_SERIAL_RESPONSE_BUFFER) {
@@ -383,6 +421,7 @@ static void
 mm_port_serial_qcdm_init (MMPortSerialQcdm *self)
 {
     self->priv = G_TYPE_INSTANCE_GET_PRIVATE (self, MM_TYPE_PORT_SERIAL_QCDM, MMPortSerialQcdmPrivate);
+    mm_port_serial_qcdm_frame_scan_reset (&self->priv->frame_scan);
 }
 
 static void
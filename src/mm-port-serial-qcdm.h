@@ -73,4 +73,20 @@ void     mm_port_serial_qcdm_enable_unsolicited_msg_handler (MMPortSerialQcdm *s
                                                              guint log_code,
                                                              gboolean enable);
 
+/* Frame detection state, so that the data received while waiting for the
+ * rest of a frame is only scanned once. Exposed for the unit tests. */
+typedef struct {
+    /* Stream offset of the pending data when it was scanned */
+    guint64 offset;
+    /* Amount of pending data already scanned without finding a frame */
+    gsize   scanned;
+    /* Position of the last frame marker found, -1 if none */
+    gssize  last;
+} MMPortSerialQcdmFrameScan;
+
+void     mm_port_serial_qcdm_frame_scan_reset (MMPortSerialQcdmFrameScan *scan);
+gboolean mm_port_serial_qcdm_find_frame_start (MMPortSerialQcdmFrameScan *scan,
+                                               MMSerialBuffer            *buffer,
+                                               gsize                     *start);
+
 #endif /* MM_PORT_SERIAL_QCDM_H */
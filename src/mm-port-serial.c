@@ -34,6 +34,7 @@
 #include <mm-errors-types.h>
 
 #include "mm-port-serial.h"
+#include "mm-serial-trace.h"
 #include "mm-log-object.h"
 #include "mm-helper-enums-types.h"
 
@@ -59,6 +60,7 @@ enum {
     PROP_FD,
     PROP_SPEW_CONTROL,
     PROP_FLASH_OK,
+    PROP_BURST_WRITE,
 
     LAST_PROP
 };
@@ -79,7 +81,7 @@ struct _MMPortSerialPrivate {
     int fd;
     GHashTable *reply_cache;
     GQueue *queue;
-    GByteArray *response;
+    MMSerialBuffer *response;
 
     /* For real ports, iochannel, and we implement the eagain limit */
     GIOChannel *iochannel;
@@ -98,6 +100,11 @@ struct _MMPortSerialPrivate {
     guint64 send_delay;
     gboolean spew_control;
     gboolean flash_ok;
+    gboolean burst_write;
+
+    /* Always-on binary trace of the port traffic, created on first use */
+    MMSerialTrace *trace;
+    gboolean trace_disabled;
 
     guint queue_id;
     guint timeout_id;
@@ -169,7 +176,7 @@ mm_port_serial_command (MMPortSerial *self,
     ctx->timeout = timeout_seconds;
 
     /* Only accept about 3 seconds of EAGAIN for this command */
-    if (self->priv->send_delay && mm_port_get_subsys (MM_PORT (self)) == MM_PORT_SUBSYS_TTY)
+    if (self->priv->send_delay && !self->priv->burst_write && mm_port_get_subsys (MM_PORT (self)) == MM_PORT_SUBSYS_TTY)
         ctx->eagain_count = 3000000 / self->priv->send_delay;
     else
         ctx->eagain_count = 1000;
@@ -508,13 +515,23 @@ real_config_fd (MMPortSerial *self, int fd, GError **error)
 }
 
 static void
-serial_debug (MMPortSerial *self,
-              const gchar  *prefix,
-              const gchar  *buf,
-              gsize         len)
+serial_debug (MMPortSerial           *self,
+              MMSerialTraceDirection  direction,
+              const gchar            *buf,
+              gsize                   len)
 {
+    const gchar *prefix;
+
     g_return_if_fail (len > 0);
 
+    if (!self->priv->trace && !self->priv->trace_disabled) {
+        self->priv->trace = mm_serial_trace_new (mm_port_get_device (MM_PORT (self)));
+        self->priv->trace_disabled = !self->priv->trace;
+    }
+    if (self->priv->trace)
+        mm_serial_trace_add (self->priv->trace, direction, (const guint8 *) buf, len);
+
+    prefix = (direction == MM_SERIAL_TRACE_DIRECTION_OUT) ? "-->" : "<--";
     if (MM_PORT_SERIAL_GET_CLASS (self)->debug_log)
         MM_PORT_SERIAL_GET_CLASS (self)->debug_log (self, prefix, buf, len);
 }
@@ -543,10 +560,14 @@ port_serial_process_command (MMPortSerial *self,
     /* Only print command the first time */
     if (ctx->started == FALSE) {
         ctx->started = TRUE;
-        serial_debug (self, "-->", (const gchar *) ctx->command->data, ctx->command->len);
+        serial_debug (self, MM_SERIAL_TRACE_DIRECTION_OUT, (const gchar *) ctx->command->data, ctx->command->len);
     }
 
-    if (self->priv->send_delay == 0 || mm_port_get_subsys (MM_PORT (self)) != MM_PORT_SUBSYS_TTY) {
+    if (self->priv->burst_write && mm_port_get_subsys (MM_PORT (self)) == MM_PORT_SUBSYS_TTY) {
+        /* Send all the pending bytes of the command in one write */
+        send_len = (gssize)(ctx->command->len - ctx->idx);
+        p = (gchar *)&ctx->command->data[ctx->idx];
+    } else if (self->priv->send_delay == 0 || mm_port_get_subsys (MM_PORT (self)) != MM_PORT_SUBSYS_TTY) {
         /* Send the whole command in one write */
         send_len = (gssize)ctx->command->len;
         p = (gchar *)ctx->command->data;
@@ -671,6 +692,33 @@ port_serial_get_cached_reply (MMPortSerial *self,
     return (const GByteArray *)g_hash_table_lookup (self->priv->reply_cache, command);
 }
 
+static gboolean
+port_serial_output_available (GIOChannel   *iochannel,
+                              GIOCondition  condition,
+                              gpointer      data)
+{
+    return port_serial_queue_process (data);
+}
+
+/* In burst write mode, instead of retrying after a fixed delay when the
+ * TTY cannot take all the pending bytes, wait until it is writable again */
+static void
+port_serial_schedule_queue_process_writable (MMPortSerial *self)
+{
+    if (self->priv->timeout_id || self->priv->queue_id)
+        return;
+
+    if (!self->priv->iochannel) {
+        port_serial_schedule_queue_process (self, 0);
+        return;
+    }
+
+    self->priv->queue_id = g_io_add_watch (self->priv->iochannel,
+                                           G_IO_OUT | G_IO_ERR | G_IO_HUP,
+                                           port_serial_output_available,
+                                           self);
+}
+
 static void
 port_serial_schedule_queue_process (MMPortSerial *self, guint timeout_ms)
 {
@@ -837,6 +885,12 @@ port_serial_queue_process (gpointer data)
         return G_SOURCE_REMOVE;
     }
 
+    /* Schedule the next chunk of the command to be sent */
+    if (!ctx->done && self->priv->burst_write && mm_port_get_subsys (MM_PORT (self)) == MM_PORT_SUBSYS_TTY) {
+        port_serial_schedule_queue_process_writable (self);
+        return G_SOURCE_REMOVE;
+    }
+
     /* Schedule the next byte of the command to be sent */
     if (!ctx->done) {
         port_serial_schedule_queue_process (self,
@@ -930,7 +984,7 @@ static gboolean
 common_input_available (MMPortSerial *self,
                         GIOCondition condition)
 {
-    char buf[SERIAL_BUF_SIZE + 1];
+    gchar *buf;
     gsize bytes_read;
     GIOStatus status = G_IO_STATUS_NORMAL;
     CommandContext *ctx;
@@ -941,8 +995,7 @@ common_input_available (MMPortSerial *self,
 
     if (condition & G_IO_HUP) {
         mm_obj_dbg (self, "unexpected port hangup!");
-        if (self->priv->response->len)
-            g_byte_array_remove_range (self->priv->response, 0, self->priv->response->len);
+        mm_serial_buffer_clear (self->priv->response);
         /* The completion of the commands with an error may end up fully disposing the
          * serial port object. In order to cope with that, we make sure we have
          * our own reference to the object while the close runs. */
@@ -955,8 +1008,7 @@ common_input_available (MMPortSerial *self,
     }
 
     if (condition & G_IO_ERR) {
-        if (self->priv->response->len)
-            g_byte_array_remove_range (self->priv->response, 0, self->priv->response->len);
+        mm_serial_buffer_clear (self->priv->response);
         return G_SOURCE_CONTINUE;
     }
 
@@ -969,6 +1021,9 @@ common_input_available (MMPortSerial *self,
     while (iterate) {
         bytes_read = 0;
 
+        /* Read directly into the response buffer */
+        buf = (gchar *) mm_serial_buffer_reserve (self->priv->response, SERIAL_BUF_SIZE);
+
         if (self->priv->iochannel) {
             status = g_io_channel_read_chars (self->priv->iochannel,
                                               buf,
@@ -1007,8 +1062,8 @@ common_input_available (MMPortSerial *self,
             break;
 
         g_assert (bytes_read > 0);
-        serial_debug (self, "<--", buf, bytes_read);
-        g_byte_array_append (self->priv->response, (const guint8 *) buf, bytes_read);
+        serial_debug (self, MM_SERIAL_TRACE_DIRECTION_IN, buf, bytes_read);
+        mm_serial_buffer_commit (self->priv->response, bytes_read);
 
         /* See if we can parse anything. The response parsing may actually
          * schedule the completion of a serial command, and that in turn may end
@@ -1019,10 +1074,10 @@ common_input_available (MMPortSerial *self,
         g_object_ref (self);
         {
             /* Make sure the response doesn't grow too long */
-            if ((self->priv->response->len > SERIAL_BUF_SIZE) && self->priv->spew_control) {
+            if ((mm_serial_buffer_get_len (self->priv->response) > SERIAL_BUF_SIZE) && self->priv->spew_control) {
                 /* Notify listeners and then trim the buffer */
                 g_signal_emit (self, signals[BUFFER_FULL], 0, self->priv->response);
-                g_byte_array_remove_range (self->priv->response, 0, (SERIAL_BUF_SIZE / 2));
+                mm_serial_buffer_consume (self->priv->response, (SERIAL_BUF_SIZE / 2));
             }
 
             parse_response_buffer (self);
@@ -1957,7 +2012,7 @@ mm_port_serial_init (MMPortSerial *self)
     self->priv->send_delay = 1000;
 
     self->priv->queue = g_queue_new ();
-    self->priv->response = g_byte_array_sized_new (500);
+    self->priv->response = mm_serial_buffer_new (2 * SERIAL_BUF_SIZE);
 }
 
 static void
@@ -1996,6 +2051,9 @@ set_property (GObject *object,
     case PROP_FLASH_OK:
         self->priv->flash_ok = g_value_get_boolean (value);
         break;
+    case PROP_BURST_WRITE:
+        self->priv->burst_write = g_value_get_boolean (value);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
         break;
@@ -2038,6 +2096,9 @@ get_property (GObject *object,
     case PROP_FLASH_OK:
         g_value_set_boolean (value, self->priv->flash_ok);
         break;
+    case PROP_BURST_WRITE:
+        g_value_set_boolean (value, self->priv->burst_write);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
         break;
@@ -2065,7 +2126,8 @@ finalize (GObject *object)
         g_source_remove (self->priv->queue_id);
 
     g_hash_table_destroy (self->priv->reply_cache);
-    g_byte_array_unref (self->priv->response);
+    mm_serial_buffer_free (self->priv->response);
+    mm_serial_trace_free (self->priv->trace);
     g_queue_free (self->priv->queue);
 
     G_OBJECT_CLASS (mm_port_serial_parent_class)->finalize (object);
@@ -2160,6 +2222,15 @@ mm_port_serial_class_init (MMPortSerialClass *klass)
                                TRUE,
                                G_PARAM_READWRITE));
 
+    g_object_class_install_property
+        (object_class, PROP_BURST_WRITE,
+         g_param_spec_boolean (MM_PORT_SERIAL_BURST_WRITE,
+                               "BurstWrite",
+                               "Commands are written to the TTY in as few writes "
+                               "as possible, ignoring the send delay.",
+                               FALSE,
+                               G_PARAM_READWRITE));
+
     /* Signals */
     signals[BUFFER_FULL] =
         g_signal_new ("buffer-full",
@@ -23,6 +23,7 @@
 
 #include "mm-modem-helpers.h"
 #include "mm-port.h"
+#include "mm-serial-buffer.h"
 
 #define MM_TYPE_PORT_SERIAL            (mm_port_serial_get_type ())
 #define MM_PORT_SERIAL(obj)            (G_TYPE_CHECK_INSTANCE_CAST ((obj), MM_TYPE_PORT_SERIAL, MMPortSerial))
@@ -40,6 +41,7 @@
 #define MM_PORT_SERIAL_FD           "fd" /* Construct-only */
 #define MM_PORT_SERIAL_SPEW_CONTROL "spew-control"
 #define MM_PORT_SERIAL_FLASH_OK     "flash-ok"
+#define MM_PORT_SERIAL_BURST_WRITE  "burst-write"
 
 typedef enum {
     MM_PORT_SERIAL_RESPONSE_NONE,
@@ -61,9 +63,9 @@ struct _MMPortSerialClass {
 
     /* Called for subclasses to parse unsolicited responses.  If any recognized
      * unsolicited response is found, it should be removed from the 'response'
-     * byte array before returning.
+     * buffer before returning.
      */
-    void     (*parse_unsolicited) (MMPortSerial *self, GByteArray *response);
+    void     (*parse_unsolicited) (MMPortSerial *self, MMSerialBuffer *response);
 
     /*
      * Called to parse the device's response to a command or determine if the
@@ -78,11 +80,11 @@ struct _MMPortSerialClass {
      * If there is no response, @MM_PORT_SERIAL_RESPONSE_NONE will be returned,
      * and neither @error nor @parsed_response will be set.
      *
-     * The implementation is allowed to cleanup the @response byte array, e.g. to
+     * The implementation is allowed to cleanup the @response buffer, e.g. to
      * just remove 1 single response if more than one found.
      */
     MMPortSerialResponseType (*parse_response) (MMPortSerial *self,
-                                                GByteArray *response,
+                                                MMSerialBuffer *response,
                                                 GByteArray **parsed_response,
                                                 GError **error);
 
@@ -101,7 +103,7 @@ struct _MMPortSerialClass {
                                    gsize         len);
 
     /* Signals */
-    void (*buffer_full)           (MMPortSerial *port, const GByteArray *buffer);
+    void (*buffer_full)           (MMPortSerial *port, const MMSerialBuffer *buffer);
     void (*forced_close)          (MMPortSerial *port);
 };
 
@@ -0,0 +1,189 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 Telit
+ */
+
+#include "mm-property-batch.h"
+
+typedef struct {
+    GObject     *object;
+    /* Interned */
+    const gchar *property;
+    GValue       value;
+} PendingUpdate;
+
+struct _MMPropertyBatch {
+    guint       window_ms;
+    guint       timeout_id;
+    /* Pending updates, in the order they were first set */
+    GPtrArray  *pending;
+};
+
+static void
+pending_update_free (PendingUpdate *update)
+{
+    g_value_unset (&update->value);
+    g_object_unref (update->object);
+    g_slice_free (PendingUpdate, update);
+}
+
+MMPropertyBatch *
+mm_property_batch_new (guint window_ms)
+{
+    MMPropertyBatch *self;
+
+    self = g_slice_new0 (MMPropertyBatch);
+    self->window_ms = window_ms;
+    self->pending = g_ptr_array_new_with_free_func ((GDestroyNotify) pending_update_free);
+    return self;
+}
+
+void
+mm_property_batch_free (MMPropertyBatch *self)
+{
+    if (!self)
+        return;
+
+    /* Pending updates are discarded */
+    if (self->timeout_id)
+        g_source_remove (self->timeout_id);
+    g_ptr_array_unref (self->pending);
+    g_slice_free (MMPropertyBatch, self);
+}
+
+/*****************************************************************************/
+
+static PendingUpdate *
+pending_update_lookup (MMPropertyBatch *self,
+                       gpointer         object,
+                       const gchar     *property)
+{
+    guint i;
+
+    /* Only a handful of properties are batched, so a plain array is enough */
+    property = g_intern_string (property);
+    for (i = 0; i < self->pending->len; i++) {
+        PendingUpdate *update;
+
+        update = g_ptr_array_index (self->pending, i);
+        if (update->object == object && update->property == property)
+            return update;
+    }
+    return NULL;
+}
+
+void
+mm_property_batch_flush (MMPropertyBatch *self)
+{
+    g_autoptr(GPtrArray) pending = NULL;
+    guint                i;
+
+    if (self->timeout_id) {
+        g_source_remove (self->timeout_id);
+        self->timeout_id = 0;
+    }
+
+    /* Setting the properties may trigger new updates, so take the
+     * current ones out first */
+    pending = self->pending;
+    self->pending = g_ptr_array_new_with_free_func ((GDestroyNotify) pending_update_free);
+
+    for (i = 0; i < pending->len; i++) {
+        PendingUpdate *update;
+
+        update = g_ptr_array_index (pending, i);
+        g_object_set_property (update->object, update->property, &update->value);
+    }
+}
+
+static gboolean
+batch_window_expired (MMPropertyBatch *self)
+{
+    self->timeout_id = 0;
+    mm_property_batch_flush (self);
+    return G_SOURCE_REMOVE;
+}
+
+void
+mm_property_batch_set (MMPropertyBatch *self,
+                       gpointer         object,
+                       const gchar     *property,
+                       const GValue    *value)
+{
+    PendingUpdate *update;
+
+    g_assert (G_IS_OBJECT (object));
+
+    if (!self->window_ms) {
+        g_object_set_property (G_OBJECT (object), property, value);
+        return;
+    }
+
+    update = pending_update_lookup (self, object, property);
+    if (update)
+        g_value_unset (&update->value);
+    else {
+        update = g_slice_new0 (PendingUpdate);
+        update->object = g_object_ref (object);
+        update->property = g_intern_string (property);
+        g_ptr_array_add (self->pending, update);
+    }
+    g_value_init (&update->value, G_VALUE_TYPE (value));
+    g_value_copy (value, &update->value);
+
+    if (!self->timeout_id)
+        self->timeout_id = g_timeout_add (self->window_ms, (GSourceFunc) batch_window_expired, self);
+}
+
+void
+mm_property_batch_set_uint (MMPropertyBatch *self,
+                            gpointer         object,
+                            const gchar     *property,
+                            guint            value)
+{
+    g_auto(GValue) gvalue = G_VALUE_INIT;
+
+    g_value_init (&gvalue, G_TYPE_UINT);
+    g_value_set_uint (&gvalue, value);
+    mm_property_batch_set (self, object, property, &gvalue);
+}
+
+void
+mm_property_batch_set_variant (MMPropertyBatch *self,
+                               gpointer         object,
+                               const gchar     *property,
+                               GVariant        *value)
+{
+    g_auto(GValue) gvalue = G_VALUE_INIT;
+
+    g_value_init (&gvalue, G_TYPE_VARIANT);
+    g_value_set_variant (&gvalue, value);
+    mm_property_batch_set (self, object, property, &gvalue);
+}
+
+gboolean
+mm_property_batch_peek (MMPropertyBatch *self,
+                        gpointer         object,
+                        const gchar     *property,
+                        GValue          *value)
+{
+    PendingUpdate *update;
+
+    update = pending_update_lookup (self, object, property);
+    if (!update)
+        return FALSE;
+
+    g_value_init (value, G_VALUE_TYPE (&update->value));
+    g_value_copy (&update->value, value);
+    return TRUE;
+}
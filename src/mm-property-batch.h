@@ -0,0 +1,68 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 Telit
+ */
+
+#ifndef MM_PROPERTY_BATCH_H
+#define MM_PROPERTY_BATCH_H
+
+#include <glib.h>
+#include <glib-object.h>
+
+/*
+ * Batching of property updates.
+ *
+ * Updates of frequently changing properties (e.g. signal quality) are kept
+ * pending during a time window, and applied all together once it expires.
+ * When applied to D-Bus interface skeletons, all the updates of the same
+ * interface end up in a single PropertiesChanged signal.
+ *
+ * Pending values must be looked up with mm_property_batch_peek() before
+ * reading the property value from the object itself. Pending values should
+ * be flushed before updating a critical property (e.g. modem state), so that
+ * clients see the updates in order.
+ *
+ * A window of 0 disables batching, updates are applied right away.
+ */
+
+typedef struct _MMPropertyBatch MMPropertyBatch;
+
+MMPropertyBatch *mm_property_batch_new         (guint            window_ms);
+void             mm_property_batch_free        (MMPropertyBatch *self);
+
+void             mm_property_batch_set         (MMPropertyBatch *self,
+                                                gpointer         object,
+                                                const gchar     *property,
+                                                const GValue    *value);
+void             mm_property_batch_set_uint    (MMPropertyBatch *self,
+                                                gpointer         object,
+                                                const gchar     *property,
+                                                guint            value);
+/* Floating references are sunk */
+void             mm_property_batch_set_variant (MMPropertyBatch *self,
+                                                gpointer         object,
+                                                const gchar     *property,
+                                                GVariant        *value);
+
+/* Returns TRUE and initializes value if there is a pending update */
+gboolean         mm_property_batch_peek        (MMPropertyBatch *self,
+                                                gpointer         object,
+                                                const gchar     *property,
+                                                GValue          *value);
+
+/* Applies all pending updates right away */
+void             mm_property_batch_flush       (MMPropertyBatch *self);
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (MMPropertyBatch, mm_property_batch_free)
+
+#endif /* MM_PROPERTY_BATCH_H */
@@ -0,0 +1,151 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 Telit
+ */
+
+#include <string.h>
+
+#include "mm-serial-buffer.h"
+
+struct _MMSerialBuffer {
+    guint8 *data;
+    gsize   size;
+    /* Read cursor */
+    gsize   head;
+    /* Write cursor */
+    gsize   tail;
+    /* Bytes dropped from the head so far */
+    guint64 offset;
+};
+
+MMSerialBuffer *
+mm_serial_buffer_new (gsize size)
+{
+    MMSerialBuffer *self;
+
+    self = g_slice_new0 (MMSerialBuffer);
+    self->size = size ? size : 1;
+    self->data = g_malloc (self->size);
+    return self;
+}
+
+void
+mm_serial_buffer_free (MMSerialBuffer *self)
+{
+    g_free (self->data);
+    g_slice_free (MMSerialBuffer, self);
+}
+
+const guint8 *
+mm_serial_buffer_peek (const MMSerialBuffer *self,
+                       gsize                *len)
+{
+    if (len)
+        *len = self->tail - self->head;
+    return &self->data[self->head];
+}
+
+gsize
+mm_serial_buffer_get_len (const MMSerialBuffer *self)
+{
+    return self->tail - self->head;
+}
+
+guint64
+mm_serial_buffer_get_offset (const MMSerialBuffer *self)
+{
+    return self->offset;
+}
+
+guint8 *
+mm_serial_buffer_reserve (MMSerialBuffer *self,
+                          gsize           len)
+{
+    gsize pending;
+
+    if ((self->size - self->tail) >= len)
+        return &self->data[self->tail];
+
+    pending = self->tail - self->head;
+
+    /* Grow the storage only if moving the pending data to the beginning of
+     * the storage wouldn't give us enough room */
+    if ((self->size - pending) < len) {
+        gsize new_size;
+
+        new_size = self->size;
+        while ((new_size - pending) < len)
+            new_size *= 2;
+        self->data = g_realloc (self->data, new_size);
+        self->size = new_size;
+    }
+
+    if (self->head > 0) {
+        memmove (self->data, &self->data[self->head], pending);
+        self->head = 0;
+        self->tail = pending;
+    }
+    return &self->data[self->tail];
+}
+
+void
+mm_serial_buffer_commit (MMSerialBuffer *self,
+                         gsize           len)
+{
+    g_assert (len <= (self->size - self->tail));
+    self->tail += len;
+}
+
+void
+mm_serial_buffer_append (MMSerialBuffer *self,
+                         const guint8   *data,
+                         gsize           len)
+{
+    guint8 *dest;
+
+    if (!len)
+        return;
+
+    dest = mm_serial_buffer_reserve (self, len);
+    memmove (dest, data, len);
+    mm_serial_buffer_commit (self, len);
+}
+
+void
+mm_serial_buffer_consume (MMSerialBuffer *self,
+                          gsize           len)
+{
+    g_assert (len <= (self->tail - self->head));
+    self->head += len;
+    self->offset += len;
+
+    /* Rewind cursors for free when everything has been consumed */
+    if (self->head == self->tail)
+        self->head = self->tail = 0;
+}
+
+void
+mm_serial_buffer_clear (MMSerialBuffer *self)
+{
+    self->offset += self->tail - self->head;
+    self->head = self->tail = 0;
+}
+
+void
+mm_serial_buffer_replace (MMSerialBuffer *self,
+                          const guint8   *data,
+                          gsize           len)
+{
+    mm_serial_buffer_clear (self);
+    mm_serial_buffer_append (self, data, len);
+}
@@ -0,0 +1,67 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 Telit
+ */
+
+#ifndef MM_SERIAL_BUFFER_H
+#define MM_SERIAL_BUFFER_H
+
+#include <glib.h>
+
+/*
+ * Buffer for the data read from serial ports.
+ *
+ * Data is written at the tail (reserve + commit) and consumed from the head,
+ * and consuming just moves the read cursor, so removing already parsed data
+ * from the front of the buffer never moves the pending bytes around. The
+ * pending data is always contiguous, so parsers get a plain view of it.
+ * Pending data is only moved to the beginning of the storage when there is
+ * no more room at the tail for a new write.
+ */
+typedef struct _MMSerialBuffer MMSerialBuffer;
+
+MMSerialBuffer *mm_serial_buffer_new     (gsize                 size);
+void            mm_serial_buffer_free    (MMSerialBuffer       *self);
+
+/* Pending data */
+const guint8   *mm_serial_buffer_peek    (const MMSerialBuffer *self,
+                                          gsize                *len);
+gsize           mm_serial_buffer_get_len (const MMSerialBuffer *self);
+
+/* Position of the first pending byte in the whole stream of data written,
+ * so that parsers can tell whether data was dropped since they last looked */
+guint64         mm_serial_buffer_get_offset (const MMSerialBuffer *self);
+
+/* Writing: get room for at most 'len' bytes at the tail, and then commit how
+ * many of them were really written */
+guint8         *mm_serial_buffer_reserve (MMSerialBuffer       *self,
+                                          gsize                 len);
+void            mm_serial_buffer_commit  (MMSerialBuffer       *self,
+                                          gsize                 len);
+void            mm_serial_buffer_append  (MMSerialBuffer       *self,
+                                          const guint8         *data,
+                                          gsize                 len);
+
+/* Reading: drop bytes from the head */
+void            mm_serial_buffer_consume (MMSerialBuffer       *self,
+                                          gsize                 len);
+void            mm_serial_buffer_clear   (MMSerialBuffer       *self);
+
+/* Replace all pending data with new contents */
+void            mm_serial_buffer_replace (MMSerialBuffer       *self,
+                                          const guint8         *data,
+                                          gsize                 len);
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (MMSerialBuffer, mm_serial_buffer_free)
+
+#endif /* MM_SERIAL_BUFFER_H */
@@ -14,6 +14,8 @@
  * Copyright (C) 2009 Red Hat, Inc.
  */
 
+#define _GNU_SOURCE  /* for memmem() */
+
 #include <string.h>
 #include <stdlib.h>
 
@@ -50,50 +52,366 @@ response_clean (GString *response)
 }
 
 
+/*****************************************************************************/
+/* Final response matcher
+ *
+ * Instead of running one regex per possible final response, the response is
+ * scanned once, looking at the contents following every <CR><LF>, and the
+ * first occurrence of each known final response is recorded. The rules
+ * applied for each of them are the same ones the original regexes used:
+ *
+ *   OK:             "\r\nOK(\r\n)+"
+ *   CONNECT:        "\r\nCONNECT.*\r\n"
+ *   SMS prompt:     "\r\n>\s*$"
+ *   CME/CMS:        "\r\n\+CM[ES] ERROR:\s*(\d+)\r\n"
+ *                   "\r\n\+CM[ES] ERROR:\s*([^\n\r]+)\r\n"
+ *   EZX:            "\r\nMODEM ERROR:\s*(\d+)\r\n"
+ *   Unknown error:  "\r\nERROR" or "COMMAND NOT SUPPORT\r\n"
+ *   Connect failed: "\r\nNO CARRIER", "BUSY", "NO ANSWER" or "NO DIALTONE\r\n"
+ *   NA:             "\r\nNA\r\n"
+ */
+
+typedef enum {
+    RESPONSE_MATCH_OK,
+    RESPONSE_MATCH_CONNECT,
+    RESPONSE_MATCH_SMS_PROMPT,
+    RESPONSE_MATCH_CME_ERROR,
+    RESPONSE_MATCH_CMS_ERROR,
+    RESPONSE_MATCH_CME_ERROR_STR,
+    RESPONSE_MATCH_CMS_ERROR_STR,
+    RESPONSE_MATCH_EZX_ERROR,
+    RESPONSE_MATCH_UNKNOWN_ERROR,
+    RESPONSE_MATCH_NO_CARRIER,
+    RESPONSE_MATCH_NA,
+    RESPONSE_MATCH_LAST
+} ResponseMatchType;
+
+typedef struct {
+    gboolean found;
+    /* Full match */
+    gsize    start;
+    gsize    end;
+    /* Captured value, if any */
+    gsize    value_start;
+    gsize    value_end;
+} ResponseMatch;
+
+#define STR_LEN(str) (sizeof (str) - 1)
+
+static inline gboolean
+match_literal (const gchar *str,
+               gsize        len,
+               gsize        pos,
+               const gchar *literal,
+               gsize        literal_len)
+{
+    return ((len - pos) >= literal_len && memcmp (&str[pos], literal, literal_len) == 0);
+}
+
+static inline gboolean
+match_crlf (const gchar *str,
+            gsize        len,
+            gsize        pos)
+{
+    return ((pos + 1) < len && str[pos] == '\r' && str[pos + 1] == '\n');
+}
+
+/* Same chars as '\s' in the regexes */
+static inline gboolean
+is_space (gchar c)
+{
+    return (c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r');
+}
+
+/* Same chars as the newline chars that '.' won't match in the regexes */
+static inline gboolean
+is_newline (gchar c)
+{
+    return (c == '\n' || c == '\v' || c == '\f' || c == '\r' || c == (gchar) 0x85);
+}
+
+/* "(\r\n)*" after the given position, but leaving the leading <CR><LF> of a
+ * duplicated OK reply untouched so that it can be matched on its own */
+static gsize
+ok_match_end (const gchar *str,
+              gsize        len,
+              gsize        pos)
+{
+    while (match_crlf (str, len, pos) && !match_literal (str, len, pos, "\r\nOK\r\n", STR_LEN ("\r\nOK\r\n")))
+        pos += 2;
+    return pos;
+}
+
+static void
+response_match_set (ResponseMatch *match,
+                    gsize          start,
+                    gsize          end,
+                    gsize          value_start,
+                    gsize          value_end)
+{
+    match->found = TRUE;
+    match->start = start;
+    match->end = end;
+    match->value_start = value_start;
+    match->value_end = value_end;
+}
+
+/* "\s*(\d+)\r\n" after the given position */
 static gboolean
-remove_eval_cb (const GMatchInfo *match_info,
-                GString *result,
-                gpointer user_data)
+match_numeric_error (const gchar *str,
+                     gsize        len,
+                     gsize        pos,
+                     gsize        start,
+                     ResponseMatch *match)
 {
-    int *result_len = (int *) user_data;
-    int start;
-    int end;
+    gsize value_start;
 
-    if (g_match_info_fetch_pos  (match_info, 0, &start, &end))
-        *result_len -= (end - start);
+    if (match->found)
+        return FALSE;
 
+    while (pos < len && is_space (str[pos]))
+        pos++;
+    value_start = pos;
+    while (pos < len && g_ascii_isdigit (str[pos]))
+        pos++;
+    if (pos == value_start || !match_crlf (str, len, pos))
+        return FALSE;
+
+    response_match_set (match, start, pos + 2, value_start, pos);
     return TRUE;
 }
 
+/* "\s*([^\n\r]+)\r\n" after the given position; the whitespace prefix is
+ * greedy, so try the longest one first */
+static gboolean
+match_string_error (const gchar *str,
+                    gsize        len,
+                    gsize        pos,
+                    gsize        start,
+                    ResponseMatch *match)
+{
+    gsize spaces_end;
+    gsize value_start;
+
+    if (match->found)
+        return FALSE;
+
+    spaces_end = pos;
+    while (spaces_end < len && is_space (str[spaces_end]))
+        spaces_end++;
+
+    value_start = spaces_end + 1;
+    do {
+        gsize value_end;
+
+        value_start--;
+        if (value_start >= len || str[value_start] == '\n' || str[value_start] == '\r')
+            continue;
+
+        value_end = value_start;
+        while (value_end < len && str[value_end] != '\n' && str[value_end] != '\r')
+            value_end++;
+        if (match_crlf (str, len, value_end)) {
+            response_match_set (match, start, value_end + 2, value_start, value_end);
+            return TRUE;
+        }
+    } while (value_start > pos);
+
+    return FALSE;
+}
+
 static void
-remove_matches (GRegex *r, GString *string)
+response_match_line (const gchar   *str,
+                     gsize          len,
+                     gsize          start,
+                     ResponseMatch *matches)
 {
-    char *str;
-    int result_len = string->len;
+    gsize pos;
 
-    str = g_regex_replace_eval (r, string->str, string->len, 0, 0,
-                                remove_eval_cb, &result_len, NULL);
+    /* Contents after the leading <CR><LF> */
+    pos = start + 2;
+    if (pos >= len)
+        return;
 
-    g_string_truncate (string, 0);
-    g_string_append_len (string, str, result_len);
-    g_free (str);
+    switch (str[pos]) {
+    case 'O':
+        if (!matches[RESPONSE_MATCH_OK].found && match_literal (str, len, pos, "OK\r\n", STR_LEN ("OK\r\n"))) {
+            gsize end;
+
+            end = ok_match_end (str, len, pos + STR_LEN ("OK\r\n"));
+            response_match_set (&matches[RESPONSE_MATCH_OK], start, end, 0, 0);
+        }
+        break;
+    case 'C':
+        if (!matches[RESPONSE_MATCH_CONNECT].found && match_literal (str, len, pos, "CONNECT", STR_LEN ("CONNECT"))) {
+            gsize end;
+
+            end = pos + STR_LEN ("CONNECT");
+            while (end < len && !is_newline (str[end]))
+                end++;
+            if (match_crlf (str, len, end))
+                response_match_set (&matches[RESPONSE_MATCH_CONNECT], start, end + 2, 0, 0);
+        }
+        break;
+    case '>':
+        if (!matches[RESPONSE_MATCH_SMS_PROMPT].found) {
+            gsize end;
+
+            end = pos + 1;
+            while (end < len && is_space (str[end]))
+                end++;
+            if (end == len)
+                response_match_set (&matches[RESPONSE_MATCH_SMS_PROMPT], start, end, 0, 0);
+        }
+        break;
+    case '+':
+        if (match_literal (str, len, pos, "+CME ERROR:", STR_LEN ("+CME ERROR:"))) {
+            pos += STR_LEN ("+CME ERROR:");
+            match_numeric_error (str, len, pos, start, &matches[RESPONSE_MATCH_CME_ERROR]);
+            match_string_error (str, len, pos, start, &matches[RESPONSE_MATCH_CME_ERROR_STR]);
+        } else if (match_literal (str, len, pos, "+CMS ERROR:", STR_LEN ("+CMS ERROR:"))) {
+            pos += STR_LEN ("+CMS ERROR:");
+            match_numeric_error (str, len, pos, start, &matches[RESPONSE_MATCH_CMS_ERROR]);
+            match_string_error (str, len, pos, start, &matches[RESPONSE_MATCH_CMS_ERROR_STR]);
+        }
+        break;
+    case 'M':
+        if (match_literal (str, len, pos, "MODEM ERROR:", STR_LEN ("MODEM ERROR:")))
+            match_numeric_error (str, len, pos + STR_LEN ("MODEM ERROR:"), start, &matches[RESPONSE_MATCH_EZX_ERROR]);
+        break;
+    case 'E':
+        if (!matches[RESPONSE_MATCH_UNKNOWN_ERROR].found && match_literal (str, len, pos, "ERROR", STR_LEN ("ERROR")))
+            response_match_set (&matches[RESPONSE_MATCH_UNKNOWN_ERROR], start, pos + STR_LEN ("ERROR"), 0, 0);
+        break;
+    case 'N':
+        if (!matches[RESPONSE_MATCH_NO_CARRIER].found && match_literal (str, len, pos, "NO CARRIER", STR_LEN ("NO CARRIER")))
+            response_match_set (&matches[RESPONSE_MATCH_NO_CARRIER], start, pos + STR_LEN ("NO CARRIER"), 0, 0);
+        else if (!matches[RESPONSE_MATCH_NA].found && match_literal (str, len, pos, "NA\r\n", STR_LEN ("NA\r\n")))
+            response_match_set (&matches[RESPONSE_MATCH_NA], start, pos + STR_LEN ("NA\r\n"), 0, 0);
+        break;
+    default:
+        break;
+    }
+}
+
+static void
+response_match (const gchar   *str,
+                gsize          len,
+                ResponseMatch *matches)
+{
+    const gchar *cr;
+    gsize        pos;
+
+    memset (matches, 0, sizeof (ResponseMatch) * RESPONSE_MATCH_LAST);
+
+    for (pos = 0; pos + 1 < len; pos++) {
+        cr = memchr (&str[pos], '\r', len - 1 - pos);
+        if (!cr)
+            break;
+        pos = cr - str;
+        if (str[pos + 1] == '\n')
+            response_match_line (str, len, pos, matches);
+    }
+}
+
+/* The remaining error replies are not anchored to the beginning of a line,
+ * so they're looked for anywhere in the response, and only when needed. */
+static gboolean
+response_find_unanchored_unknown_error (const gchar *str,
+                                        gsize        len)
+{
+    return !!memmem (str, len, "COMMAND NOT SUPPORT\r\n", STR_LEN ("COMMAND NOT SUPPORT\r\n"));
+}
+
+static gboolean
+response_find_connect_failed (const gchar       *str,
+                              gsize              len,
+                              ResponseMatch     *no_carrier_match,
+                              MMConnectionError *code)
+{
+    static const struct {
+        const gchar       *str;
+        gsize              len;
+        MMConnectionError  code;
+    } unanchored[] = {
+        { "BUSY",          STR_LEN ("BUSY"),          MM_CONNECTION_ERROR_BUSY        },
+        { "NO ANSWER",     STR_LEN ("NO ANSWER"),     MM_CONNECTION_ERROR_NO_ANSWER   },
+        { "NO DIALTONE\r\n", STR_LEN ("NO DIALTONE\r\n"), MM_CONNECTION_ERROR_NO_DIALTONE },
+    };
+    gboolean found = FALSE;
+    gsize    first = 0;
+    guint    i;
+
+    if (no_carrier_match->found) {
+        found = TRUE;
+        first = no_carrier_match->start;
+        *code = MM_CONNECTION_ERROR_NO_CARRIER;
+    }
+
+    /* The leftmost reply wins, so only look for the ones starting before
+     * the one already found */
+    for (i = 0; i < G_N_ELEMENTS (unanchored); i++) {
+        const gchar *match;
+        gsize        limit;
+
+        limit = found ? MIN (len, first + unanchored[i].len - 1) : len;
+        match = memmem (str, limit, unanchored[i].str, unanchored[i].len);
+        if (match) {
+            found = TRUE;
+            first = match - str;
+            *code = unanchored[i].code;
+        }
+    }
+
+    return found;
+}
+
+static void
+response_remove_match (GString       *response,
+                       ResponseMatch *match)
+{
+    g_string_erase (response, match->start, match->end - match->start);
+}
+
+/* Remove all "\r\nOK(\r\n)+" matches, not just the first one; some modems
+ * reply with duplicated final responses and none of them must be left in the
+ * returned text */
+static void
+response_remove_ok_matches (GString       *response,
+                            ResponseMatch *match)
+{
+    gsize pos;
+
+    response_remove_match (response, match);
+
+    /* Matches don't overlap, so the next one can't start before the
+     * text that followed the one just removed */
+    pos = match->start;
+    while (pos + STR_LEN ("\r\nOK\r\n") <= response->len) {
+        gsize end;
+
+        if (!match_literal (response->str, response->len, pos, "\r\nOK\r\n", STR_LEN ("\r\nOK\r\n"))) {
+            pos++;
+            continue;
+        }
+
+        end = ok_match_end (response->str, response->len, pos + STR_LEN ("\r\nOK\r\n"));
+        g_string_erase (response, pos, end - pos);
+    }
+}
+
+static gchar *
+response_match_dup_value (GString       *response,
+                          ResponseMatch *match)
+{
+    return g_strndup (&response->str[match->value_start], match->value_end - match->value_start);
 }
 
+/*****************************************************************************/
+
 typedef struct {
-    /* Regular expressions for successful replies */
-    GRegex *regex_ok;
-    GRegex *regex_connect;
-    GRegex *regex_sms;
+    /* Regular expressions for custom successful and error replies */
     GRegex *regex_custom_successful;
-    /* Regular expressions for error replies */
-    GRegex *regex_cme_error;
-    GRegex *regex_cms_error;
-    GRegex *regex_cme_error_str;
-    GRegex *regex_cms_error_str;
-    GRegex *regex_ezx_error;
-    GRegex *regex_unknown_error;
-    GRegex *regex_connect_failed;
-    GRegex *regex_na;
     GRegex *regex_custom_error;
     /* User-provided parser filter */
     mm_serial_parser_v1_filter_fn filter_callback;
@@ -104,23 +422,9 @@ gpointer
 mm_serial_parser_v1_new (void)
 {
     MMSerialParserV1 *parser;
-    GRegexCompileFlags flags = G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW | G_REGEX_OPTIMIZE;
 
     parser = g_slice_new (MMSerialParserV1);
 
-    parser->regex_ok = g_regex_new ("\\r\\nOK(\\r\\n)+", flags, 0, NULL);
-    parser->regex_connect = g_regex_new ("\\r\\nCONNECT.*\\r\\n", flags, 0, NULL);
-    parser->regex_sms = g_regex_new ("\\r\\n>\\s*$", flags, 0, NULL);
-    parser->regex_cme_error = g_regex_new ("\\r\\n\\+CME ERROR:\\s*(\\d+)\\r\\n", flags, 0, NULL);
-    parser->regex_cms_error = g_regex_new ("\\r\\n\\+CMS ERROR:\\s*(\\d+)\\r\\n", flags, 0, NULL);
-    parser->regex_cme_error_str = g_regex_new ("\\r\\n\\+CME ERROR:\\s*([^\\n\\r]+)\\r\\n", flags, 0, NULL);
-    parser->regex_cms_error_str = g_regex_new ("\\r\\n\\+CMS ERROR:\\s*([^\\n\\r]+)\\r\\n", flags, 0, NULL);
-    parser->regex_ezx_error = g_regex_new ("\\r\\nMODEM ERROR:\\s*(\\d+)\\r\\n", flags, 0, NULL);
-    parser->regex_unknown_error = g_regex_new ("\\r\\n(ERROR)|(COMMAND NOT SUPPORT)\\r\\n", flags, 0, NULL);
-    parser->regex_connect_failed = g_regex_new ("\\r\\n(NO CARRIER)|(BUSY)|(NO ANSWER)|(NO DIALTONE)\\r\\n", flags, 0, NULL);
-    /* Samsung Z810 may reply "NA" to report a not-available error */
-    parser->regex_na = g_regex_new ("\\r\\nNA\\r\\n", flags, 0, NULL);
-
     parser->regex_custom_successful = NULL;
     parser->regex_custom_error = NULL;
     parser->filter_callback = NULL;
@@ -167,6 +471,8 @@ mm_serial_parser_v1_parse (gpointer   data,
                            GError   **error)
 {
     MMSerialParserV1 *parser = (MMSerialParserV1 *) data;
+    ResponseMatch matches[RESPONSE_MATCH_LAST];
+    MMConnectionError connection_error;
     GMatchInfo *match_info = NULL;
     GError *local_error = NULL;
     gboolean found = FALSE;
@@ -202,27 +508,21 @@ mm_serial_parser_v1_parse (gpointer   data,
         found = g_regex_match_full (parser->regex_custom_successful,
                                     response->str, response->len,
                                     0, 0, NULL, NULL);
+        if (found) {
+            response_clean (response);
+            return TRUE;
+        }
     }
 
-    if (!found) {
-        found = g_regex_match_full (parser->regex_ok,
-                                    response->str, response->len,
-                                    0, 0, NULL, NULL);
-        if (found)
-            remove_matches (parser->regex_ok, response);
-    }
-
-    if (!found) {
-        found = g_regex_match_full (parser->regex_connect,
-                                    response->str, response->len,
-                                    0, 0, NULL, NULL);
-    }
+    /* Single pass over the response to find all known final replies */
+    response_match (response->str, response->len, matches);
 
-    if (!found) {
-        found = g_regex_match_full (parser->regex_sms,
-                                    response->str, response->len,
-                                    0, 0, NULL, NULL);
-    }
+    if (matches[RESPONSE_MATCH_OK].found) {
+        response_remove_ok_matches (response, &matches[RESPONSE_MATCH_OK]);
+        found = TRUE;
+    } else if (matches[RESPONSE_MATCH_CONNECT].found ||
+               matches[RESPONSE_MATCH_SMS_PROMPT].found)
+        found = TRUE;
 
     if (found) {
         response_clean (response);
@@ -246,112 +546,68 @@ mm_serial_parser_v1_parse (gpointer   data,
     }
 
     /* Numeric CME errors */
-    found = g_regex_match_full (parser->regex_cme_error,
-                                response->str, response->len,
-                                0, 0, &match_info, NULL);
-    if (found) {
-        str = g_match_info_fetch (match_info, 1);
-        g_assert (str);
+    if (matches[RESPONSE_MATCH_CME_ERROR].found) {
+        str = response_match_dup_value (response, &matches[RESPONSE_MATCH_CME_ERROR]);
         local_error = mm_mobile_equipment_error_for_code (atoi (str), log_object);
+        found = TRUE;
         goto done;
     }
-    g_clear_pointer (&match_info, g_match_info_free);
 
     /* Numeric CMS errors */
-    found = g_regex_match_full (parser->regex_cms_error,
-                                response->str, response->len,
-                                0, 0, &match_info, NULL);
-    if (found) {
-        str = g_match_info_fetch (match_info, 1);
-        g_assert (str);
+    if (matches[RESPONSE_MATCH_CMS_ERROR].found) {
+        str = response_match_dup_value (response, &matches[RESPONSE_MATCH_CMS_ERROR]);
         local_error = mm_message_error_for_code (atoi (str), log_object);
+        found = TRUE;
         goto done;
     }
-    g_clear_pointer (&match_info, g_match_info_free);
 
     /* String CME errors */
-    found = g_regex_match_full (parser->regex_cme_error_str,
-                                response->str, response->len,
-                                0, 0, &match_info, NULL);
-    if (found) {
-        str = g_match_info_fetch (match_info, 1);
-        g_assert (str);
+    if (matches[RESPONSE_MATCH_CME_ERROR_STR].found) {
+        str = response_match_dup_value (response, &matches[RESPONSE_MATCH_CME_ERROR_STR]);
         local_error = mm_mobile_equipment_error_for_string (str, log_object);
+        found = TRUE;
         goto done;
     }
-    g_clear_pointer (&match_info, g_match_info_free);
 
     /* String CMS errors */
-    found = g_regex_match_full (parser->regex_cms_error_str,
-                                response->str, response->len,
-                                0, 0, &match_info, NULL);
-    if (found) {
-        str = g_match_info_fetch (match_info, 1);
-        g_assert (str);
+    if (matches[RESPONSE_MATCH_CMS_ERROR_STR].found) {
+        str = response_match_dup_value (response, &matches[RESPONSE_MATCH_CMS_ERROR_STR]);
         local_error = mm_message_error_for_string (str, log_object);
+        found = TRUE;
         goto done;
     }
-    g_clear_pointer (&match_info, g_match_info_free);
 
     /* Motorola EZX errors */
-    found = g_regex_match_full (parser->regex_ezx_error,
-                                response->str, response->len,
-                                0, 0, &match_info, NULL);
-    if (found) {
-        str = g_match_info_fetch (match_info, 1);
-        g_assert (str);
+    if (matches[RESPONSE_MATCH_EZX_ERROR].found) {
         local_error = mm_mobile_equipment_error_for_code (MM_MOBILE_EQUIPMENT_ERROR_UNKNOWN, log_object);
+        found = TRUE;
         goto done;
     }
-    g_clear_pointer (&match_info, g_match_info_free);
 
     /* Last resort; unknown error */
-    found = g_regex_match_full (parser->regex_unknown_error,
-                                response->str, response->len,
-                                0, 0, &match_info, NULL);
-    if (found) {
+    if (matches[RESPONSE_MATCH_UNKNOWN_ERROR].found ||
+        response_find_unanchored_unknown_error (response->str, response->len)) {
         local_error = mm_mobile_equipment_error_for_code (MM_MOBILE_EQUIPMENT_ERROR_UNKNOWN, log_object);
+        found = TRUE;
         goto done;
     }
-    g_clear_pointer (&match_info, g_match_info_free);
 
     /* Connection failures */
-    found = g_regex_match_full (parser->regex_connect_failed,
-                                response->str, response->len,
-                                0, 0, &match_info, NULL);
-    if (found) {
-        MMConnectionError code;
-
-        str = g_match_info_fetch (match_info, 1);
-        g_assert (str);
-
-        if (!strcmp (str, "NO CARRIER"))
-            code = MM_CONNECTION_ERROR_NO_CARRIER;
-        else if (!strcmp (str, "BUSY"))
-            code = MM_CONNECTION_ERROR_BUSY;
-        else if (!strcmp (str, "NO ANSWER"))
-            code = MM_CONNECTION_ERROR_NO_ANSWER;
-        else if (!strcmp (str, "NO DIALTONE"))
-            code = MM_CONNECTION_ERROR_NO_DIALTONE;
-        else {
-            /* uhm... make something up (yes, ok, lie!). */
-            code = MM_CONNECTION_ERROR_NO_CARRIER;
-        }
-
-        local_error = mm_connection_error_for_code (code, log_object);
+    if (response_find_connect_failed (response->str, response->len,
+                                      &matches[RESPONSE_MATCH_NO_CARRIER],
+                                      &connection_error)) {
+        local_error = mm_connection_error_for_code (connection_error, log_object);
+        found = TRUE;
         goto done;
     }
-    g_clear_pointer (&match_info, g_match_info_free);
 
     /* NA error */
-    found = g_regex_match_full (parser->regex_na,
-                                response->str, response->len,
-                                0, 0, &match_info, NULL);
-    if (found) {
+    if (matches[RESPONSE_MATCH_NA].found) {
         /* Assume NA means 'Not Allowed' :) */
         local_error = g_error_new (MM_MOBILE_EQUIPMENT_ERROR,
                                    MM_MOBILE_EQUIPMENT_ERROR_NOT_ALLOWED,
                                    "Not Allowed");
+        found = TRUE;
         goto done;
     }
 
@@ -387,18 +643,6 @@ mm_serial_parser_v1_destroy (gpointer data)
 
     g_return_if_fail (parser != NULL);
 
-    g_regex_unref (parser->regex_ok);
-    g_regex_unref (parser->regex_connect);
-    g_regex_unref (parser->regex_sms);
-    g_regex_unref (parser->regex_cme_error);
-    g_regex_unref (parser->regex_cms_error);
-    g_regex_unref (parser->regex_cme_error_str);
-    g_regex_unref (parser->regex_cms_error_str);
-    g_regex_unref (parser->regex_ezx_error);
-    g_regex_unref (parser->regex_unknown_error);
-    g_regex_unref (parser->regex_connect_failed);
-    g_regex_unref (parser->regex_na);
-
     if (parser->regex_custom_successful)
         g_regex_unref (parser->regex_custom_successful);
     if (parser->regex_custom_error)
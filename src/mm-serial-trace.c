@@ -0,0 +1,491 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 Telit
+ */
+
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <glib/gstdio.h>
+
+#include <ModemManager.h>
+#include <mm-errors-types.h>
+
+#include "mm-serial-trace.h"
+
+/* In-memory record header: timestamp, direction, length */
+#define RECORD_HEADER_SIZE (sizeof (gint64) + sizeof (guint8) + sizeof (guint32))
+
+typedef enum {
+    SCRUB_STATE_LINE_START,
+    SCRUB_STATE_TAG,
+    SCRUB_STATE_MASK,
+    SCRUB_STATE_KEEP,
+} ScrubState;
+
+/* Masking state of each direction, lines may span several records */
+typedef struct {
+    ScrubState state;
+    guint      tag_len;
+    gchar      tag[2];
+} Scrub;
+
+struct _MMSerialTrace {
+    gchar  *name;
+    Scrub   scrub[2];
+    /* Masked copy of the record being added */
+    GByteArray *scratch;
+    guint8 *ring;
+    gsize   size;
+    /* Offset of the oldest record */
+    gsize   head;
+    /* Bytes in use, starting at head */
+    gsize   used;
+    guint   n_records;
+};
+
+static gsize    trace_size = MM_SERIAL_TRACE_DEFAULT_SIZE;
+static gboolean trace_personal_info;
+static GList   *traces;
+
+void
+mm_serial_trace_set_size (gsize size)
+{
+    /* Rings must at least fit a record header and some data */
+    trace_size = (size && size < 2 * RECORD_HEADER_SIZE) ? 2 * RECORD_HEADER_SIZE : size;
+}
+
+void
+mm_serial_trace_set_show_personal_info (gboolean show_personal_info)
+{
+    trace_personal_info = show_personal_info;
+}
+
+MMSerialTrace *
+mm_serial_trace_new (const gchar *name)
+{
+    MMSerialTrace *self;
+
+    if (!trace_size)
+        return NULL;
+
+    self = g_slice_new0 (MMSerialTrace);
+    self->name = g_strdup (name ? name : "");
+    self->size = trace_size;
+    self->ring = g_malloc (self->size);
+    self->scratch = g_byte_array_new ();
+
+    traces = g_list_prepend (traces, self);
+    return self;
+}
+
+void
+mm_serial_trace_free (MMSerialTrace *self)
+{
+    if (!self)
+        return;
+
+    traces = g_list_remove (traces, self);
+    g_free (self->ring);
+    g_byte_array_unref (self->scratch);
+    g_free (self->name);
+    g_slice_free (MMSerialTrace, self);
+}
+
+/*****************************************************************************/
+
+static void
+ring_write (MMSerialTrace *self,
+            gsize          offset,
+            const guint8  *data,
+            gsize          len)
+{
+    gsize first;
+
+    offset %= self->size;
+    first = MIN (len, self->size - offset);
+    memcpy (&self->ring[offset], data, first);
+    if (first < len)
+        memcpy (self->ring, &data[first], len - first);
+}
+
+static void
+ring_read (const MMSerialTrace *self,
+           gsize                offset,
+           guint8              *data,
+           gsize                len)
+{
+    gsize first;
+
+    offset %= self->size;
+    first = MIN (len, self->size - offset);
+    memcpy (data, &self->ring[offset], first);
+    if (first < len)
+        memcpy (&data[first], self->ring, len - first);
+}
+
+static void
+record_header_read (const MMSerialTrace    *self,
+                    gsize                   offset,
+                    gint64                 *timestamp,
+                    MMSerialTraceDirection *direction,
+                    guint32                *len)
+{
+    guint8 header[RECORD_HEADER_SIZE];
+
+    ring_read (self, offset, header, sizeof (header));
+    memcpy (timestamp, header, sizeof (gint64));
+    *direction = (MMSerialTraceDirection) header[sizeof (gint64)];
+    memcpy (len, &header[sizeof (gint64) + sizeof (guint8)], sizeof (guint32));
+}
+
+static void
+drop_oldest_record (MMSerialTrace *self)
+{
+    gint64                 timestamp;
+    MMSerialTraceDirection direction;
+    guint32                len;
+
+    record_header_read (self, self->head, &timestamp, &direction, &len);
+    self->head = (self->head + RECORD_HEADER_SIZE + len) % self->size;
+    self->used -= RECORD_HEADER_SIZE + len;
+    self->n_records--;
+}
+
+static gboolean
+scrub_is_line_end (guint8 c)
+{
+    return (c == '\r' || c == '\n');
+}
+
+static gboolean
+scrub_is_separator (guint8 c)
+{
+    return (c == ' ' || c == ',' || c == ';' || c == '"' || c == '(' || c == ')');
+}
+
+static gboolean
+scrub_is_prefix (guint8 c)
+{
+    return (c == '+' || c == '^' || c == '$' || c == '#' || c == '*' || c == '%');
+}
+
+/* Lines made only of uppercase words are result codes (OK, ERROR, NO CARRIER...);
+ * lines not fully contained in the data are assumed not to be. */
+static gboolean
+scrub_is_result_code (const guint8 *data,
+                      gsize         len)
+{
+    gsize i;
+
+    for (i = 0; i < len && !scrub_is_line_end (data[i]); i++) {
+        if (!g_ascii_isupper (data[i]) && data[i] != ' ')
+            return FALSE;
+    }
+    return (i < len);
+}
+
+static const guint8 *
+scrub_record (MMSerialTrace          *self,
+              MMSerialTraceDirection  direction,
+              const guint8           *data,
+              gsize                   len)
+{
+    Scrub *scrub;
+    gsize  i;
+
+    scrub = &self->scrub[direction == MM_SERIAL_TRACE_DIRECTION_IN];
+    g_byte_array_set_size (self->scratch, len);
+
+    for (i = 0; i < len; i++) {
+        guint8 c = data[i];
+
+        if (scrub_is_line_end (c)) {
+            scrub->state = SCRUB_STATE_LINE_START;
+            self->scratch->data[i] = c;
+            continue;
+        }
+
+        switch (scrub->state) {
+        case SCRUB_STATE_LINE_START:
+            /* Commands and prefixed responses keep their name */
+            if (c == 'A' || c == 'a' || scrub_is_prefix (c)) {
+                scrub->state = SCRUB_STATE_TAG;
+                scrub->tag_len = 0;
+            } else if (scrub_is_result_code (&data[i], len - i))
+                scrub->state = SCRUB_STATE_KEEP;
+            else {
+                scrub->state = SCRUB_STATE_MASK;
+                c = scrub_is_separator (c) ? c : '#';
+            }
+            break;
+        case SCRUB_STATE_TAG:
+            /* The name (e.g. "+CME ERROR") ends with the first character
+             * not expected in it; the number dialed after ATD is not part
+             * of it */
+            if ((scrub->tag_len == 2 &&
+                 g_ascii_toupper (scrub->tag[0]) == 'A' &&
+                 g_ascii_toupper (scrub->tag[1]) == 'T' &&
+                 g_ascii_toupper (c) == 'D') ||
+                c == '=' || c == ':' || c == '?')
+                scrub->state = SCRUB_STATE_MASK;
+            else if (!g_ascii_isalpha (c) && !scrub_is_prefix (c) && c != '_' && c != ' ') {
+                scrub->state = SCRUB_STATE_MASK;
+                c = scrub_is_separator (c) ? c : '#';
+            }
+            break;
+        case SCRUB_STATE_MASK:
+            c = scrub_is_separator (c) ? c : '#';
+            break;
+        case SCRUB_STATE_KEEP:
+        default:
+            break;
+        }
+
+        if (scrub->state == SCRUB_STATE_TAG) {
+            if (scrub->tag_len < G_N_ELEMENTS (scrub->tag))
+                scrub->tag[scrub->tag_len] = (gchar) c;
+            scrub->tag_len++;
+        }
+        self->scratch->data[i] = c;
+    }
+
+    return self->scratch->data;
+}
+
+void
+mm_serial_trace_add (MMSerialTrace          *self,
+                     MMSerialTraceDirection  direction,
+                     const guint8           *data,
+                     gsize                   len)
+{
+    guint8  header[RECORD_HEADER_SIZE];
+    gint64  timestamp;
+    guint32 record_len;
+
+    /* Records bigger than the whole ring are truncated */
+    record_len = (guint32) MIN (len, self->size - RECORD_HEADER_SIZE);
+
+    while (self->size - self->used < RECORD_HEADER_SIZE + record_len)
+        drop_oldest_record (self);
+
+    if (!trace_personal_info)
+        data = scrub_record (self, direction, data, record_len);
+
+    timestamp = g_get_real_time ();
+    memcpy (header, &timestamp, sizeof (gint64));
+    header[sizeof (gint64)] = (guint8) direction;
+    memcpy (&header[sizeof (gint64) + sizeof (guint8)], &record_len, sizeof (guint32));
+
+    ring_write (self, self->head + self->used, header, sizeof (header));
+    ring_write (self, self->head + self->used + RECORD_HEADER_SIZE, data, record_len);
+    self->used += RECORD_HEADER_SIZE + record_len;
+    self->n_records++;
+}
+
+/*****************************************************************************/
+
+static void
+dump_trace (const MMSerialTrace *self,
+            GByteArray          *out)
+{
+    guint16 name_len;
+    guint32 n_records;
+    gsize   offset;
+    guint   i;
+
+    name_len = GUINT16_TO_LE ((guint16) MIN (strlen (self->name), G_MAXUINT16));
+    g_byte_array_append (out, (const guint8 *) &name_len, sizeof (name_len));
+    g_byte_array_append (out, (const guint8 *) self->name, GUINT16_FROM_LE (name_len));
+    n_records = GUINT32_TO_LE (self->n_records);
+    g_byte_array_append (out, (const guint8 *) &n_records, sizeof (n_records));
+
+    for (i = 0, offset = self->head; i < self->n_records; i++) {
+        gint64                 timestamp;
+        MMSerialTraceDirection direction;
+        guint32                len;
+        guint32                len_le;
+        guint8                 aux;
+        guint                  data_start;
+
+        record_header_read (self, offset, &timestamp, &direction, &len);
+        offset += RECORD_HEADER_SIZE;
+
+        timestamp = GINT64_TO_LE (timestamp);
+        g_byte_array_append (out, (const guint8 *) &timestamp, sizeof (timestamp));
+        aux = (guint8) direction;
+        g_byte_array_append (out, &aux, sizeof (aux));
+        len_le = GUINT32_TO_LE (len);
+        g_byte_array_append (out, (const guint8 *) &len_le, sizeof (len_le));
+
+        /* Copy the data straight from the ring */
+        data_start = out->len;
+        g_byte_array_set_size (out, data_start + len);
+        ring_read (self, offset, &out->data[data_start], len);
+        offset += len;
+    }
+}
+
+static gboolean
+write_private_file (const gchar   *path,
+                    const guint8  *contents,
+                    gsize          contents_len,
+                    GError       **error)
+{
+    g_autofree gchar *tmp_path = NULL;
+    gint              fd;
+    gsize             written = 0;
+
+    /* Written to a new file created with owner-only permissions, which then
+     * atomically replaces the target; never following a planted symlink */
+    tmp_path = g_strdup_printf ("%s.XXXXXX", path);
+    fd = g_mkstemp_full (tmp_path, O_WRONLY | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                     "Couldn't create file '%s': %s", tmp_path, g_strerror (errno));
+        return FALSE;
+    }
+
+    while (written < contents_len) {
+        gssize n;
+
+        n = write (fd, &contents[written], contents_len - written);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0) {
+            g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                         "Couldn't write file '%s': %s", tmp_path, g_strerror (errno));
+            close (fd);
+            g_unlink (tmp_path);
+            return FALSE;
+        }
+        written += n;
+    }
+
+    if (close (fd) < 0 || g_rename (tmp_path, path) < 0) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                     "Couldn't write file '%s': %s", path, g_strerror (errno));
+        g_unlink (tmp_path);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+gboolean
+mm_serial_trace_dump_all (const gchar  *path,
+                          GError      **error)
+{
+    g_autoptr(GByteArray) out = NULL;
+    guint32               version;
+    GList                *l;
+
+    out = g_byte_array_new ();
+    g_byte_array_append (out, (const guint8 *) MM_SERIAL_TRACE_MAGIC, strlen (MM_SERIAL_TRACE_MAGIC));
+    version = GUINT32_TO_LE (MM_SERIAL_TRACE_VERSION);
+    g_byte_array_append (out, (const guint8 *) &version, sizeof (version));
+
+    /* Oldest ports first */
+    for (l = g_list_last (traces); l; l = g_list_previous (l))
+        dump_trace ((const MMSerialTrace *) l->data, out);
+
+    return write_private_file (path, out->data, out->len, error);
+}
+
+/*****************************************************************************/
+
+static gboolean
+parse_truncated (GError **error)
+{
+    g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS, "Truncated serial trace file");
+    return FALSE;
+}
+
+static gboolean
+parse_read (const guint8 **contents,
+            gsize         *contents_len,
+            gpointer       out,
+            gsize          len)
+{
+    if (*contents_len < len)
+        return FALSE;
+    if (out)
+        memcpy (out, *contents, len);
+    *contents += len;
+    *contents_len -= len;
+    return TRUE;
+}
+
+gboolean
+mm_serial_trace_parse (const guint8             *contents,
+                       gsize                     contents_len,
+                       MMSerialTraceRecordFunc   func,
+                       gpointer                  user_data,
+                       GError                  **error)
+{
+    gchar   magic[sizeof (MM_SERIAL_TRACE_MAGIC) - 1];
+    guint32 version;
+
+    if (!parse_read (&contents, &contents_len, magic, sizeof (magic)) ||
+        memcmp (magic, MM_SERIAL_TRACE_MAGIC, sizeof (magic)) != 0) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS, "Not a serial trace file");
+        return FALSE;
+    }
+
+    if (!parse_read (&contents, &contents_len, &version, sizeof (version)) ||
+        GUINT32_FROM_LE (version) != MM_SERIAL_TRACE_VERSION) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_UNSUPPORTED,
+                     "Unsupported serial trace file version");
+        return FALSE;
+    }
+
+    while (contents_len > 0) {
+        g_autofree gchar *name = NULL;
+        guint16           name_len;
+        guint32           n_records;
+        guint             i;
+
+        if (!parse_read (&contents, &contents_len, &name_len, sizeof (name_len)))
+            return parse_truncated (error);
+        name = g_malloc0 (GUINT16_FROM_LE (name_len) + 1);
+        if (!parse_read (&contents, &contents_len, name, GUINT16_FROM_LE (name_len)) ||
+            !parse_read (&contents, &contents_len, &n_records, sizeof (n_records)))
+            return parse_truncated (error);
+
+        for (i = 0; i < GUINT32_FROM_LE (n_records); i++) {
+            gint64        timestamp;
+            guint8        direction;
+            guint32       len;
+            const guint8 *data;
+
+            if (!parse_read (&contents, &contents_len, &timestamp, sizeof (timestamp)) ||
+                !parse_read (&contents, &contents_len, &direction, sizeof (direction)) ||
+                !parse_read (&contents, &contents_len, &len, sizeof (len)))
+                return parse_truncated (error);
+            data = contents;
+            if (!parse_read (&contents, &contents_len, NULL, GUINT32_FROM_LE (len)))
+                return parse_truncated (error);
+
+            func (name,
+                  GINT64_FROM_LE (timestamp),
+                  (MMSerialTraceDirection) direction,
+                  data,
+                  GUINT32_FROM_LE (len),
+                  user_data);
+        }
+    }
+
+    return TRUE;
+}
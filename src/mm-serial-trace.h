@@ -0,0 +1,84 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 Telit
+ */
+
+#ifndef MM_SERIAL_TRACE_H
+#define MM_SERIAL_TRACE_H
+
+#include <glib.h>
+
+/*
+ * Binary trace of the raw traffic of a serial port.
+ *
+ * Each port keeps the latest records (timestamp, direction and raw bytes) in a
+ * ring of bounded size, the oldest records being dropped when there is no room
+ * for a new one. The traces of all ports can be dumped to a file on demand, so
+ * that the traffic that led to a failure can be inspected afterwards without
+ * running with debug logs.
+ *
+ * Tracing is disabled by default. Unless personal info is allowed in the logs,
+ * command arguments and response contents are masked with '#' characters
+ * before being stored, keeping only the command and response names, the
+ * separators and the final result codes.
+ *
+ * Dump file format, all integers in little endian:
+ *   header:   "MMSTRACE" magic, u32 version
+ *   per port: u16 name length, name, u32 number of records
+ *   record:   i64 wall clock timestamp (us), u8 direction, u32 length, data
+ */
+
+#define MM_SERIAL_TRACE_MAGIC        "MMSTRACE"
+#define MM_SERIAL_TRACE_VERSION      1
+#define MM_SERIAL_TRACE_DEFAULT_SIZE 0
+
+typedef enum {
+    MM_SERIAL_TRACE_DIRECTION_OUT = 0,
+    MM_SERIAL_TRACE_DIRECTION_IN  = 1,
+} MMSerialTraceDirection;
+
+typedef struct _MMSerialTrace MMSerialTrace;
+
+/* Ring size of the traces created afterwards; 0 disables tracing */
+void           mm_serial_trace_set_size (gsize                   size);
+
+/* Whether the raw traffic is stored as is, or with personal info masked */
+void           mm_serial_trace_set_show_personal_info (gboolean  show_personal_info);
+
+/* Returns NULL if tracing is disabled */
+MMSerialTrace *mm_serial_trace_new      (const gchar            *name);
+void           mm_serial_trace_free     (MMSerialTrace          *self);
+void           mm_serial_trace_add      (MMSerialTrace          *self,
+                                         MMSerialTraceDirection  direction,
+                                         const guint8           *data,
+                                         gsize                   len);
+
+/* Dump the traces of all existing ports to a file only readable by the owner */
+gboolean       mm_serial_trace_dump_all (const gchar            *path,
+                                         GError                **error);
+
+/* Parse a dump file, calling the given function for each record */
+typedef void (* MMSerialTraceRecordFunc) (const gchar            *name,
+                                          gint64                  timestamp,
+                                          MMSerialTraceDirection  direction,
+                                          const guint8           *data,
+                                          gsize                   len,
+                                          gpointer                user_data);
+
+gboolean       mm_serial_trace_parse    (const guint8            *contents,
+                                         gsize                    contents_len,
+                                         MMSerialTraceRecordFunc  func,
+                                         gpointer                 user_data,
+                                         GError                 **error);
+
+#endif /* MM_SERIAL_TRACE_H */
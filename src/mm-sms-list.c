@@ -43,6 +43,7 @@ static GParamSpec *properties[PROP_LAST];
 
 enum {
     SIGNAL_ADDED,
+    SIGNAL_ADDED_BATCH,
     SIGNAL_DELETED,
     SIGNAL_LAST
 };
@@ -53,8 +54,163 @@ struct _MMSmsListPrivate {
     MMBaseModem *modem;
     /* List of sms objects */
     GList *list;
+    /* SMS objects added by the user, whose parts get their index when stored */
+    GList *local_list;
+    /* Received SMS objects indexed by (storage, part index) */
+    GHashTable *part_index;
+    /* Received multipart SMS objects indexed by (reference, number) */
+    GHashTable *concat_index;
+    /* Batched additions */
+    guint      batch_level;
+    GPtrArray *batch_added;
 };
 
+/*****************************************************************************/
+/* Indexes */
+
+static gint64 *
+part_key_new (MMSmsStorage storage,
+              guint        index)
+{
+    gint64 *key;
+
+    key = g_new (gint64, 1);
+    *key = ((gint64) storage << 32) | index;
+    return key;
+}
+
+static gchar *
+concat_key_new (guint        reference,
+                const gchar *number)
+{
+    return g_strdup_printf ("%u %s", reference, number ? number : "");
+}
+
+static void
+index_add_part (MMSmsList    *self,
+                MMBaseSms    *sms,
+                MMSmsStorage  storage,
+                guint         index)
+{
+    if (storage == MM_SMS_STORAGE_UNKNOWN || index == SMS_PART_INVALID_INDEX)
+        return;
+
+    g_hash_table_insert (self->priv->part_index, part_key_new (storage, index), sms);
+}
+
+static void
+index_add_sms (MMSmsList *self,
+               MMBaseSms *sms)
+{
+    MMSmsStorage  storage;
+    GList        *l;
+
+    storage = mm_base_sms_get_storage (sms);
+    for (l = mm_base_sms_get_parts (sms); l; l = g_list_next (l))
+        index_add_part (self, sms, storage, mm_sms_part_get_index ((MMSmsPart *)l->data));
+}
+
+static void
+index_remove_sms (MMSmsList *self,
+                  MMBaseSms *sms)
+{
+    MMSmsStorage  storage;
+    GList        *parts;
+    GList        *l;
+
+    storage = mm_base_sms_get_storage (sms);
+    parts = mm_base_sms_get_parts (sms);
+    for (l = parts; l; l = g_list_next (l)) {
+        g_autofree gint64 *key = NULL;
+
+        key = part_key_new (storage, mm_sms_part_get_index ((MMSmsPart *)l->data));
+        if (g_hash_table_lookup (self->priv->part_index, key) == sms)
+            g_hash_table_remove (self->priv->part_index, key);
+    }
+
+    if (mm_base_sms_is_multipart (sms) && parts) {
+        g_autofree gchar *key = NULL;
+
+        key = concat_key_new (mm_base_sms_get_multipart_reference (sms),
+                              mm_sms_part_get_number ((MMSmsPart *)parts->data));
+        if (g_hash_table_lookup (self->priv->concat_index, key) == sms)
+            g_hash_table_remove (self->priv->concat_index, key);
+    }
+}
+
+/*****************************************************************************/
+/* Batched additions */
+
+typedef struct {
+    MMBaseSms *sms;
+    gboolean   received;
+} AddedSms;
+
+static void
+added_sms_free (AddedSms *added)
+{
+    g_object_unref (added->sms);
+    g_slice_free (AddedSms, added);
+}
+
+static void
+emit_added (MMSmsList *self,
+            MMBaseSms *sms,
+            gboolean   received)
+{
+    AddedSms *added;
+
+    if (!self->priv->batch_level) {
+        g_signal_emit (self, signals[SIGNAL_ADDED], 0,
+                       mm_base_sms_get_path (sms),
+                       received);
+        return;
+    }
+
+    added = g_slice_new (AddedSms);
+    added->sms = g_object_ref (sms);
+    added->received = received;
+    g_ptr_array_add (self->priv->batch_added, added);
+}
+
+void
+mm_sms_list_batch_begin (MMSmsList *self)
+{
+    if (!self->priv->batch_level++)
+        self->priv->batch_added = g_ptr_array_new_with_free_func ((GDestroyNotify)added_sms_free);
+}
+
+void
+mm_sms_list_batch_end (MMSmsList *self)
+{
+    g_autoptr(GPtrArray) batch_added = NULL;
+    GVariantBuilder      builder;
+    guint                i;
+
+    /* The list may have been replaced while the batch was running */
+    if (!self->priv->batch_level || --self->priv->batch_level)
+        return;
+
+    batch_added = g_steal_pointer (&self->priv->batch_added);
+    if (!batch_added->len)
+        return;
+
+    mm_obj_dbg (self, "%u SMS objects added in batch", batch_added->len);
+
+    /* SMS objects deleted before the batch ended are already unexported */
+    g_variant_builder_init (&builder, G_VARIANT_TYPE ("a(sb)"));
+    for (i = 0; i < batch_added->len; i++) {
+        AddedSms    *added;
+        const gchar *path;
+
+        added = g_ptr_array_index (batch_added, i);
+        path = mm_base_sms_get_path (added->sms);
+        if (path)
+            g_variant_builder_add (&builder, "(sb)", path, added->received);
+    }
+    g_signal_emit (self, signals[SIGNAL_ADDED_BATCH], 0, g_variant_builder_end (&builder));
+}
+
 /*****************************************************************************/
 
 gboolean
@@ -155,6 +311,8 @@ delete_ready (MMBaseSms *sms,
                             path,
                             (GCompareFunc)cmp_sms_by_path);
     if (l) {
+        index_remove_sms (self, MM_BASE_SMS (l->data));
+        self->priv->local_list = g_list_remove (self->priv->local_list, l->data);
         g_object_unref (MM_BASE_SMS (l->data));
         self->priv->list = g_list_delete_link (self->priv->list, l);
     }
@@ -212,23 +370,12 @@ mm_sms_list_add_sms (MMSmsList *self,
                      MMBaseSms *sms)
 {
     self->priv->list = g_list_prepend (self->priv->list, g_object_ref (sms));
-    g_signal_emit (self, signals[SIGNAL_ADDED], 0,
-                   mm_base_sms_get_path (sms),
-                   FALSE);
+    self->priv->local_list = g_list_prepend (self->priv->local_list, sms);
+    emit_added (self, sms, FALSE);
 }
 
 /*****************************************************************************/
 
-static guint
-cmp_sms_by_concat_reference (MMBaseSms *sms,
-                             gpointer user_data)
-{
-    if (!mm_base_sms_is_multipart (sms))
-        return -1;
-
-    return (GPOINTER_TO_UINT (user_data) - mm_base_sms_get_multipart_reference (sms));
-}
-
 typedef struct {
     guint part_index;
     MMSmsStorage storage;
@@ -260,9 +407,8 @@ take_singlepart (MMSmsList *self,
         return FALSE;
 
     self->priv->list = g_list_prepend (self->priv->list, sms);
-    g_signal_emit (self, signals[SIGNAL_ADDED], 0,
-                   mm_base_sms_get_path (sms),
-                   state == MM_SMS_STATE_RECEIVED);
+    index_add_sms (self, sms);
+    emit_added (self, sms, state == MM_SMS_STATE_RECEIVED);
     return TRUE;
 }
 
@@ -273,18 +419,22 @@ take_multipart (MMSmsList *self,
                 MMSmsStorage storage,
                 GError **error)
 {
-    GList *l;
     MMBaseSms *sms;
     guint concat_reference;
+    guint index;
+    g_autofree gchar *concat_key = NULL;
 
     concat_reference = mm_sms_part_get_concat_reference (part);
-    l = g_list_find_custom (self->priv->list,
-                            GUINT_TO_POINTER (concat_reference),
-                            (GCompareFunc)cmp_sms_by_concat_reference);
-    if (l) {
+    index = mm_sms_part_get_index (part);
+    concat_key = concat_key_new (concat_reference, mm_sms_part_get_number (part));
+    sms = g_hash_table_lookup (self->priv->concat_index, concat_key);
+    if (sms) {
         /* Try to take the part */
         mm_obj_dbg (self, "found existing multipart SMS object with reference '%u': adding new part", concat_reference);
-        return mm_base_sms_multipart_take_part (MM_BASE_SMS (l->data), part, error);
+        if (!mm_base_sms_multipart_take_part (sms, part, error))
+            return FALSE;
+        index_add_part (self, sms, mm_base_sms_get_storage (sms), index);
+        return TRUE;
     }
 
     /* Create new Multipart */
@@ -302,10 +452,10 @@ take_multipart (MMSmsList *self,
                 mm_sms_part_get_concat_max (part),
                 concat_reference);
     self->priv->list = g_list_prepend (self->priv->list, sms);
-    g_signal_emit (self, signals[SIGNAL_ADDED], 0,
-                   mm_base_sms_get_path (sms),
-                   (state == MM_SMS_STATE_RECEIVED ||
-                    state == MM_SMS_STATE_RECEIVING));
+    index_add_sms (self, sms);
+    g_hash_table_insert (self->priv->concat_index, g_steal_pointer (&concat_key), sms);
+    emit_added (self, sms, (state == MM_SMS_STATE_RECEIVED ||
+                            state == MM_SMS_STATE_RECEIVING));
 
     return TRUE;
 }
@@ -315,16 +465,22 @@ mm_sms_list_has_part (MMSmsList *self,
                       MMSmsStorage storage,
                       guint index)
 {
-    PartIndexAndStorage ctx;
+    PartIndexAndStorage  ctx;
+    g_autofree gint64   *key = NULL;
 
     if (storage == MM_SMS_STORAGE_UNKNOWN ||
         index == SMS_PART_INVALID_INDEX)
         return FALSE;
 
+    key = part_key_new (storage, index);
+    if (g_hash_table_contains (self->priv->part_index, key))
+        return TRUE;
+
+    /* Parts of user-created SMS objects only get an index once stored */
     ctx.part_index = index;
     ctx.storage = storage;
 
-    return !!g_list_find_custom (self->priv->list,
+    return !!g_list_find_custom (self->priv->local_list,
                                  &ctx,
                                  (GCompareFunc)cmp_sms_by_part_index_and_storage);
 }
@@ -443,6 +599,8 @@ mm_sms_list_init (MMSmsList *self)
     self->priv = G_TYPE_INSTANCE_GET_PRIVATE (self,
                                               MM_TYPE_SMS_LIST,
                                               MMSmsListPrivate);
+    self->priv->part_index = g_hash_table_new_full (g_int64_hash, g_int64_equal, g_free, NULL);
+    self->priv->concat_index = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
 }
 
 static void
@@ -451,6 +609,10 @@ dispose (GObject *object)
     MMSmsList *self = MM_SMS_LIST (object);
 
     g_clear_object (&self->priv->modem);
+    g_clear_pointer (&self->priv->batch_added, g_ptr_array_unref);
+    g_clear_pointer (&self->priv->part_index, g_hash_table_unref);
+    g_clear_pointer (&self->priv->concat_index, g_hash_table_unref);
+    g_clear_pointer (&self->priv->local_list, g_list_free);
     g_list_free_full (self->priv->list, g_object_unref);
     self->priv->list = NULL;
 
@@ -494,6 +656,15 @@ mm_sms_list_class_init (MMSmsListClass *klass)
                       g_cclosure_marshal_generic,
                       G_TYPE_NONE, 2, G_TYPE_STRING, G_TYPE_BOOLEAN);
 
+    signals[SIGNAL_ADDED_BATCH] =
+        g_signal_new (MM_SMS_ADDED_BATCH,
+                      G_OBJECT_CLASS_TYPE (object_class),
+                      G_SIGNAL_RUN_FIRST,
+                      G_STRUCT_OFFSET (MMSmsListClass, sms_added_batch),
+                      NULL, NULL,
+                      g_cclosure_marshal_generic,
+                      G_TYPE_NONE, 1, G_TYPE_VARIANT);
+
     signals[SIGNAL_DELETED] =
         g_signal_new (MM_SMS_DELETED,
                       G_OBJECT_CLASS_TYPE (object_class),
@@ -35,8 +35,9 @@ typedef struct _MMSmsListPrivate MMSmsListPrivate;
 
 #define MM_SMS_LIST_MODEM "sms-list-modem"
 
-#define MM_SMS_ADDED     "sms-added"
-#define MM_SMS_DELETED   "sms-deleted"
+#define MM_SMS_ADDED       "sms-added"
+#define MM_SMS_ADDED_BATCH "sms-added-batch"
+#define MM_SMS_DELETED     "sms-deleted"
 
 struct _MMSmsList {
     GObject parent;
@@ -50,6 +51,8 @@ struct _MMSmsListClass {
     void (*sms_added)     (MMSmsList *self,
                            const gchar *sms_path,
                            gboolean received);
+    void (*sms_added_batch) (MMSmsList *self,
+                             GVariant *added);
     void (*sms_deleted)   (MMSmsList *self,
                            const gchar *sms_path);
 };
@@ -75,6 +78,11 @@ gboolean mm_sms_list_take_part (MMSmsList *self,
 void mm_sms_list_add_sms (MMSmsList *self,
                           MMBaseSms *sms);
 
+/* While batching, additions are reported at the end in a single
+ * "sms-added-batch" signal, with an array of (path, received) tuples */
+void mm_sms_list_batch_begin (MMSmsList *self);
+void mm_sms_list_batch_end   (MMSmsList *self);
+
 void     mm_sms_list_delete_sms        (MMSmsList *self,
                                         const gchar *sms_path,
                                         GAsyncReadyCallback callback,
@@ -260,30 +260,31 @@ sms_decode_text (const guint8   *text,
         return NULL;
     }
 
+    /* Decode straight into a stack buffer; user data length is given in a
+     * single byte, so it is always small */
     if (encoding == MM_SMS_ENCODING_GSM7) {
-        g_autoptr(GByteArray)  unpacked_array = NULL;
-        guint8                *unpacked = NULL;
-        guint32                unpacked_len;
-        gchar                 *utf8;
+        gchar utf8[MM_CHARSET_GSM_PACKED_TO_UTF8_MAX_LEN (G_MAXUINT8)];
 
-        unpacked = mm_charset_gsm_unpack ((const guint8 *) text, len, bit_offset, &unpacked_len);
-        unpacked_array = g_byte_array_new_take (unpacked, unpacked_len);
-        utf8 = mm_modem_charset_bytearray_to_utf8 (unpacked_array, MM_MODEM_CHARSET_GSM, FALSE, error);
-        if (utf8)
-            mm_obj_dbg (log_object, "converted SMS part text from GSM-7 to UTF-8: %s", utf8);
-        return utf8;
+        g_assert (len <= G_MAXUINT8);
+        if (mm_charset_gsm_packed_to_utf8 (text, len, bit_offset, utf8, sizeof (utf8), error) < 0) {
+            g_prefix_error (error, "Invalid conversion from GSM to UTF-8: ");
+            return NULL;
+        }
+        mm_obj_dbg (log_object, "converted SMS part text from GSM-7 to UTF-8: %s", utf8);
+        return g_strdup (utf8);
     }
 
     /* Always assume UTF-16 instead of UCS-2! */
     if (encoding == MM_SMS_ENCODING_UCS2) {
-        g_autoptr(GByteArray)  bytearray = NULL;
-        gchar                 *utf8;
-
-        bytearray = g_byte_array_append (g_byte_array_sized_new (len), (const guint8 *)text, len);
-        utf8 = mm_modem_charset_bytearray_to_utf8 (bytearray, MM_MODEM_CHARSET_UTF16, FALSE, error);
-        if (utf8)
-            mm_obj_dbg (log_object, "converted SMS part text from UTF-16BE to UTF-8: %s", utf8);
-        return utf8;
+        gchar utf8[MM_CHARSET_UTF16BE_TO_UTF8_MAX_LEN (G_MAXUINT8)];
+
+        g_assert (len <= G_MAXUINT8);
+        if (mm_charset_utf16be_to_utf8 (text, len, utf8, sizeof (utf8), error) < 0) {
+            g_prefix_error (error, "Invalid conversion from UTF-16 to UTF-8: ");
+            return NULL;
+        }
+        mm_obj_dbg (log_object, "converted SMS part text from UTF-16BE to UTF-8: %s", utf8);
+        return g_strdup (utf8);
     }
 
     g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
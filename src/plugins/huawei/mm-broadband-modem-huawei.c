@@ -645,8 +645,8 @@ load_unlock_retries_finish (MMIfaceModem *self,
     if (!result)
         return NULL;
 
-    r = g_regex_new ("\\^CPIN:\\s*([^,]+),[^,]*,(\\d+),(\\d+),(\\d+),(\\d+)",
-                     G_REGEX_UNGREEDY, 0, NULL);
+    r = mm_regex_cache_get ("\\^CPIN:\\s*([^,]+),[^,]*,(\\d+),(\\d+),(\\d+),(\\d+)",
+                            G_REGEX_UNGREEDY, 0);
     g_assert (r != NULL);
 
     if (!g_regex_match_full (r, result, strlen (result), 0, 0, &match_info, &match_error)) {
@@ -4446,76 +4446,76 @@ mm_broadband_modem_huawei_init (MMBroadbandModemHuawei *self)
                                               MM_TYPE_BROADBAND_MODEM_HUAWEI,
                                               MMBroadbandModemHuaweiPrivate);
     /* Prepare regular expressions to setup */
-    self->priv->rssi_regex = g_regex_new ("\\r\\n\\^RSSI:\\s*(\\d+)\\r\\n",
-                                           G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->rssilvl_regex = g_regex_new ("\\r\\n\\^RSSILVL:\\s*(\\d+)\\r+\\n",
-                                             G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->hrssilvl_regex = g_regex_new ("\\r\\n\\^HRSSILVL:\\s*(\\d+)\\r+\\n",
-                                              G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
+    self->priv->rssi_regex = mm_regex_cache_get ("\\r\\n\\^RSSI:\\s*(\\d+)\\r\\n",
+                                                  G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
+    self->priv->rssilvl_regex = mm_regex_cache_get ("\\r\\n\\^RSSILVL:\\s*(\\d+)\\r+\\n",
+                                                    G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
+    self->priv->hrssilvl_regex = mm_regex_cache_get ("\\r\\n\\^HRSSILVL:\\s*(\\d+)\\r+\\n",
+                                                     G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
 
     /* 3GPP: <cr><lf>^MODE:5<cr><lf>
      * CDMA: <cr><lf>^MODE: 2<cr><cr><lf>
      */
-    self->priv->mode_regex = g_regex_new ("\\r\\n\\^MODE:\\s*(\\d*),?(\\d*)\\r+\\n",
-                                          G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->dsflowrpt_regex = g_regex_new ("\\r\\n\\^DSFLOWRPT:(.+)\\r\\n",
-                                               G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->ndisstat_regex = g_regex_new ("\\r\\n(\\^NDISSTAT:.+)\\r+\\n",
-                                              G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-
-    self->priv->orig_regex = g_regex_new ("\\r\\n\\^ORIG:\\s*(\\d+),\\s*(\\d+)\\r\\n",
-                                          G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->conf_regex = g_regex_new ("\\r\\n\\^CONF:\\s*(\\d+)\\r\\n",
-                                          G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->conn_regex = g_regex_new ("\\r\\n\\^CONN:\\s*(\\d+),\\s*(\\d+)\\r\\n",
-                                          G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->cend_regex = g_regex_new ("\\r\\n\\^CEND:\\s*(\\d+),\\s*(\\d+),\\s*(\\d+)(?:,\\s*(\\d*))?\\r\\n",
-                                          G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->ddtmf_regex = g_regex_new ("\\r\\n\\^DDTMF:\\s*([0-9A-D\\*\\#])\\r\\n",
-                                           G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-
-    self->priv->boot_regex = g_regex_new ("\\r\\n\\^BOOT:.+\\r\\n",
-                                          G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->connect_regex = g_regex_new ("\\r\\n\\^CONNECT .+\\r\\n",
-                                          G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->csnr_regex = g_regex_new ("\\r\\n\\^CSNR:.+\\r\\n",
-                                          G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->cusatp_regex = g_regex_new ("\\r\\n\\+CUSATP:.+\\r\\n",
-                                            G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->cusatend_regex = g_regex_new ("\\r\\n\\+CUSATEND\\r\\n",
-                                              G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->dsdormant_regex = g_regex_new ("\\r\\n\\^DSDORMANT:.+\\r\\n",
-                                               G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->simst_regex = g_regex_new ("\\r\\n\\^SIMST:.+\\r\\n",
-                                           G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->srvst_regex = g_regex_new ("\\r\\n\\^SRVST:.+\\r\\n",
-                                           G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->stin_regex = g_regex_new ("\\r\\n\\^STIN:.+\\r\\n",
-                                          G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->hcsq_regex = g_regex_new ("\\r\\n(\\^HCSQ:.+)\\r+\\n",
-                                          G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->pdpdeact_regex = g_regex_new ("\\r\\n\\^PDPDEACT:.+\\r+\\n",
-                                              G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->ndisend_regex = g_regex_new ("\\r\\n\\^NDISEND:.+\\r+\\n",
-                                             G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->rfswitch_regex = g_regex_new ("\\r\\n\\^RFSWITCH:.+\\r\\n",
-                                              G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->position_regex = g_regex_new ("\\r\\n\\^POSITION:.+\\r\\n",
-                                              G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->posend_regex = g_regex_new ("\\r\\n\\^POSEND:.+\\r\\n",
-                                            G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->ecclist_regex = g_regex_new ("\\r\\n\\^ECCLIST:.+\\r\\n",
-                                             G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->ltersrp_regex = g_regex_new ("\\r\\n\\^LTERSRP:.+\\r\\n",
-                                             G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->cschannelinfo_regex = g_regex_new ("\\r\\n\\^CSCHANNELINFO:.+\\r\\n",
-                                                    G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->ccallstate_regex = g_regex_new ("\\r\\n\\^CCALLSTATE:.+\\r\\n",
-                                                G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->eons_regex = g_regex_new ("\\r\\n\\^EONS:.+\\r\\n",
-                                          G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->lwurc_regex = g_regex_new ("\\r\\n\\^LWURC:.+\\r\\n",
-                                           G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
+    self->priv->mode_regex = mm_regex_cache_get ("\\r\\n\\^MODE:\\s*(\\d*),?(\\d*)\\r+\\n",
+                                                 G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
+    self->priv->dsflowrpt_regex = mm_regex_cache_get ("\\r\\n\\^DSFLOWRPT:(.+)\\r\\n",
+                                                      G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
+    self->priv->ndisstat_regex = mm_regex_cache_get ("\\r\\n(\\^NDISSTAT:.+)\\r+\\n",
+                                                     G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
+
+    self->priv->orig_regex = mm_regex_cache_get ("\\r\\n\\^ORIG:\\s*(\\d+),\\s*(\\d+)\\r\\n",
+                                                 G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
+    self->priv->conf_regex = mm_regex_cache_get ("\\r\\n\\^CONF:\\s*(\\d+)\\r\\n",
+                                                 G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
+    self->priv->conn_regex = mm_regex_cache_get ("\\r\\n\\^CONN:\\s*(\\d+),\\s*(\\d+)\\r\\n",
+                                                 G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
+    self->priv->cend_regex = mm_regex_cache_get ("\\r\\n\\^CEND:\\s*(\\d+),\\s*(\\d+),\\s*(\\d+)(?:,\\s*(\\d*))?\\r\\n",
+                                                 G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
+    self->priv->ddtmf_regex = mm_regex_cache_get ("\\r\\n\\^DDTMF:\\s*([0-9A-D\\*\\#])\\r\\n",
+                                                  G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
+
+    self->priv->boot_regex = mm_regex_cache_get ("\\r\\n\\^BOOT:.+\\r\\n",
+                                                 G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
+    self->priv->connect_regex = mm_regex_cache_get ("\\r\\n\\^CONNECT .+\\r\\n",
+                                                 G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
+    self->priv->csnr_regex = mm_regex_cache_get ("\\r\\n\\^CSNR:.+\\r\\n",
+                                                 G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
+    self->priv->cusatp_regex = mm_regex_cache_get ("\\r\\n\\+CUSATP:.+\\r\\n",
+                                                   G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
+    self->priv->cusatend_regex = mm_regex_cache_get ("\\r\\n\\+CUSATEND\\r\\n",
+                                                     G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
+    self->priv->dsdormant_regex = mm_regex_cache_get ("\\r\\n\\^DSDORMANT:.+\\r\\n",
+                                                      G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
+    self->priv->simst_regex = mm_regex_cache_get ("\\r\\n\\^SIMST:.+\\r\\n",
+                                                  G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
+    self->priv->srvst_regex = mm_regex_cache_get ("\\r\\n\\^SRVST:.+\\r\\n",
+                                                  G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
+    self->priv->stin_regex = mm_regex_cache_get ("\\r\\n\\^STIN:.+\\r\\n",
+                                                 G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
+    self->priv->hcsq_regex = mm_regex_cache_get ("\\r\\n(\\^HCSQ:.+)\\r+\\n",
+                                                 G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
+    self->priv->pdpdeact_regex = mm_regex_cache_get ("\\r\\n\\^PDPDEACT:.+\\r+\\n",
+                                                     G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
+    self->priv->ndisend_regex = mm_regex_cache_get ("\\r\\n\\^NDISEND:.+\\r+\\n",
+                                                    G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
+    self->priv->rfswitch_regex = mm_regex_cache_get ("\\r\\n\\^RFSWITCH:.+\\r\\n",
+                                                     G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
+    self->priv->position_regex = mm_regex_cache_get ("\\r\\n\\^POSITION:.+\\r\\n",
+                                                     G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
+    self->priv->posend_regex = mm_regex_cache_get ("\\r\\n\\^POSEND:.+\\r\\n",
+                                                   G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
+    self->priv->ecclist_regex = mm_regex_cache_get ("\\r\\n\\^ECCLIST:.+\\r\\n",
+                                                    G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
+    self->priv->ltersrp_regex = mm_regex_cache_get ("\\r\\n\\^LTERSRP:.+\\r\\n",
+                                                    G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
+    self->priv->cschannelinfo_regex = mm_regex_cache_get ("\\r\\n\\^CSCHANNELINFO:.+\\r\\n",
+                                                           G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
+    self->priv->ccallstate_regex = mm_regex_cache_get ("\\r\\n\\^CCALLSTATE:.+\\r\\n",
+                                                       G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
+    self->priv->eons_regex = mm_regex_cache_get ("\\r\\n\\^EONS:.+\\r\\n",
+                                                 G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
+    self->priv->lwurc_regex = mm_regex_cache_get ("\\r\\n\\^LWURC:.+\\r\\n",
+                                                  G_REGEX_RAW | G_REGEX_OPTIMIZE, 0);
 
     self->priv->ndisdup_support = FEATURE_SUPPORT_UNKNOWN;
     self->priv->rfswitch_support = FEATURE_SUPPORT_UNKNOWN;
@@ -4606,6 +4606,7 @@ iface_modem_init (MMIfaceModem *iface)
     iface->set_current_bands_finish = set_current_bands_finish;
     iface->load_supported_modes = load_supported_modes;
     iface->load_supported_modes_finish = load_supported_modes_finish;
+    iface->supported_modes_bands_stateful = TRUE;
     iface->load_current_modes = load_current_modes;
     iface->load_current_modes_finish = load_current_modes_finish;
     iface->set_current_modes = set_current_modes;
@@ -1473,6 +1473,8 @@ mm_broadband_modem_telit_new (const gchar *device,
                          /* Generic bearer supports AT only */
                          MM_BASE_MODEM_DATA_NET_SUPPORTED, FALSE,
                          MM_BASE_MODEM_DATA_TTY_SUPPORTED, TRUE,
+                         /* Telit modems accept concatenated read commands */
+                         MM_BASE_MODEM_AT_BATCHING, TRUE,
                          MM_IFACE_MODEM_SIM_HOT_SWAP_SUPPORTED, TRUE,
                          NULL);
 }
@@ -1503,6 +1505,7 @@ iface_modem_init (MMIfaceModem *iface)
     iface->load_revision_finish = mm_shared_telit_modem_load_revision_finish;
     iface->load_supported_bands = mm_shared_telit_modem_load_supported_bands;
     iface->load_supported_bands_finish = mm_shared_telit_modem_load_supported_bands_finish;
+    iface->supported_modes_bands_stateful = TRUE;
     iface->load_unlock_retries_finish = modem_load_unlock_retries_finish;
     iface->load_unlock_retries = modem_load_unlock_retries;
     iface->reset = modem_reset;
@@ -79,6 +79,7 @@ iface_modem_init (MMIfaceModem *iface)
 
     iface->load_supported_bands        = mm_shared_xmm_load_supported_bands;
     iface->load_supported_bands_finish = mm_shared_xmm_load_supported_bands_finish;
+    iface->supported_modes_bands_stateful = TRUE;
     iface->load_current_bands          = mm_shared_xmm_load_current_bands;
     iface->load_current_bands_finish   = mm_shared_xmm_load_current_bands_finish;
     iface->set_current_bands           = mm_shared_xmm_set_current_bands;
@@ -18,7 +18,9 @@
 #include <glib.h>
 
 #include "mm-port-serial-at.h"
+#include "mm-port-serial-qcdm.h"
 #include "mm-serial-parsers.h"
+#include "mm-error-helpers.h"
 #include "mm-log-test.h"
 
 typedef struct {
@@ -137,6 +139,286 @@ _run_parse_test (const ParseResponseTest tests[], guint number_of_tests)
     }
 }
 
+typedef struct {
+    const gchar *response;
+    GQuark       domain;
+    gint         code;
+} ParseErrorCodeTest;
+
+static void
+at_serial_parse_error_code (void)
+{
+    const ParseErrorCodeTest tests[] = {
+        { "\r\n+CME ERROR: 10\r\n",           MM_MOBILE_EQUIPMENT_ERROR, MM_MOBILE_EQUIPMENT_ERROR_SIM_NOT_INSERTED },
+        { "\r\n+CME ERROR:\r\n10\r\n",        MM_MOBILE_EQUIPMENT_ERROR, MM_MOBILE_EQUIPMENT_ERROR_SIM_NOT_INSERTED },
+        { "\r\n+CMS ERROR: 310\r\n",          MM_MESSAGE_ERROR,          MM_MESSAGE_ERROR_SIM_NOT_INSERTED },
+        { "\r\nMODEM ERROR: 5\r\n",           MM_MOBILE_EQUIPMENT_ERROR, MM_MOBILE_EQUIPMENT_ERROR_UNKNOWN },
+        { "\r\nERROR\r\n",                    MM_MOBILE_EQUIPMENT_ERROR, MM_MOBILE_EQUIPMENT_ERROR_UNKNOWN },
+        { "\r\nNO CARRIER\r\n",               MM_CONNECTION_ERROR,       MM_CONNECTION_ERROR_NO_CARRIER },
+        { "\r\nBUSY\r\n",                     MM_CONNECTION_ERROR,       MM_CONNECTION_ERROR_BUSY },
+        { "\r\nNO ANSWER\r\n",                MM_CONNECTION_ERROR,       MM_CONNECTION_ERROR_NO_ANSWER },
+        { "\r\nNO DIALTONE\r\n",              MM_CONNECTION_ERROR,       MM_CONNECTION_ERROR_NO_DIALTONE },
+        { "\r\nNO DIALTONE\r\nNO CARRIER\r\n", MM_CONNECTION_ERROR,       MM_CONNECTION_ERROR_NO_DIALTONE },
+        { "\r\nNA\r\n",                       MM_MOBILE_EQUIPMENT_ERROR, MM_MOBILE_EQUIPMENT_ERROR_NOT_ALLOWED },
+    };
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS (tests); i++) {
+        gpointer  parser;
+        GString  *response;
+        GError   *error = NULL;
+
+        parser = mm_serial_parser_v1_new ();
+        response = g_string_new (tests[i].response);
+        g_assert (mm_serial_parser_v1_parse (parser, response, NULL, &error));
+        g_assert_error (error, tests[i].domain, tests[i].code);
+        g_clear_error (&error);
+        g_string_free (response, TRUE);
+        mm_serial_parser_v1_destroy (parser);
+    }
+}
+
+typedef struct {
+    const gchar *response;
+    const gchar *text;
+} ParseOkTextTest;
+
+static void
+at_serial_parse_ok_text (void)
+{
+    const ParseOkTextTest tests[] = {
+        { "\r\n+CGMI: Telit\r\n\r\nOK\r\n",                "+CGMI: Telit" },
+        /* Duplicated final responses */
+        { "\r\nOK\r\n\r\nOK\r\n",                           ""             },
+        { "\r\nOK\r\n\r\nOK\r\n\r\nOK\r\n",                 ""             },
+        { "\r\n+CSQ: 20,99\r\n\r\nOK\r\n\r\nOK\r\n",         "+CSQ: 20,99"  },
+        { "\r\nOK\r\n\r\n+CSQ: 20,99\r\n\r\nOK\r\n",         "+CSQ: 20,99"  },
+    };
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS (tests); i++) {
+        gpointer  parser;
+        GString  *response;
+        GError   *error = NULL;
+
+        parser = mm_serial_parser_v1_new ();
+        response = g_string_new (tests[i].response);
+        g_assert (mm_serial_parser_v1_parse (parser, response, NULL, &error));
+        g_assert_no_error (error);
+        g_assert_cmpstr (response->str, ==, tests[i].text);
+        g_string_free (response, TRUE);
+        mm_serial_parser_v1_destroy (parser);
+    }
+}
+
+static void
+at_serial_parse_perf (void)
+{
+    static const gchar *responses[] = {
+        "\r\nOK\r\n",
+        "\r\n+CGDCONT: 1,\"IP\",\"internet\",\"0.0.0.0\",0,0\r\n\r\nOK\r\n",
+        "\r\n+CME ERROR: 10\r\n",
+        "\r\n+CMS ERROR: SIM not inserted\r\n",
+        "\r\nNO CARRIER\r\n",
+        "\r\n+CREG: 2,1,\"1A2B\",\"01A2B3C4\",7\r\n",
+    };
+    gpointer  parser;
+    GString  *response;
+    guint     n_iterations = 100000;
+    guint     i;
+    gdouble   elapsed;
+
+    if (!g_test_perf ()) {
+        g_test_skip ("only run in perf mode");
+        return;
+    }
+
+    parser = mm_serial_parser_v1_new ();
+    response = g_string_sized_new (128);
+
+    g_test_timer_start ();
+    for (i = 0; i < n_iterations; i++) {
+        GError *error = NULL;
+
+        g_string_assign (response, responses[i % G_N_ELEMENTS (responses)]);
+        mm_serial_parser_v1_parse (parser, response, NULL, &error);
+        g_clear_error (&error);
+    }
+    elapsed = g_test_timer_elapsed ();
+
+    g_test_minimized_result (elapsed * G_USEC_PER_SEC / n_iterations,
+                             "per-response parsing time: %.3f us",
+                             elapsed * G_USEC_PER_SEC / n_iterations);
+
+    g_string_free (response, TRUE);
+    mm_serial_parser_v1_destroy (parser);
+}
+
+static void
+serial_buffer_cursors (void)
+{
+    g_autoptr(MMSerialBuffer)  buf = NULL;
+    const guint8              *data;
+    guint8                    *dest;
+    gsize                      len;
+
+    buf = mm_serial_buffer_new (8);
+    data = mm_serial_buffer_peek (buf, &len);
+    g_assert_cmpuint (len, ==, 0);
+
+    /* Write through reserve/commit */
+    dest = mm_serial_buffer_reserve (buf, 6);
+    memcpy (dest, "abcdef", 6);
+    mm_serial_buffer_commit (buf, 4);
+    data = mm_serial_buffer_peek (buf, &len);
+    g_assert_cmpuint (len, ==, 4);
+    g_assert (memcmp (data, "abcd", 4) == 0);
+
+    /* Consuming just moves the head */
+    mm_serial_buffer_consume (buf, 3);
+    g_assert_cmpuint (mm_serial_buffer_get_len (buf), ==, 1);
+    g_assert_cmpuint (mm_serial_buffer_get_offset (buf), ==, 3);
+
+    /* No room at the tail: pending data is moved to the beginning */
+    mm_serial_buffer_append (buf, (const guint8 *) "efghi", 5);
+    data = mm_serial_buffer_peek (buf, &len);
+    g_assert_cmpuint (len, ==, 6);
+    g_assert (memcmp (data, "defghi", 6) == 0);
+
+    /* No room at all: storage grows */
+    mm_serial_buffer_append (buf, (const guint8 *) "jklmnop", 7);
+    data = mm_serial_buffer_peek (buf, &len);
+    g_assert_cmpuint (len, ==, 13);
+    g_assert (memcmp (data, "defghijklmnop", 13) == 0);
+
+    /* Moving pending data around doesn't change the stream offset */
+    g_assert_cmpuint (mm_serial_buffer_get_offset (buf), ==, 3);
+
+    mm_serial_buffer_replace (buf, (const guint8 *) "xyz", 3);
+    data = mm_serial_buffer_peek (buf, &len);
+    g_assert_cmpuint (len, ==, 3);
+    g_assert (memcmp (data, "xyz", 3) == 0);
+    g_assert_cmpuint (mm_serial_buffer_get_offset (buf), ==, 16);
+
+    mm_serial_buffer_consume (buf, 3);
+    g_assert_cmpuint (mm_serial_buffer_get_len (buf), ==, 0);
+    g_assert_cmpuint (mm_serial_buffer_get_offset (buf), ==, 19);
+}
+
+static void
+qcdm_frame_scan_chunks (void)
+{
+    g_autoptr(MMSerialBuffer)  buf = NULL;
+    MMPortSerialQcdmFrameScan  scan;
+    gsize                      start = G_MAXSIZE;
+
+    buf = mm_serial_buffer_new (16);
+    mm_port_serial_qcdm_frame_scan_reset (&scan);
+
+    /* Start marker and the beginning of the frame */
+    mm_serial_buffer_append (buf, (const guint8 *) "\x7e\x01\x02", 3);
+    g_assert (!mm_port_serial_qcdm_find_frame_start (&scan, buf, &start));
+    g_assert_cmpuint (scan.scanned, ==, 3);
+    g_assert_cmpint (scan.last, ==, 0);
+
+    /* More frame data, only the new bytes are scanned */
+    mm_serial_buffer_append (buf, (const guint8 *) "\x03", 1);
+    g_assert (!mm_port_serial_qcdm_find_frame_start (&scan, buf, &start));
+    g_assert_cmpuint (scan.scanned, ==, 4);
+    g_assert_cmpint (scan.last, ==, 0);
+
+    /* Terminator */
+    mm_serial_buffer_append (buf, (const guint8 *) "\x04\x7e", 2);
+    g_assert (mm_port_serial_qcdm_find_frame_start (&scan, buf, &start));
+    g_assert_cmpuint (start, ==, 1);
+}
+
+static void
+qcdm_frame_scan_split_marker (void)
+{
+    g_autoptr(MMSerialBuffer)  buf = NULL;
+    MMPortSerialQcdmFrameScan  scan;
+    gsize                      start = G_MAXSIZE;
+
+    buf = mm_serial_buffer_new (16);
+    mm_port_serial_qcdm_frame_scan_reset (&scan);
+
+    /* Garbage too short to be a frame, then the start marker of the next
+     * one as the last byte of the read */
+    mm_serial_buffer_append (buf, (const guint8 *) "ab\x7e", 3);
+    g_assert (!mm_port_serial_qcdm_find_frame_start (&scan, buf, &start));
+    g_assert_cmpint (scan.last, ==, 2);
+
+    /* The frame contents and terminator in the following read */
+    mm_serial_buffer_append (buf, (const guint8 *) "\x01\x02\x03\x7e", 4);
+    g_assert (mm_port_serial_qcdm_find_frame_start (&scan, buf, &start));
+    g_assert_cmpuint (start, ==, 3);
+}
+
+static void
+qcdm_frame_scan_consume (void)
+{
+    g_autoptr(MMSerialBuffer)  buf = NULL;
+    MMPortSerialQcdmFrameScan  scan;
+    gsize                      start = G_MAXSIZE;
+
+    buf = mm_serial_buffer_new (16);
+    mm_port_serial_qcdm_frame_scan_reset (&scan);
+
+    /* A full frame followed by the beginning of the next one */
+    mm_serial_buffer_append (buf, (const guint8 *) "\x01\x02\x03\x7e\x05", 5);
+    g_assert (mm_port_serial_qcdm_find_frame_start (&scan, buf, &start));
+    g_assert_cmpuint (start, ==, 0);
+
+    /* Once the frame is consumed, the scan restarts at the new head */
+    mm_serial_buffer_consume (buf, 4);
+    g_assert (!mm_port_serial_qcdm_find_frame_start (&scan, buf, &start));
+    g_assert_cmpuint (scan.offset, ==, 4);
+    g_assert_cmpuint (scan.scanned, ==, 1);
+    g_assert_cmpint (scan.last, ==, -1);
+
+    /* A marker seen before consuming is not reused at the new head */
+    mm_serial_buffer_append (buf, (const guint8 *) "\x7e", 1);
+    g_assert (!mm_port_serial_qcdm_find_frame_start (&scan, buf, &start));
+    g_assert_cmpint (scan.last, ==, 1);
+    mm_serial_buffer_consume (buf, 1);
+    mm_serial_buffer_append (buf, (const guint8 *) "\x06\x07\x08\x7e", 4);
+    g_assert (mm_port_serial_qcdm_find_frame_start (&scan, buf, &start));
+    g_assert_cmpuint (start, ==, 1);
+    g_assert_cmpuint (scan.offset, ==, 5);
+}
+
+static void
+qcdm_frame_scan_more (void)
+{
+    g_autoptr(MMSerialBuffer)  buf = NULL;
+    MMPortSerialQcdmFrameScan  scan;
+    const guint8              *data;
+    gsize                      len;
+    gsize                      start = G_MAXSIZE;
+
+    buf = mm_serial_buffer_new (16);
+    mm_port_serial_qcdm_frame_scan_reset (&scan);
+
+    /* Not enough data between markers for a frame: more data is needed, the
+     * pending data is left untouched and the last marker becomes the
+     * candidate start */
+    mm_serial_buffer_append (buf, (const guint8 *) "\x7e\x01\x02\x7e", 4);
+    g_assert (!mm_port_serial_qcdm_find_frame_start (&scan, buf, &start));
+    g_assert_cmpint (scan.last, ==, 3);
+    data = mm_serial_buffer_peek (buf, &len);
+    g_assert_cmpuint (len, ==, 4);
+    g_assert (memcmp (data, "\x7e\x01\x02\x7e", 4) == 0);
+
+    /* Nothing new, nothing found */
+    g_assert (!mm_port_serial_qcdm_find_frame_start (&scan, buf, &start));
+    g_assert_cmpuint (scan.scanned, ==, 4);
+
+    mm_serial_buffer_append (buf, (const guint8 *) "\x0a\x0b\x0c\x7e", 4);
+    g_assert (mm_port_serial_qcdm_find_frame_start (&scan, buf, &start));
+    g_assert_cmpuint (start, ==, 4);
+}
+
 static void
 at_serial_parse_ok (void)
 {
@@ -149,13 +431,91 @@ at_serial_parse_error (void)
     _run_parse_test (parse_error_tests, G_N_ELEMENTS(parse_error_tests));
 }
 
+typedef struct {
+    const gchar *pattern;
+    guint        n_expected;
+} UnsolicitedHandlerTest;
+
+static const UnsolicitedHandlerTest unsolicited_handler_tests[] = {
+    /* Handlers with a literal prefix after <CR><LF> */
+    { "\\r\\n\\+CREG:\\s*(\\d)\\r\\n",    2 },
+    { "\\r\\n\\+CIEV: (.*)\\r\\n",         1 },
+    { "\\r\\n\\+CMTI: (\\d)\\r\\n",       0 },
+    /* Handlers without prefix, always run */
+    { "\\+FOO: (\\d)\\r\\n",                1 },
+    { "\\r\\n(?:\\+BAR|\\+CRING): (\\d)\\r\\n", 0 },
+};
+
+static void
+unsolicited_handler_cb (MMPortSerialAt *port,
+                        GMatchInfo     *match_info,
+                        guint          *n_matches)
+{
+    (*n_matches)++;
+}
+
+static void
+at_serial_parse_unsolicited (void)
+{
+    static const gchar *buffer =
+        "\r\n+CREG: 1\r\n"
+        "\r\n+CIEV: 7,1\r\n"
+        "\r\nOK\r\n"
+        "\r\n+CREG: 5\r\n"
+        "\r\n+FOO: 3\r\n";
+    g_autoptr(MMPortSerialAt)  port = NULL;
+    g_autoptr(MMSerialBuffer)  buf = NULL;
+    const guint8              *data;
+    gsize                      len;
+    guint                      n_matches[G_N_ELEMENTS (unsolicited_handler_tests)] = { 0 };
+    GRegex                    *regexes[G_N_ELEMENTS (unsolicited_handler_tests)];
+    guint                      i;
+
+    port = mm_port_serial_at_new ("ttyTEST0", MM_PORT_SUBSYS_TTY);
+
+    for (i = 0; i < G_N_ELEMENTS (unsolicited_handler_tests); i++) {
+        regexes[i] = g_regex_new (unsolicited_handler_tests[i].pattern,
+                                  G_REGEX_RAW | G_REGEX_OPTIMIZE,
+                                  0, NULL);
+        g_assert (regexes[i]);
+        mm_port_serial_at_add_unsolicited_msg_handler (port,
+                                                       regexes[i],
+                                                       (MMPortSerialAtUnsolicitedMsgFn) unsolicited_handler_cb,
+                                                       &n_matches[i],
+                                                       NULL);
+    }
+
+    buf = mm_serial_buffer_new (16);
+    mm_serial_buffer_append (buf, (const guint8 *) buffer, strlen (buffer));
+    MM_PORT_SERIAL_GET_CLASS (port)->parse_unsolicited (MM_PORT_SERIAL (port), buf);
+
+    for (i = 0; i < G_N_ELEMENTS (unsolicited_handler_tests); i++) {
+        g_assert_cmpuint (n_matches[i], ==, unsolicited_handler_tests[i].n_expected);
+        g_regex_unref (regexes[i]);
+    }
+
+    /* Only the non-URC contents are kept in the buffer */
+    data = mm_serial_buffer_peek (buf, &len);
+    g_assert_cmpuint (len, ==, strlen ("\r\nOK\r\n\r\n"));
+    g_assert (memcmp (data, "\r\nOK\r\n\r\n", len) == 0);
+}
+
 int main (int argc, char **argv)
 {
     g_test_init (&argc, &argv, NULL);
 
     g_test_add_func ("/ModemManager/AT-serial/echo-removal", at_serial_echo_removal);
     g_test_add_func ("/ModemManager/AT-serial/parse-ok", at_serial_parse_ok);
+    g_test_add_func ("/ModemManager/AT-serial/parse-ok-text", at_serial_parse_ok_text);
     g_test_add_func ("/ModemManager/AT-serial/parse-error", at_serial_parse_error);
+    g_test_add_func ("/ModemManager/AT-serial/parse-error-code", at_serial_parse_error_code);
+    g_test_add_func ("/ModemManager/AT-serial/parse-perf", at_serial_parse_perf);
+    g_test_add_func ("/ModemManager/AT-serial/parse-unsolicited", at_serial_parse_unsolicited);
+    g_test_add_func ("/ModemManager/serial-buffer/cursors", serial_buffer_cursors);
+    g_test_add_func ("/ModemManager/QCDM-serial/frame-scan-chunks", qcdm_frame_scan_chunks);
+    g_test_add_func ("/ModemManager/QCDM-serial/frame-scan-split-marker", qcdm_frame_scan_split_marker);
+    g_test_add_func ("/ModemManager/QCDM-serial/frame-scan-consume", qcdm_frame_scan_consume);
+    g_test_add_func ("/ModemManager/QCDM-serial/frame-scan-more", qcdm_frame_scan_more);
 
     return g_test_run ();
 }
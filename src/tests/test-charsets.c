@@ -384,6 +384,70 @@ test_str_gsm_to_from_utf8_with_at (void)
     g_assert_cmpstr (dst, ==, src_translit);
 }
 
+static void
+test_gsm7_packed_to_utf8 (void)
+{
+    /* "hellohello" packed, with a trailing '@' and escaped '{' and euro sign */
+    static const guint8 unpacked[] = { 0x68, 0x65, 0x6C, 0x6C, 0x6F, 0x00, 0x1B, 0x28, 0x1B, 0x65, 0x01, 0x00, 0x00 };
+    g_autofree guint8 *packed = NULL;
+    guint32            packed_len = 0;
+    gchar              utf8[MM_CHARSET_GSM_PACKED_TO_UTF8_MAX_LEN (G_N_ELEMENTS (unpacked))];
+    gssize             utf8_len;
+    g_autoptr(GError)  error = NULL;
+    guint8             offset;
+
+    for (offset = 0; offset < 7; offset++) {
+        g_clear_pointer (&packed, g_free);
+        packed = mm_charset_gsm_pack (unpacked, sizeof (unpacked), offset, &packed_len);
+        g_assert (packed);
+
+        utf8_len = mm_charset_gsm_packed_to_utf8 (packed, sizeof (unpacked), offset, utf8, sizeof (utf8), &error);
+        g_assert_no_error (error);
+        g_assert_cmpstr (utf8, ==, "hello@{€£");
+        g_assert_cmpint (utf8_len, ==, strlen ("hello@{€£"));
+    }
+
+    /* Escape char without extended char */
+    utf8_len = mm_charset_gsm_packed_to_utf8 ((const guint8 *) "\x1b", 1, 0, utf8, sizeof (utf8), &error);
+    g_assert_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS);
+    g_assert_cmpint (utf8_len, ==, -1);
+}
+
+static void
+test_utf16be_to_utf8 (void)
+{
+    /* "T-Mobile тест" plus U+1F600 as a surrogate pair */
+    static const guint8 utf16[] = {
+        0x00, 0x54, 0x00, 0x2D, 0x00, 0x4D, 0x00, 0x6F, 0x00, 0x62, 0x00, 0x69,
+        0x00, 0x6C, 0x00, 0x65, 0x00, 0x20, 0x04, 0x42, 0x04, 0x35, 0x04, 0x41,
+        0x04, 0x42, 0xD8, 0x3D, 0xDE, 0x00 };
+    static const guint8 unpaired[] = { 0x00, 0x41, 0xDE, 0x00 };
+    gchar              utf8[MM_CHARSET_UTF16BE_TO_UTF8_MAX_LEN (sizeof (utf16))];
+    g_autofree gchar  *expected = NULL;
+    gssize             utf8_len;
+    g_autoptr(GError)  error = NULL;
+
+    /* Must match the iconv based conversion */
+    expected = mm_modem_charset_str_to_utf8 ("0054002D004D006F00620069006C0065"
+                                             "00200442043504410442D83DDE00",
+                                             -1, MM_MODEM_CHARSET_UTF16, FALSE, &error);
+    g_assert_no_error (error);
+
+    utf8_len = mm_charset_utf16be_to_utf8 (utf16, sizeof (utf16), utf8, sizeof (utf8), &error);
+    g_assert_no_error (error);
+    g_assert_cmpstr (utf8, ==, expected);
+    g_assert_cmpint (utf8_len, ==, strlen (expected));
+
+    utf8_len = mm_charset_utf16be_to_utf8 (utf16, sizeof (utf16) - 1, utf8, sizeof (utf8), &error);
+    g_assert_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS);
+    g_assert_cmpint (utf8_len, ==, -1);
+    g_clear_error (&error);
+
+    utf8_len = mm_charset_utf16be_to_utf8 (unpaired, sizeof (unpaired), utf8, sizeof (utf8), &error);
+    g_assert_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS);
+    g_assert_cmpint (utf8_len, ==, -1);
+}
+
 struct charset_can_convert_to_test_s {
     const char *utf8;
     gboolean    to_gsm;
@@ -732,6 +796,9 @@ int main (int argc, char **argv)
     g_test_add_func ("/MM/charsets/gsm7/pack/last-septet-alone", test_gsm7_pack_last_septet_alone);
     g_test_add_func ("/MM/charsets/gsm7/pack/7-chars-offset",    test_gsm7_pack_7_chars_offset);
 
+    g_test_add_func ("/MM/charsets/gsm7/packed-to-utf8",         test_gsm7_packed_to_utf8);
+    g_test_add_func ("/MM/charsets/utf16be-to-utf8",             test_utf16be_to_utf8);
+
     g_test_add_func ("/MM/charsets/str-from-to/ucs2",         test_str_ucs2_to_from_utf8);
     g_test_add_func ("/MM/charsets/str-from-to/gsm",          test_str_gsm_to_from_utf8);
     g_test_add_func ("/MM/charsets/str-from-to/gsm-with-at",  test_str_gsm_to_from_utf8_with_at);
@@ -0,0 +1,280 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 Telit
+ */
+
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <locale.h>
+
+#include <ModemManager.h>
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+
+#include "mm-modem-cache.h"
+
+/************************************************************/
+
+typedef struct {
+    gchar *dir;
+    gchar *path;
+} Fixture;
+
+static void
+fixture_setup (Fixture       *fixture,
+               gconstpointer  user_data)
+{
+    GError *error = NULL;
+
+    fixture->dir = g_dir_make_tmp ("mm-test-modem-cache-XXXXXX", &error);
+    g_assert_no_error (error);
+    fixture->path = g_build_filename (fixture->dir, "modem-cache", NULL);
+    mm_modem_cache_set_path (fixture->path);
+}
+
+static void
+fixture_teardown (Fixture       *fixture,
+                  gconstpointer  user_data)
+{
+    mm_modem_cache_set_path (NULL);
+    g_unlink (fixture->path);
+    g_rmdir (fixture->dir);
+    g_free (fixture->path);
+    g_free (fixture->dir);
+}
+
+/* Forget the loaded contents, so that they're read again from disk */
+static void
+reload (Fixture *fixture)
+{
+    mm_modem_cache_set_path (fixture->path);
+}
+
+static const MMModemCacheKey default_key = {
+    .equipment_id         = "351234567890123",
+    .revision             = "LE910C1 25.30.226",
+    .plugin               = "telit",
+    .current_capabilities = MM_MODEM_CAPABILITY_GSM_UMTS | MM_MODEM_CAPABILITY_LTE,
+};
+
+static GVariant *
+build_bands (void)
+{
+    return g_variant_ref_sink (g_variant_new_parsed ("[%u, %u]",
+                                                     MM_MODEM_BAND_EUTRAN_1,
+                                                     MM_MODEM_BAND_EUTRAN_3));
+}
+
+static void
+assert_cached (const MMModemCacheKey *key,
+               GVariant              *expected)
+{
+    GVariant *value;
+
+    value = mm_modem_cache_lookup (NULL, key, "supported-bands", G_VARIANT_TYPE ("au"));
+    if (!expected) {
+        g_assert (!value);
+        return;
+    }
+    g_assert (value);
+    g_assert (g_variant_equal (value, expected));
+    g_variant_unref (value);
+}
+
+/************************************************************/
+
+static void
+test_store_lookup (Fixture       *fixture,
+                   gconstpointer  user_data)
+{
+    GVariant *bands;
+
+    bands = build_bands ();
+    assert_cached (&default_key, NULL);
+
+    mm_modem_cache_store (NULL, &default_key, "supported-bands", bands);
+    assert_cached (&default_key, bands);
+
+    /* Persisted */
+    g_assert (g_file_test (fixture->path, G_FILE_TEST_EXISTS));
+    reload (fixture);
+    assert_cached (&default_key, bands);
+
+    /* Other keys of the same equipment are not there */
+    g_assert (!mm_modem_cache_lookup (NULL, &default_key, "supported-modes", G_VARIANT_TYPE ("a(uu)")));
+
+    /* Values of an unexpected type are ignored */
+    g_assert (!mm_modem_cache_lookup (NULL, &default_key, "supported-bands", G_VARIANT_TYPE ("a(uu)")));
+
+    g_variant_unref (bands);
+}
+
+static void
+test_group_validation (Fixture       *fixture,
+                       gconstpointer  user_data)
+{
+    MMModemCacheKey  key;
+    GVariant        *bands;
+
+    bands = build_bands ();
+
+    /* No equipment identifier */
+    key = default_key;
+    key.equipment_id = NULL;
+    mm_modem_cache_store (NULL, &key, "supported-bands", bands);
+    key.equipment_id = "";
+    mm_modem_cache_store (NULL, &key, "supported-bands", bands);
+    assert_cached (&key, NULL);
+
+    /* No revision */
+    key = default_key;
+    key.revision = "";
+    mm_modem_cache_store (NULL, &key, "supported-bands", bands);
+    assert_cached (&key, NULL);
+
+    /* No plugin */
+    key = default_key;
+    key.plugin = NULL;
+    mm_modem_cache_store (NULL, &key, "supported-bands", bands);
+    assert_cached (&key, NULL);
+
+    /* Chars not allowed in keyfile group names */
+    key = default_key;
+    key.equipment_id = "3512[34]";
+    mm_modem_cache_store (NULL, &key, "supported-bands", bands);
+    assert_cached (&key, NULL);
+    key = default_key;
+    key.revision = "25.30\n226";
+    mm_modem_cache_store (NULL, &key, "supported-bands", bands);
+    assert_cached (&key, NULL);
+
+    /* None of them ever written */
+    g_assert (!g_file_test (fixture->path, G_FILE_TEST_EXISTS));
+
+    /* Different revisions are different entries */
+    mm_modem_cache_store (NULL, &default_key, "supported-bands", bands);
+    key = default_key;
+    key.revision = "LE910C1 25.30.227";
+    assert_cached (&key, NULL);
+    assert_cached (&default_key, bands);
+
+    g_variant_unref (bands);
+}
+
+static void
+test_invalidate_plugin (Fixture       *fixture,
+                        gconstpointer  user_data)
+{
+    MMModemCacheKey  key;
+    GVariant        *bands;
+
+    bands = build_bands ();
+    mm_modem_cache_store (NULL, &default_key, "supported-bands", bands);
+
+    key = default_key;
+    key.plugin = "generic";
+    assert_cached (&key, NULL);
+
+    /* The whole entry is dropped, also for the original plugin */
+    assert_cached (&default_key, NULL);
+    reload (fixture);
+    assert_cached (&default_key, NULL);
+
+    g_variant_unref (bands);
+}
+
+static void
+test_invalidate_capabilities (Fixture       *fixture,
+                              gconstpointer  user_data)
+{
+    MMModemCacheKey  key;
+    GVariant        *bands;
+
+    bands = build_bands ();
+    mm_modem_cache_store (NULL, &default_key, "supported-bands", bands);
+
+    key = default_key;
+    key.current_capabilities = MM_MODEM_CAPABILITY_GSM_UMTS;
+    assert_cached (&key, NULL);
+
+    assert_cached (&default_key, NULL);
+    reload (fixture);
+    assert_cached (&default_key, NULL);
+
+    /* Storing with the new capabilities replaces the entry */
+    mm_modem_cache_store (NULL, &key, "supported-bands", bands);
+    assert_cached (&key, bands);
+
+    g_variant_unref (bands);
+}
+
+static void
+test_no_rewrite (Fixture       *fixture,
+                 gconstpointer  user_data)
+{
+    GVariant *bands;
+    GVariant *other;
+
+    bands = build_bands ();
+    mm_modem_cache_store (NULL, &default_key, "supported-bands", bands);
+    g_assert (g_file_test (fixture->path, G_FILE_TEST_EXISTS));
+
+    /* Same value again, the file must not be written */
+    g_assert_cmpint (g_unlink (fixture->path), ==, 0);
+    mm_modem_cache_store (NULL, &default_key, "supported-bands", bands);
+    g_assert (!g_file_test (fixture->path, G_FILE_TEST_EXISTS));
+
+    /* A different value is written */
+    other = g_variant_ref_sink (g_variant_new_parsed ("[%u]", MM_MODEM_BAND_EUTRAN_7));
+    mm_modem_cache_store (NULL, &default_key, "supported-bands", other);
+    g_assert (g_file_test (fixture->path, G_FILE_TEST_EXISTS));
+    reload (fixture);
+    assert_cached (&default_key, other);
+
+    g_variant_unref (other);
+    g_variant_unref (bands);
+}
+
+static void
+test_disabled (void)
+{
+    GVariant *bands;
+
+    mm_modem_cache_set_path (NULL);
+
+    bands = build_bands ();
+    mm_modem_cache_store (NULL, &default_key, "supported-bands", bands);
+    assert_cached (&default_key, NULL);
+    g_variant_unref (bands);
+}
+
+/************************************************************/
+
+#define TEST_ADD(path, func)                                            \
+    g_test_add (path, Fixture, NULL, fixture_setup, func, fixture_teardown)
+
+int main (int argc, char **argv)
+{
+    setlocale (LC_ALL, "");
+
+    g_test_init (&argc, &argv, NULL);
+
+    TEST_ADD ("/MM/modem-cache/store-lookup",            test_store_lookup);
+    TEST_ADD ("/MM/modem-cache/group-validation",        test_group_validation);
+    TEST_ADD ("/MM/modem-cache/invalidate-plugin",       test_invalidate_plugin);
+    TEST_ADD ("/MM/modem-cache/invalidate-capabilities", test_invalidate_capabilities);
+    TEST_ADD ("/MM/modem-cache/no-rewrite",              test_no_rewrite);
+    g_test_add_func ("/MM/modem-cache/disabled",         test_disabled);
+
+    return g_test_run ();
+}
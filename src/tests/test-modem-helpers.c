@@ -4439,6 +4439,223 @@ test_emergency_numbers (void)
     }
 }
 
+/*****************************************************************************/
+/* Test the 27.007 list tokenizer */
+
+typedef struct {
+    MMAtListItemType  type;
+    const gchar      *value;
+} AtListItemExpected;
+
+typedef struct {
+    const gchar        *str;
+    guint               n_items;
+    AtListItemExpected  items[6];
+} AtListTest;
+
+static const AtListTest at_list_tests[] = {
+    { "", 0, { } },
+    { "1", 1, {
+        { MM_AT_LIST_ITEM_TOKEN, "1" } }
+    },
+    { " 0-5 , 7 ", 2, {
+        { MM_AT_LIST_ITEM_TOKEN, "0-5" },
+        { MM_AT_LIST_ITEM_TOKEN, "7" } }
+    },
+    { "1,,2,", 4, {
+        { MM_AT_LIST_ITEM_TOKEN, "1" },
+        { MM_AT_LIST_ITEM_EMPTY, "" },
+        { MM_AT_LIST_ITEM_TOKEN, "2" },
+        { MM_AT_LIST_ITEM_EMPTY, "" } }
+    },
+    { "(\"SM\",\"ME\"),\"MT\",()", 3, {
+        { MM_AT_LIST_ITEM_GROUP,  "\"SM\",\"ME\"" },
+        { MM_AT_LIST_ITEM_STRING, "MT" },
+        { MM_AT_LIST_ITEM_GROUP,  "" } }
+    },
+    /* separators and parentheses within quotes */
+    { "(1,\"a, (b)\",2),\"c,d\"", 2, {
+        { MM_AT_LIST_ITEM_GROUP,  "1,\"a, (b)\",2" },
+        { MM_AT_LIST_ITEM_STRING, "c,d" } }
+    },
+    /* nested groups */
+    { "(\"battchg\",(0-5)),(\"service\",(0,1))", 2, {
+        { MM_AT_LIST_ITEM_GROUP, "\"battchg\",(0-5)" },
+        { MM_AT_LIST_ITEM_GROUP, "\"service\",(0,1)" } }
+    },
+    /* adjacent groups, stray parentheses and repeated tags */
+    { "(1,2)(3),4)\r\n+TAG: (5)", 5, {
+        { MM_AT_LIST_ITEM_GROUP, "1,2" },
+        { MM_AT_LIST_ITEM_GROUP, "3" },
+        { MM_AT_LIST_ITEM_TOKEN, "4" },
+        { MM_AT_LIST_ITEM_TOKEN, "+TAG:" },
+        { MM_AT_LIST_ITEM_GROUP, "5" } }
+    },
+    /* unterminated group and string */
+    { "(1,\"abc", 1, {
+        { MM_AT_LIST_ITEM_GROUP, "1,\"abc" } }
+    },
+};
+
+static void
+test_at_list_tokenizer (void)
+{
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS (at_list_tests); i++) {
+        MMAtListIter iter;
+        MMAtListItem item;
+        guint        n_items = 0;
+
+        g_debug ("  testing '%s'...", at_list_tests[i].str);
+
+        mm_at_list_iter_init (&iter, at_list_tests[i].str, -1);
+        while (mm_at_list_iter_next (&iter, &item)) {
+            g_autofree gchar *value = NULL;
+
+            g_assert_cmpuint (n_items, <, at_list_tests[i].n_items);
+            g_assert_cmpint (item.type, ==, at_list_tests[i].items[n_items].type);
+            value = g_strndup (item.str, item.len);
+            g_assert_cmpstr (value, ==, at_list_tests[i].items[n_items].value);
+            n_items++;
+        }
+        g_assert_cmpuint (n_items, ==, at_list_tests[i].n_items);
+    }
+}
+
+static void
+test_at_list_item_values (void)
+{
+    MMAtListIter      iter;
+    MMAtListItem      item;
+    guint             min = 0;
+    guint             max = 0;
+    g_autofree gchar *str = NULL;
+
+    mm_at_list_iter_init (&iter, "12,3 - 9,\" a b \",x,4294967296,,(1)", -1);
+
+    g_assert (mm_at_list_iter_next (&iter, &item));
+    g_assert (mm_at_list_item_get_uint (&item, &min));
+    g_assert_cmpuint (min, ==, 12);
+    g_assert (mm_at_list_item_get_uint_range (&item, &min, &max));
+    g_assert_cmpuint (min, ==, 12);
+    g_assert_cmpuint (max, ==, 12);
+
+    g_assert (mm_at_list_iter_next (&iter, &item));
+    g_assert (!mm_at_list_item_get_uint (&item, &min));
+    g_assert (mm_at_list_item_get_uint_range (&item, &min, &max));
+    g_assert_cmpuint (min, ==, 3);
+    g_assert_cmpuint (max, ==, 9);
+
+    g_assert (mm_at_list_iter_next (&iter, &item));
+    g_assert_cmpint (item.type, ==, MM_AT_LIST_ITEM_STRING);
+    str = mm_at_list_item_dup_string (&item);
+    g_assert_cmpstr (str, ==, "a b");
+
+    g_assert (mm_at_list_iter_next (&iter, &item));
+    g_assert (mm_at_list_item_equal (&item, "x"));
+    g_assert (!mm_at_list_item_equal (&item, "xy"));
+    g_assert (!mm_at_list_item_get_uint_range (&item, &min, &max));
+
+    g_assert (mm_at_list_iter_next (&iter, &item));
+    g_assert (!mm_at_list_item_get_uint (&item, &min));
+
+    g_assert (mm_at_list_iter_next (&iter, &item));
+    g_assert_cmpint (item.type, ==, MM_AT_LIST_ITEM_EMPTY);
+    g_assert (!mm_at_list_item_dup_string (&item));
+
+    g_assert (mm_at_list_iter_next (&iter, &item));
+    g_assert_cmpint (item.type, ==, MM_AT_LIST_ITEM_GROUP);
+    g_assert (!mm_at_list_item_get_uint (&item, &min));
+
+    g_assert (!mm_at_list_iter_next (&iter, &item));
+}
+
+static void
+test_split_string_groups (void)
+{
+    g_auto(GStrv) split = NULL;
+
+    split = mm_split_string_groups ("\"SM\", (\"SM\",\"ME\"),(0-6),,1");
+    g_assert_cmpuint (g_strv_length (split), ==, 5);
+    g_assert_cmpstr (split[0], ==, "\"SM\"");
+    g_assert_cmpstr (split[1], ==, "\"SM\",\"ME\"");
+    g_assert_cmpstr (split[2], ==, "0-6");
+    g_assert_cmpstr (split[3], ==, "");
+    g_assert_cmpstr (split[4], ==, "1");
+    g_clear_pointer (&split, g_strfreev);
+
+    split = mm_split_string_groups ("");
+    g_assert_cmpuint (g_strv_length (split), ==, 1);
+    g_assert_cmpstr (split[0], ==, "");
+}
+
+/*****************************************************************************/
+/* Test AT command batching */
+
+static void
+test_at_command_is_batchable (void)
+{
+    gsize prefix_len = 0;
+
+    g_assert (mm_at_command_is_batchable ("+COPS?", &prefix_len));
+    g_assert_cmpuint (prefix_len, ==, 5);
+    g_assert (mm_at_command_is_batchable ("+CGDCONT=?", &prefix_len));
+    g_assert_cmpuint (prefix_len, ==, 8);
+    g_assert (mm_at_command_is_batchable ("#PSNT?", NULL));
+    g_assert (mm_at_command_is_batchable ("$QCPDPP?", NULL));
+
+    g_assert (!mm_at_command_is_batchable ("+CGMI", NULL));
+    g_assert (!mm_at_command_is_batchable ("+CFUN=1", NULL));
+    g_assert (!mm_at_command_is_batchable ("+CGDCONT?1", NULL));
+    g_assert (!mm_at_command_is_batchable ("+COPS?;+CREG?", NULL));
+    g_assert (!mm_at_command_is_batchable ("I", NULL));
+    g_assert (!mm_at_command_is_batchable ("+?", NULL));
+    g_assert (!mm_at_command_is_batchable ("", NULL));
+}
+
+static void
+test_at_command_batch_split_response (void)
+{
+    const gchar *commands[] = { "+COPS?", "#PSNT?", "+CGDCONT?" };
+    const gchar *swapped[] = { "#PSNT?", "+COPS?" };
+    const gchar *response =
+        "+COPS: 0,0,\"Operator\",7\r\n"
+        "\r\n"
+        "#PSNT: 0,4\r\n"
+        "\r\n"
+        "+CGDCONT: 1,\"IP\",\"internet\",\"0.0.0.0\",0,0\r\n"
+        "+CGDCONT: 2,\"IPV4V6\",\"ims\",\"\",0,0";
+    g_auto(GStrv) split = NULL;
+
+    split = mm_at_command_batch_split_response (response, commands, 3);
+    g_assert (split);
+    g_assert_cmpuint (g_strv_length (split), ==, 3);
+    g_assert_cmpstr (split[0], ==, "+COPS: 0,0,\"Operator\",7");
+    g_assert_cmpstr (split[1], ==, "#PSNT: 0,4");
+    g_assert_cmpstr (split[2], ==,
+                     "+CGDCONT: 1,\"IP\",\"internet\",\"0.0.0.0\",0,0\r\n"
+                     "+CGDCONT: 2,\"IPV4V6\",\"ims\",\"\",0,0");
+    g_clear_pointer (&split, g_strfreev);
+
+    /* Untagged lines continue the previous reply */
+    split = mm_at_command_batch_split_response ("+COPS: 0\r\nmore\r\n#PSNT: 1", commands, 2);
+    g_assert (split);
+    g_assert_cmpstr (split[0], ==, "+COPS: 0\r\nmore");
+    g_assert_cmpstr (split[1], ==, "#PSNT: 1");
+    g_clear_pointer (&split, g_strfreev);
+
+    /* Replies out of order */
+    g_assert (!mm_at_command_batch_split_response ("+COPS: 0\r\n#PSNT: 1", swapped, 2));
+    /* Command without reply */
+    g_assert (!mm_at_command_batch_split_response ("+COPS: 0\r\n+CGDCONT: 1", commands, 3));
+    /* Untagged leading text */
+    g_assert (!mm_at_command_batch_split_response ("hello\r\n+COPS: 0\r\n#PSNT: 1", commands, 2));
+    /* Tag must be followed by a colon */
+    g_assert (!mm_at_command_batch_split_response ("+COPSX: 0\r\n#PSNT: 1", commands, 2));
+    g_assert (!mm_at_command_batch_split_response (NULL, commands, 2));
+}
+
 /*****************************************************************************/
 
 typedef struct {
@@ -4603,6 +4820,171 @@ test_cpol_response (void)
     }
 }
 
+/*****************************************************************************/
+/* Test network interface traffic counters */
+
+static void
+test_interface_stats_counter (void *f, gpointer d)
+{
+    MMInterfaceStatsCounter counter;
+
+    /* Relative to the value when started */
+    mm_interface_stats_counter_init (&counter, 1000);
+    g_assert_cmpuint (mm_interface_stats_counter_update (&counter, 1000), ==, 0);
+    g_assert_cmpuint (mm_interface_stats_counter_update (&counter, 1500), ==, 500);
+
+    /* Interface reset: counting goes on from the last reported value */
+    g_assert_cmpuint (mm_interface_stats_counter_update (&counter, 200), ==, 700);
+    g_assert_cmpuint (mm_interface_stats_counter_update (&counter, 300), ==, 800);
+
+    /* Reset down to a value above the original base */
+    g_assert_cmpuint (mm_interface_stats_counter_update (&counter, 250), ==, 1050);
+
+    /* Reset to exactly 0 */
+    g_assert_cmpuint (mm_interface_stats_counter_update (&counter, 0), ==, 1050);
+    g_assert_cmpuint (mm_interface_stats_counter_update (&counter, 10), ==, 1060);
+}
+
+/*****************************************************************************/
+/* Parsing performance (run with '-m perf') */
+
+static const gchar *perf_cops_reply =
+    "+COPS: (2,\"T-Mobile\",\"TMO\",\"31026\",0),(1,\"AT&T\",\"AT&T\",\"310410\",0),,(0,1,2,3,4),(0,1,2)";
+
+static const gchar *perf_cgdcont_reply =
+    "+CGDCONT: 1,\"IP\",\"nate.sktelecom.com\",\"\",0,0\r\n"
+    "+CGDCONT: 2,\"IPV6\",\"internet.example.com\",\"\",0,0\r\n"
+    "+CGDCONT: 3,\"IPV4V6\",\"ims\",\"\",0,0\r\n";
+
+static const gchar *perf_clcc_reply =
+    "+CLCC: 1,1,0,0,1\r\n"
+    "+CLCC: 2,1,0,0,1,\"123456789\",161\r\n"
+    "+CLCC: 3,1,0,0,1,\"987654321\",161,\"Alice\"\r\n"
+    "+CLCC: 4,1,0,0,1,\"000000000\",161,\"Bob\",1\r\n"
+    "+CLCC: 5,1,5,0,0,\"555555555\",161,\"Mallory\",2,0\r\n";
+
+static const gchar *perf_cesq_reply = "+CESQ: 99,99,255,255,20,80";
+
+static const gchar *perf_cpms_reply = "+CPMS: (\"ME\",\"MT\",\"SM\",\"SR\"),(\"ME\",\"MT\",\"SM\"),(\"ME\",\"SM\")";
+
+static const gchar *perf_cind_reply =
+    "+CIND: (\"battchg\",(0-5)),(\"signal\",(0-5)),(\"service\",(0,1)),(\"call\",(0,1)),"
+    "(\"roam\",(0,1)),(\"smsfull\",(0,1)),(\"callsetup\",(0-3))";
+
+static gboolean
+perf_parse_cops (GError **error)
+{
+    GList *list;
+
+    list = mm_3gpp_parse_cops_test_response (perf_cops_reply, MM_MODEM_CHARSET_UNKNOWN, NULL, error);
+    mm_3gpp_network_info_list_free (list);
+    return !!list;
+}
+
+static gboolean
+perf_parse_cgdcont (GError **error)
+{
+    GList *list;
+
+    list = mm_3gpp_parse_cgdcont_read_response (perf_cgdcont_reply, error);
+    mm_3gpp_pdp_context_list_free (list);
+    return !!list;
+}
+
+static gboolean
+perf_parse_clcc (GError **error)
+{
+    GList    *list = NULL;
+    gboolean  success;
+
+    success = mm_3gpp_parse_clcc_response (perf_clcc_reply, NULL, &list, error);
+    mm_3gpp_call_info_list_free (list);
+    return success;
+}
+
+static gboolean
+perf_parse_cesq (GError **error)
+{
+    guint rxlev, ber, rscp, ecn0, rsrq, rsrp;
+
+    return mm_3gpp_parse_cesq_response (perf_cesq_reply, &rxlev, &ber, &rscp, &ecn0, &rsrq, &rsrp, error);
+}
+
+static gboolean
+perf_parse_cpms (GError **error)
+{
+    GArray *mem1 = NULL;
+    GArray *mem2 = NULL;
+    GArray *mem3 = NULL;
+
+    if (!mm_3gpp_parse_cpms_test_response (perf_cpms_reply, &mem1, &mem2, &mem3, error))
+        return FALSE;
+    g_array_unref (mem1);
+    g_array_unref (mem2);
+    g_array_unref (mem3);
+    return TRUE;
+}
+
+static gboolean
+perf_parse_cind (GError **error)
+{
+    GHashTable *hash;
+    gboolean    success;
+
+    hash = mm_3gpp_parse_cind_test_response (perf_cind_reply, error);
+    if (!hash)
+        return FALSE;
+    success = (g_hash_table_size (hash) > 0);
+    g_hash_table_unref (hash);
+    return success;
+}
+
+typedef struct {
+    const gchar *name;
+    gboolean   (*parse) (GError **error);
+} PerfParser;
+
+static const PerfParser perf_parsers[] = {
+    { "+COPS=?",   perf_parse_cops    },
+    { "+CGDCONT?", perf_parse_cgdcont },
+    { "+CLCC",     perf_parse_clcc    },
+    { "+CESQ",     perf_parse_cesq    },
+    { "+CPMS=?",   perf_parse_cpms    },
+    { "+CIND=?",   perf_parse_cind    },
+};
+
+#define PERF_ITERATIONS 20000
+
+static void
+test_parse_perf (void)
+{
+    guint j;
+
+    if (!g_test_perf ()) {
+        g_test_skip ("only run in perf mode");
+        return;
+    }
+
+    for (j = 0; j < G_N_ELEMENTS (perf_parsers); j++) {
+        GError  *error = NULL;
+        gdouble  elapsed;
+        guint    i;
+
+        /* Validate the sample before measuring anything */
+        g_assert (perf_parsers[j].parse (&error));
+        g_assert_no_error (error);
+
+        g_test_timer_start ();
+        for (i = 0; i < PERF_ITERATIONS; i++)
+            perf_parsers[j].parse (NULL);
+        elapsed = g_test_timer_elapsed ();
+
+        g_test_maximized_result (PERF_ITERATIONS / elapsed,
+                                 "%s: %.0f parses/s",
+                                 perf_parsers[j].name, PERF_ITERATIONS / elapsed);
+    }
+}
+
 /*****************************************************************************/
 
 #define TESTCASE(t, d) g_test_create_case (#t, 0, d, NULL, (GTestFixtureFunc) t, NULL)
@@ -4834,12 +5216,21 @@ int main (int argc, char **argv)
 
     g_test_suite_add (suite, TESTCASE (test_emergency_numbers, NULL));
 
+    g_test_suite_add (suite, TESTCASE (test_at_list_tokenizer, NULL));
+    g_test_suite_add (suite, TESTCASE (test_at_list_item_values, NULL));
+    g_test_suite_add (suite, TESTCASE (test_split_string_groups, NULL));
+    g_test_suite_add (suite, TESTCASE (test_at_command_is_batchable, NULL));
+    g_test_suite_add (suite, TESTCASE (test_at_command_batch_split_response, NULL));
     g_test_suite_add (suite, TESTCASE (test_parse_uint_list, NULL));
 
     g_test_suite_add (suite, TESTCASE (test_bcd_to_string, NULL));
 
     g_test_suite_add (suite, TESTCASE (test_cpol_response, NULL));
 
+    g_test_suite_add (suite, TESTCASE (test_interface_stats_counter, NULL));
+
+    g_test_suite_add (suite, TESTCASE (test_parse_perf, NULL));
+
     result = g_test_run ();
 
     reg_test_data_free (reg_data);
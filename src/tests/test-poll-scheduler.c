@@ -0,0 +1,117 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 Telit
+ */
+
+#include <glib.h>
+#include <locale.h>
+
+#include "mm-poll-scheduler.h"
+
+/************************************************************/
+
+static void
+test_backoff (void)
+{
+    g_autoptr(MMPollScheduler) scheduler = NULL;
+
+    scheduler = mm_poll_scheduler_new (10, 60);
+    g_assert_cmpuint (mm_poll_scheduler_get_interval (scheduler), ==, 10);
+
+    /* Stable values double the interval up to the maximum */
+    g_assert (mm_poll_scheduler_tick (scheduler));
+    mm_poll_scheduler_report_polled (scheduler, FALSE);
+    g_assert_cmpuint (mm_poll_scheduler_get_interval (scheduler), ==, 20);
+    mm_poll_scheduler_report_polled (scheduler, FALSE);
+    g_assert_cmpuint (mm_poll_scheduler_get_interval (scheduler), ==, 40);
+    mm_poll_scheduler_report_polled (scheduler, FALSE);
+    g_assert_cmpuint (mm_poll_scheduler_get_interval (scheduler), ==, 60);
+    mm_poll_scheduler_report_polled (scheduler, FALSE);
+    g_assert_cmpuint (mm_poll_scheduler_get_interval (scheduler), ==, 60);
+
+    /* Boost uses the minimum while enabled */
+    mm_poll_scheduler_set_boost (scheduler, TRUE);
+    g_assert_cmpuint (mm_poll_scheduler_get_interval (scheduler), ==, 10);
+    mm_poll_scheduler_set_boost (scheduler, FALSE);
+    g_assert_cmpuint (mm_poll_scheduler_get_interval (scheduler), ==, 60);
+
+    /* A change goes back to the minimum */
+    mm_poll_scheduler_report_polled (scheduler, TRUE);
+    g_assert_cmpuint (mm_poll_scheduler_get_interval (scheduler), ==, 10);
+
+    /* And so does a changed indication */
+    mm_poll_scheduler_report_polled (scheduler, FALSE);
+    mm_poll_scheduler_report_indication (scheduler, TRUE);
+    g_assert_cmpuint (mm_poll_scheduler_get_interval (scheduler), ==, 10);
+}
+
+static void
+test_indications (void)
+{
+    g_autoptr(MMPollScheduler) scheduler = NULL;
+    guint                      i;
+
+    scheduler = mm_poll_scheduler_new (10, 60);
+
+    /* Indications must arrive during several consecutive intervals */
+    for (i = 0; i < MM_POLL_SCHEDULER_INDICATIONS_PROVEN_TICKS - 1; i++) {
+        mm_poll_scheduler_report_indication (scheduler, FALSE);
+        g_assert (mm_poll_scheduler_tick (scheduler));
+    }
+    g_assert (mm_poll_scheduler_tick (scheduler));
+    g_assert (!mm_poll_scheduler_get_indications_proven (scheduler));
+
+    for (i = 0; i < MM_POLL_SCHEDULER_INDICATIONS_PROVEN_TICKS - 1; i++) {
+        mm_poll_scheduler_report_indication (scheduler, FALSE);
+        g_assert (mm_poll_scheduler_tick (scheduler));
+    }
+    mm_poll_scheduler_report_indication (scheduler, FALSE);
+    g_assert (!mm_poll_scheduler_tick (scheduler));
+    g_assert (mm_poll_scheduler_get_indications_proven (scheduler));
+
+    /* The maximum interval is used to check that they keep on arriving, even
+     * when boosted */
+    mm_poll_scheduler_set_boost (scheduler, TRUE);
+    g_assert_cmpuint (mm_poll_scheduler_get_interval (scheduler), ==, 60);
+    mm_poll_scheduler_report_indication (scheduler, TRUE);
+    g_assert (!mm_poll_scheduler_tick (scheduler));
+
+    /* If they stop, polling is needed again */
+    g_assert (mm_poll_scheduler_tick (scheduler));
+    g_assert (!mm_poll_scheduler_get_indications_proven (scheduler));
+    g_assert_cmpuint (mm_poll_scheduler_get_interval (scheduler), ==, 10);
+
+    /* Reset forgets about indications */
+    for (i = 0; i < MM_POLL_SCHEDULER_INDICATIONS_PROVEN_TICKS; i++) {
+        mm_poll_scheduler_report_indication (scheduler, FALSE);
+        mm_poll_scheduler_tick (scheduler);
+    }
+    g_assert (mm_poll_scheduler_get_indications_proven (scheduler));
+    mm_poll_scheduler_reset (scheduler);
+    g_assert (!mm_poll_scheduler_get_indications_proven (scheduler));
+    g_assert (mm_poll_scheduler_tick (scheduler));
+}
+
+/************************************************************/
+
+int main (int argc, char **argv)
+{
+    setlocale (LC_ALL, "");
+
+    g_test_init (&argc, &argv, NULL);
+
+    g_test_add_func ("/MM/poll-scheduler/backoff",     test_backoff);
+    g_test_add_func ("/MM/poll-scheduler/indications", test_indications);
+
+    return g_test_run ();
+}
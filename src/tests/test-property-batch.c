@@ -0,0 +1,216 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 Telit
+ */
+
+#include <glib.h>
+#include <glib-object.h>
+#include <locale.h>
+
+#include "mm-property-batch.h"
+
+/************************************************************/
+/* Test object with a couple of properties, counting updates */
+
+#define TEST_TYPE_OBJECT (test_object_get_type ())
+G_DECLARE_FINAL_TYPE (TestObject, test_object, TEST, OBJECT, GObject)
+
+struct _TestObject {
+    GObject   parent;
+    guint     number;
+    GVariant *variant;
+    guint     n_sets;
+};
+
+G_DEFINE_TYPE (TestObject, test_object, G_TYPE_OBJECT)
+
+enum {
+    PROP_0,
+    PROP_NUMBER,
+    PROP_VARIANT,
+};
+
+static void
+test_object_set_property (GObject      *object,
+                          guint         prop_id,
+                          const GValue *value,
+                          GParamSpec   *pspec)
+{
+    TestObject *self = TEST_OBJECT (object);
+
+    switch (prop_id) {
+    case PROP_NUMBER:
+        self->number = g_value_get_uint (value);
+        break;
+    case PROP_VARIANT:
+        g_clear_pointer (&self->variant, g_variant_unref);
+        self->variant = g_value_dup_variant (value);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+        return;
+    }
+    self->n_sets++;
+}
+
+static void
+test_object_get_property (GObject    *object,
+                          guint       prop_id,
+                          GValue     *value,
+                          GParamSpec *pspec)
+{
+    TestObject *self = TEST_OBJECT (object);
+
+    switch (prop_id) {
+    case PROP_NUMBER:
+        g_value_set_uint (value, self->number);
+        break;
+    case PROP_VARIANT:
+        g_value_set_variant (value, self->variant);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+        break;
+    }
+}
+
+static void
+test_object_finalize (GObject *object)
+{
+    g_clear_pointer (&TEST_OBJECT (object)->variant, g_variant_unref);
+    G_OBJECT_CLASS (test_object_parent_class)->finalize (object);
+}
+
+static void
+test_object_init (TestObject *self)
+{
+}
+
+static void
+test_object_class_init (TestObjectClass *klass)
+{
+    GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+    object_class->set_property = test_object_set_property;
+    object_class->get_property = test_object_get_property;
+    object_class->finalize = test_object_finalize;
+
+    g_object_class_install_property (object_class, PROP_NUMBER,
+                                     g_param_spec_uint ("number", "Number", "Number",
+                                                        0, G_MAXUINT, 0,
+                                                        G_PARAM_READWRITE));
+    g_object_class_install_property (object_class, PROP_VARIANT,
+                                     g_param_spec_variant ("variant", "Variant", "Variant",
+                                                           G_VARIANT_TYPE ("(ub)"), NULL,
+                                                           G_PARAM_READWRITE));
+}
+
+/************************************************************/
+
+static void
+test_disabled (void)
+{
+    g_autoptr(MMPropertyBatch) batch = NULL;
+    g_autoptr(TestObject)      object = NULL;
+    g_auto(GValue)             value = G_VALUE_INIT;
+
+    object = g_object_new (TEST_TYPE_OBJECT, NULL);
+    batch = mm_property_batch_new (0);
+
+    mm_property_batch_set_uint (batch, object, "number", 5);
+    g_assert_cmpuint (object->number, ==, 5);
+    g_assert_cmpuint (object->n_sets, ==, 1);
+    g_assert (!mm_property_batch_peek (batch, object, "number", &value));
+}
+
+static void
+test_coalesce (void)
+{
+    g_autoptr(MMPropertyBatch) batch = NULL;
+    g_autoptr(TestObject)      object = NULL;
+    g_auto(GValue)             value = G_VALUE_INIT;
+    guint                      signal_quality = 0;
+    gboolean                   recent = FALSE;
+
+    object = g_object_new (TEST_TYPE_OBJECT, NULL);
+    batch = mm_property_batch_new (1000);
+
+    mm_property_batch_set_uint (batch, object, "number", 1);
+    mm_property_batch_set_variant (batch, object, "variant", g_variant_new ("(ub)", 10, TRUE));
+    mm_property_batch_set_uint (batch, object, "number", 2);
+    mm_property_batch_set_variant (batch, object, "variant", g_variant_new ("(ub)", 20, FALSE));
+
+    /* Nothing applied yet, but pending values available */
+    g_assert_cmpuint (object->n_sets, ==, 0);
+    g_assert (mm_property_batch_peek (batch, object, "number", &value));
+    g_assert_cmpuint (g_value_get_uint (&value), ==, 2);
+
+    /* Only the latest value of each property applied */
+    mm_property_batch_flush (batch);
+    g_assert_cmpuint (object->n_sets, ==, 2);
+    g_assert_cmpuint (object->number, ==, 2);
+    g_variant_get (object->variant, "(ub)", &signal_quality, &recent);
+    g_assert_cmpuint (signal_quality, ==, 20);
+    g_assert (!recent);
+
+    g_value_unset (&value);
+    g_assert (!mm_property_batch_peek (batch, object, "number", &value));
+
+    /* Flushing again is a no-op */
+    mm_property_batch_flush (batch);
+    g_assert_cmpuint (object->n_sets, ==, 2);
+}
+
+static gboolean
+quit_loop (GMainLoop *loop)
+{
+    g_main_loop_quit (loop);
+    return G_SOURCE_REMOVE;
+}
+
+static void
+test_window (void)
+{
+    g_autoptr(MMPropertyBatch) batch = NULL;
+    g_autoptr(TestObject)      object = NULL;
+    g_autoptr(GMainLoop)       loop = NULL;
+
+    object = g_object_new (TEST_TYPE_OBJECT, NULL);
+    batch = mm_property_batch_new (10);
+    loop = g_main_loop_new (NULL, FALSE);
+
+    mm_property_batch_set_uint (batch, object, "number", 3);
+    mm_property_batch_set_uint (batch, object, "number", 4);
+    g_assert_cmpuint (object->n_sets, ==, 0);
+
+    g_timeout_add (100, (GSourceFunc) quit_loop, loop);
+    g_main_loop_run (loop);
+
+    g_assert_cmpuint (object->n_sets, ==, 1);
+    g_assert_cmpuint (object->number, ==, 4);
+}
+
+/************************************************************/
+
+int main (int argc, char **argv)
+{
+    setlocale (LC_ALL, "");
+
+    g_test_init (&argc, &argv, NULL);
+
+    g_test_add_func ("/MM/property-batch/disabled", test_disabled);
+    g_test_add_func ("/MM/property-batch/coalesce", test_coalesce);
+    g_test_add_func ("/MM/property-batch/window",   test_window);
+
+    return g_test_run ();
+}
@@ -0,0 +1,255 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 Telit
+ */
+
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <sys/stat.h>
+#include <string.h>
+#include <locale.h>
+#include <unistd.h>
+
+#include <ModemManager.h>
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+
+#include "mm-serial-trace.h"
+
+/************************************************************/
+
+typedef struct {
+    gchar                  *name;
+    MMSerialTraceDirection  direction;
+    GByteArray             *data;
+} Record;
+
+static void
+record_free (Record *record)
+{
+    g_free (record->name);
+    g_byte_array_unref (record->data);
+    g_slice_free (Record, record);
+}
+
+static void
+collect_record (const gchar            *name,
+                gint64                  timestamp,
+                MMSerialTraceDirection  direction,
+                const guint8           *data,
+                gsize                   len,
+                gpointer                user_data)
+{
+    GPtrArray *records = user_data;
+    Record    *record;
+
+    g_assert_cmpint (timestamp, >, 0);
+
+    record = g_slice_new0 (Record);
+    record->name = g_strdup (name);
+    record->direction = direction;
+    record->data = g_byte_array_sized_new (len);
+    g_byte_array_append (record->data, data, len);
+    g_ptr_array_add (records, record);
+}
+
+static GPtrArray *
+dump_and_parse (void)
+{
+    GError    *error = NULL;
+    GPtrArray *records;
+    GPtrArray *truncated;
+    gchar     *path;
+    gchar     *contents;
+    gsize      contents_len;
+    GStatBuf   st;
+    gint       fd;
+
+    fd = g_file_open_tmp ("mm-test-serial-trace-XXXXXX", &path, &error);
+    g_assert_no_error (error);
+    close (fd);
+
+    mm_serial_trace_dump_all (path, &error);
+    g_assert_no_error (error);
+
+    /* Traces may contain personal info, never readable by others */
+    g_assert_cmpint (g_stat (path, &st), ==, 0);
+    g_assert_cmpuint (st.st_mode & 0777, ==, 0600);
+
+    g_file_get_contents (path, &contents, &contents_len, &error);
+    g_assert_no_error (error);
+
+    records = g_ptr_array_new_with_free_func ((GDestroyNotify) record_free);
+    mm_serial_trace_parse ((const guint8 *) contents, contents_len, collect_record, records, &error);
+    g_assert_no_error (error);
+
+    /* A truncated file must be reported */
+    truncated = g_ptr_array_new_with_free_func ((GDestroyNotify) record_free);
+    g_assert (!mm_serial_trace_parse ((const guint8 *) contents, contents_len - 1, collect_record, truncated, &error));
+    g_assert_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS);
+    g_clear_error (&error);
+    g_ptr_array_unref (truncated);
+
+    g_unlink (path);
+    g_free (contents);
+    g_free (path);
+    return records;
+}
+
+static void
+assert_record (GPtrArray              *records,
+               guint                   i,
+               const gchar            *name,
+               MMSerialTraceDirection  direction,
+               const gchar            *data)
+{
+    Record *record;
+
+    g_assert_cmpuint (i, <, records->len);
+    record = g_ptr_array_index (records, i);
+    g_assert_cmpstr (record->name, ==, name);
+    g_assert_cmpuint (record->direction, ==, direction);
+    g_assert_cmpuint (record->data->len, ==, strlen (data));
+    g_assert (memcmp (record->data->data, data, record->data->len) == 0);
+}
+
+static void
+trace_add (MMSerialTrace          *trace,
+           MMSerialTraceDirection  direction,
+           const gchar            *data)
+{
+    mm_serial_trace_add (trace, direction, (const guint8 *) data, strlen (data));
+}
+
+/************************************************************/
+
+static void
+test_ring (void)
+{
+    MMSerialTrace *trace;
+    GPtrArray     *records;
+
+    /* Room for 64 bytes, each record takes 13 bytes plus the data */
+    mm_serial_trace_set_size (64);
+    trace = mm_serial_trace_new ("ttyTEST0");
+    g_assert (trace);
+
+    trace_add (trace, MM_SERIAL_TRACE_DIRECTION_OUT, "AT+CSQ\r");
+    trace_add (trace, MM_SERIAL_TRACE_DIRECTION_IN,  "\r\n+CSQ: 20,99\r\n");
+    trace_add (trace, MM_SERIAL_TRACE_DIRECTION_OUT, "AT\r");
+
+    /* The ring is full now, the oldest record must be dropped */
+    trace_add (trace, MM_SERIAL_TRACE_DIRECTION_IN,  "\r\nOK\r\n");
+
+    records = dump_and_parse ();
+    g_assert_cmpuint (records->len, ==, 3);
+    assert_record (records, 0, "ttyTEST0", MM_SERIAL_TRACE_DIRECTION_IN,  "\r\n+CSQ: 20,99\r\n");
+    assert_record (records, 1, "ttyTEST0", MM_SERIAL_TRACE_DIRECTION_OUT, "AT\r");
+    assert_record (records, 2, "ttyTEST0", MM_SERIAL_TRACE_DIRECTION_IN,  "\r\nOK\r\n");
+    g_ptr_array_unref (records);
+
+    mm_serial_trace_free (trace);
+}
+
+static void
+test_big_record (void)
+{
+    MMSerialTrace *trace1;
+    MMSerialTrace *trace2;
+    GPtrArray     *records;
+    gchar          big[101];
+
+    memset (big, 'A', sizeof (big) - 1);
+    big[sizeof (big) - 1] = '\0';
+
+    mm_serial_trace_set_size (64);
+    trace1 = mm_serial_trace_new ("ttyTEST1");
+    trace2 = mm_serial_trace_new ("ttyTEST2");
+
+    trace_add (trace1, MM_SERIAL_TRACE_DIRECTION_OUT, "ATI\r");
+    trace_add (trace2, MM_SERIAL_TRACE_DIRECTION_OUT, "ATI\r");
+    /* Bigger than the ring, truncated and replacing everything */
+    trace_add (trace2, MM_SERIAL_TRACE_DIRECTION_IN, big);
+
+    records = dump_and_parse ();
+    g_assert_cmpuint (records->len, ==, 2);
+    assert_record (records, 0, "ttyTEST1", MM_SERIAL_TRACE_DIRECTION_OUT, "ATI\r");
+    big[64 - 13] = '\0';
+    assert_record (records, 1, "ttyTEST2", MM_SERIAL_TRACE_DIRECTION_IN, big);
+    g_ptr_array_unref (records);
+
+    mm_serial_trace_free (trace1);
+    mm_serial_trace_free (trace2);
+}
+
+static void
+test_disabled (void)
+{
+    mm_serial_trace_set_size (0);
+    g_assert (!mm_serial_trace_new ("ttyTEST3"));
+}
+
+static void
+test_personal_info (void)
+{
+    MMSerialTrace *trace;
+    GPtrArray     *records;
+
+    mm_serial_trace_set_size (1024);
+    mm_serial_trace_set_show_personal_info (FALSE);
+    trace = mm_serial_trace_new ("ttyTEST4");
+
+    trace_add (trace, MM_SERIAL_TRACE_DIRECTION_OUT, "AT+CPIN=\"1234\"\r");
+    trace_add (trace, MM_SERIAL_TRACE_DIRECTION_IN,  "\r\nOK\r\n");
+    trace_add (trace, MM_SERIAL_TRACE_DIRECTION_OUT, "AT+CIMI\r");
+    /* Response split across reads */
+    trace_add (trace, MM_SERIAL_TRACE_DIRECTION_IN,  "\r\n2140123");
+    trace_add (trace, MM_SERIAL_TRACE_DIRECTION_IN,  "45678901\r\n\r\nOK\r\n");
+    trace_add (trace, MM_SERIAL_TRACE_DIRECTION_OUT, "ATD+15551234;\r");
+    trace_add (trace, MM_SERIAL_TRACE_DIRECTION_IN,  "\r\n+CME ERROR: 30\r\n");
+    trace_add (trace, MM_SERIAL_TRACE_DIRECTION_IN,  "\r\n+CLIP: \"+15551234\",145\r\n");
+
+    records = dump_and_parse ();
+    g_assert_cmpuint (records->len, ==, 8);
+    assert_record (records, 0, "ttyTEST4", MM_SERIAL_TRACE_DIRECTION_OUT, "AT+CPIN=\"####\"\r");
+    assert_record (records, 1, "ttyTEST4", MM_SERIAL_TRACE_DIRECTION_IN,  "\r\nOK\r\n");
+    assert_record (records, 2, "ttyTEST4", MM_SERIAL_TRACE_DIRECTION_OUT, "AT+CIMI\r");
+    assert_record (records, 3, "ttyTEST4", MM_SERIAL_TRACE_DIRECTION_IN,  "\r\n#######");
+    assert_record (records, 4, "ttyTEST4", MM_SERIAL_TRACE_DIRECTION_IN,  "########\r\n\r\nOK\r\n");
+    assert_record (records, 5, "ttyTEST4", MM_SERIAL_TRACE_DIRECTION_OUT, "ATD#########;\r");
+    assert_record (records, 6, "ttyTEST4", MM_SERIAL_TRACE_DIRECTION_IN,  "\r\n+CME ERROR: ##\r\n");
+    assert_record (records, 7, "ttyTEST4", MM_SERIAL_TRACE_DIRECTION_IN,  "\r\n+CLIP: \"#########\",###\r\n");
+    g_ptr_array_unref (records);
+
+    mm_serial_trace_free (trace);
+    mm_serial_trace_set_show_personal_info (TRUE);
+}
+
+/************************************************************/
+
+int main (int argc, char **argv)
+{
+    setlocale (LC_ALL, "");
+
+    g_test_init (&argc, &argv, NULL);
+
+    /* Raw traffic checks, unless explicitly testing the masking */
+    mm_serial_trace_set_show_personal_info (TRUE);
+
+    g_test_add_func ("/MM/serial-trace/ring",       test_ring);
+    g_test_add_func ("/MM/serial-trace/big-record", test_big_record);
+    g_test_add_func ("/MM/serial-trace/disabled",   test_disabled);
+    g_test_add_func ("/MM/serial-trace/personal-info", test_personal_info);
+
+    return g_test_run ();
+}
@@ -751,6 +751,68 @@ test_create_pdu_gsm_no_validity (void)
                             1); /* expected_msgstart */
 }
 
+/********************* PERFORMANCE TESTS *********************/
+
+/* Corpus of received PDUs, as reported by +CMGL/+CMGR */
+static const gchar *pdu_corpus[] = {
+    /* GSM-7, with extended characters */
+    "07912104442961F4040B916171957291F800001120821105050A6AC8B2BC7C9A83C220F6DB7D2E"
+    "CB41EDF27C1E3E97411BDE06754FD3D1A0F9BB5D0695F1F4B29B5C2683C6E8B03C3CA697E5F34D"
+    "6AE303D1D1F2F7DD0D4ABB59A0797D8C0685E7A00028EC26832A960B28EC2683BE6050780EBA97"
+    "D96C17",
+    /* GSM-7, long message with UDH */
+    "07912160130320F5440B916171056429F5000021405291650569A00500034C0201A9E8F41C949E"
+    "83C2207B599E07B1DFEE33885E9ED341E4F23C7D7697C920FA1B54C697E5E3F4BC0C6AD7D9F434"
+    "081E96D341E3303C2C4EB3D3F4BC0B94A483E6E8779D4D06CDD1EF3BA80E0785E7A0B7BB0C6A97"
+    "E7F3F0B9CC02B9DF7450780EA2DFDF2C50780EA2A3CBA0BA9B5C96B3F369F71954768FDFE4B4FB"
+    "0C9297E1F2F2BCECA6CF41",
+    "07912160130320F6440B916171056429F5000021405291651569320500034C0202E9E8301D4447"
+    "9741F0B09C3E0785E56590BCCC0ED3CB6410FD0D7ABBCBA0B0FB4D4797E52E10",
+    /* GSM-7, short */
+    "07912143658709F1040B918100551512F20000111010214365000AE8329BFD4697D9EC37",
+    /* UCS2 */
+    "07919730071111F10414D04937BD2C7797E9D3E614000811309291024061080442043504410442",
+};
+
+static void
+test_pdu_decode_perf (void)
+{
+    guint   n_iterations = 20000;
+    guint   n_pdus = 0;
+    guint   i;
+    guint   j;
+    gdouble elapsed;
+
+    if (!g_test_perf ()) {
+        g_test_skip ("only run in perf mode");
+        return;
+    }
+
+    /* Validate the corpus before measuring anything */
+    for (j = 0; j < G_N_ELEMENTS (pdu_corpus); j++) {
+        MMSmsPart *part;
+        GError    *error = NULL;
+
+        part = mm_sms_part_3gpp_new_from_pdu (j, pdu_corpus[j], NULL, &error);
+        g_assert_no_error (error);
+        g_assert (part);
+        mm_sms_part_free (part);
+    }
+
+    g_test_timer_start ();
+    for (i = 0; i < n_iterations; i++) {
+        for (j = 0; j < G_N_ELEMENTS (pdu_corpus); j++) {
+            mm_sms_part_free (mm_sms_part_3gpp_new_from_pdu (j, pdu_corpus[j], NULL, NULL));
+            n_pdus++;
+        }
+    }
+    elapsed = g_test_timer_elapsed ();
+
+    g_test_maximized_result (n_pdus / elapsed,
+                             "decoded %u PDUs in %.3f s: %.0f PDUs/s",
+                             n_pdus, elapsed, n_pdus / elapsed);
+}
+
 /************************************************************/
 
 int main (int argc, char **argv)
@@ -790,5 +852,7 @@ int main (int argc, char **argv)
     g_test_add_func ("/MM/SMS/3GPP/PDU-Creator/GSM-3", test_create_pdu_gsm_3);
     g_test_add_func ("/MM/SMS/3GPP/PDU-Creator/GSM-no-validity", test_create_pdu_gsm_no_validity);
 
+    g_test_add_func ("/MM/SMS/3GPP/PDU-Parser/decode-perf", test_pdu_decode_perf);
+
     return g_test_run ();
 }
@@ -15,6 +15,7 @@
 
 #include <glib.h>
 #include <glib-object.h>
+#include <glib/gstdio.h>
 #include <string.h>
 #include <stdio.h>
 #include <locale.h>
@@ -41,6 +42,95 @@ test_load_cleanup_core (void)
     g_array_unref (rules);
 }
 
+static const gchar *compile_rules =
+    "ACTION!=\"add|change|move|bind\", GOTO=\"mm_test_end\"\n"
+    "SUBSYSTEMS==\"usb\", ATTRS{idVendor}==\"1bc7\", GOTO=\"mm_test_vendor\"\n"
+    "GOTO=\"mm_test_end\"\n"
+    "LABEL=\"mm_test_vendor\"\n"
+    "SUBSYSTEMS==\"usb\", ATTRS{bInterfaceNumber}==\"?*\", ENV{.MM_USBIFNUM}=\"$attr{bInterfaceNumber}\"\n"
+    "ATTRS{idVendor}==\"1bc7\", ATTRS{idProduct}==\"1003\", ENV{.MM_USBIFNUM}==\"00\", ENV{ID_MM_PORT_TYPE_AT_PRIMARY}=\"1\"\n"
+    "ATTRS{idVendor}==\"1bc7\", ATTRS{idProduct}==\"1003\", ENV{.MM_USBIFNUM}==\"02\", ENV{ID_MM_PORT_TYPE_AT_SECONDARY}=\"1\"\n"
+    "ATTRS{idVendor}==\"8087\", ATTRS{idProduct}==\"0911\", ENV{ID_MM_PORT_TYPE_AT_PRIMARY}=\"1\"\n"
+    "ATTRS{idVendor}!=\"8087\", ATTRS{serial}==\"abc\", DEVPATH==\"/devices/usb1\", ENV{ID_MM_PORT_IGNORE}=\"1\"\n"
+    "LABEL=\"mm_test_end\"\n";
+
+static void
+test_compile (void)
+{
+    g_autofree gchar *rulesdir = NULL;
+    g_autofree gchar *rulesfile = NULL;
+    GArray           *rules;
+    MMUdevRule       *rule;
+    MMUdevRuleMatch  *match;
+    GError           *error = NULL;
+
+    rulesdir = g_dir_make_tmp ("mm-test-udev-rules-XXXXXX", &error);
+    g_assert_no_error (error);
+    rulesfile = g_build_filename (rulesdir, "77-mm-test.rules", NULL);
+    g_file_set_contents (rulesfile, compile_rules, -1, &error);
+    g_assert_no_error (error);
+
+    rules = mm_kernel_device_generic_rules_load (rulesdir, &error);
+    g_assert_no_error (error);
+    g_assert (rules);
+    g_assert_cmpuint (rules->len, ==, 10);
+
+    g_unlink (rulesfile);
+    g_rmdir (rulesdir);
+
+    /* ACTION match pre-evaluated */
+    rule = &g_array_index (rules, MMUdevRule, 0);
+    match = &g_array_index (rule->conditions, MMUdevRuleMatch, 0);
+    g_assert_cmpuint (match->parameter_kind, ==, MM_UDEV_RULE_MATCH_PARAMETER_ACTION);
+    g_assert_cmpuint (match->value_uint, ==, TRUE);
+    g_assert (!rule->vid_required);
+
+    /* Vendor guard only skips itself */
+    rule = &g_array_index (rules, MMUdevRule, 1);
+    match = &g_array_index (rule->conditions, MMUdevRuleMatch, 1);
+    g_assert_cmpuint (match->parameter_kind, ==, MM_UDEV_RULE_MATCH_PARAMETER_ATTR_VID);
+    g_assert_cmpstr (match->name, ==, "idVendor");
+    g_assert (match->lookup_parents);
+    g_assert (match->value_uint_valid);
+    g_assert_cmpuint (match->value_uint, ==, 0x1bc7);
+    g_assert (rule->vid_required);
+    g_assert_cmpuint (rule->vid, ==, 0x1bc7);
+    g_assert_cmpuint (rule->vid_block_end, ==, 2);
+
+    /* Interface number substitution and wildcard */
+    rule = &g_array_index (rules, MMUdevRule, 4);
+    match = &g_array_index (rule->conditions, MMUdevRuleMatch, 1);
+    g_assert_cmpuint (match->parameter_kind, ==, MM_UDEV_RULE_MATCH_PARAMETER_ATTR_INTERFACE_NUMBER);
+    g_assert (match->value_any);
+    g_assert_cmpuint (rule->result.content.property.value_attr, ==, MM_UDEV_RULE_MATCH_PARAMETER_ATTR_INTERFACE_NUMBER);
+    g_assert (!rule->vid_required);
+
+    /* Contiguous block of rules gated on the same VID */
+    rule = &g_array_index (rules, MMUdevRule, 5);
+    g_assert (rule->vid_required);
+    g_assert_cmpuint (rule->vid_block_end, ==, 7);
+    match = &g_array_index (rule->conditions, MMUdevRuleMatch, 2);
+    g_assert_cmpuint (match->parameter_kind, ==, MM_UDEV_RULE_MATCH_PARAMETER_ENV);
+    g_assert_cmpstr (match->name, ==, ".MM_USBIFNUM");
+    rule = &g_array_index (rules, MMUdevRule, 6);
+    g_assert_cmpuint (rule->vid_block_end, ==, 7);
+    rule = &g_array_index (rules, MMUdevRule, 7);
+    g_assert_cmpuint (rule->vid, ==, 0x8087);
+    g_assert_cmpuint (rule->vid_block_end, ==, 8);
+
+    /* Negated VID matches don't gate the rule */
+    rule = &g_array_index (rules, MMUdevRule, 8);
+    g_assert (!rule->vid_required);
+    match = &g_array_index (rule->conditions, MMUdevRuleMatch, 1);
+    g_assert_cmpuint (match->parameter_kind, ==, MM_UDEV_RULE_MATCH_PARAMETER_ATTR_OTHER);
+    g_assert_cmpstr (match->name, ==, "serial");
+    match = &g_array_index (rule->conditions, MMUdevRuleMatch, 2);
+    g_assert_cmpuint (match->parameter_kind, ==, MM_UDEV_RULE_MATCH_PARAMETER_DEVPATH);
+    g_assert_cmpstr (match->value_prefix, ==, "/devices/usb1/*");
+
+    g_array_unref (rules);
+}
+
 /************************************************************/
 
 int main (int argc, char **argv)
@@ -50,6 +140,7 @@ int main (int argc, char **argv)
     g_test_init (&argc, &argv, NULL);
 
     g_test_add_func ("/MM/test-udev-rules/load-cleanup-core", test_load_cleanup_core);
+    g_test_add_func ("/MM/test-udev-rules/compile",           test_compile);
 
     return g_test_run ();
 }
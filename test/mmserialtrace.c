@@ -0,0 +1,158 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 Telit
+ */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <locale.h>
+#include <string.h>
+
+#include <glib.h>
+
+#include <ModemManager.h>
+
+#include "mm-serial-trace.h"
+
+#define PROGRAM_NAME    "mmserialtrace"
+#define PROGRAM_VERSION PACKAGE_VERSION
+
+/* Context */
+static gchar    *file;
+static gchar    *port;
+static gboolean  hex_flag;
+static gboolean  version_flag;
+
+static GOptionEntry main_entries[] = {
+    { "file", 'f', 0, G_OPTION_ARG_FILENAME, &file,
+      "Serial trace file dumped by ModemManager",
+      "[PATH]"
+    },
+    { "port", 'p', 0, G_OPTION_ARG_STRING, &port,
+      "Only show the traffic of the given port",
+      "[PORT]"
+    },
+    { "hex", 'x', 0, G_OPTION_ARG_NONE, &hex_flag,
+      "Show the raw data in hexadecimal",
+      NULL
+    },
+    { "version", 'V', 0, G_OPTION_ARG_NONE, &version_flag,
+      "Print version",
+      NULL
+    },
+    { NULL }
+};
+
+static void
+print_record (const gchar            *name,
+              gint64                  timestamp,
+              MMSerialTraceDirection  direction,
+              const guint8           *data,
+              gsize                   len,
+              gpointer                user_data)
+{
+    g_autoptr(GDateTime)  datetime = NULL;
+    g_autofree gchar     *datetime_str = NULL;
+    GString              *str;
+    gsize                 i;
+
+    if (port && !g_str_equal (port, name))
+        return;
+
+    datetime = g_date_time_new_from_unix_local (timestamp / G_USEC_PER_SEC);
+    datetime_str = g_date_time_format (datetime, "%F %T");
+
+    str = g_string_sized_new (len + 64);
+    g_string_append_printf (str, "[%s.%06u] %s %s ",
+                            datetime_str,
+                            (guint) (timestamp % G_USEC_PER_SEC),
+                            name,
+                            direction == MM_SERIAL_TRACE_DIRECTION_OUT ? "-->" : "<--");
+
+    if (hex_flag) {
+        for (i = 0; i < len; i++)
+            g_string_append_printf (str, "%s%02X", i ? ":" : "", data[i]);
+    } else {
+        g_string_append_c (str, '\'');
+        for (i = 0; i < len; i++) {
+            if (g_ascii_isprint (data[i]))
+                g_string_append_c (str, data[i]);
+            else if (data[i] == '\r')
+                g_string_append (str, "<CR>");
+            else if (data[i] == '\n')
+                g_string_append (str, "<LF>");
+            else
+                g_string_append_printf (str, "\\%u", data[i]);
+        }
+        g_string_append_c (str, '\'');
+    }
+
+    g_print ("%s\n", str->str);
+    g_string_free (str, TRUE);
+}
+
+static void
+print_version_and_exit (void)
+{
+    g_print ("\n"
+             PROGRAM_NAME " " PROGRAM_VERSION "\n"
+             "Copyright (2026) Telit\n"
+             "License GPLv2+: GNU GPL version 2 or later <http://gnu.org/licenses/gpl-2.0.html>\n"
+             "This is free software: you are free to change and redistribute it.\n"
+             "There is NO WARRANTY, to the extent permitted by law.\n"
+             "\n");
+    exit (EXIT_SUCCESS);
+}
+
+int main (int argc, char **argv)
+{
+    GOptionContext *context;
+    GError         *error = NULL;
+    gchar          *contents;
+    gsize           contents_len;
+
+    setlocale (LC_ALL, "");
+
+    /* Setup option context, process it and destroy it */
+    context = g_option_context_new ("- ModemManager serial trace decoder");
+    g_option_context_add_main_entries (context, main_entries, NULL);
+    g_option_context_parse (context, &argc, &argv, NULL);
+    g_option_context_free (context);
+
+    if (version_flag)
+        print_version_and_exit ();
+
+    /* No file given? */
+    if (!file) {
+        g_printerr ("error: no trace file specified\n");
+        exit (EXIT_FAILURE);
+    }
+
+    if (!g_file_get_contents (file, &contents, &contents_len, &error)) {
+        g_printerr ("error: couldn't read trace file: %s\n", error->message);
+        exit (EXIT_FAILURE);
+    }
+
+    if (!mm_serial_trace_parse ((const guint8 *) contents, contents_len, print_record, NULL, &error)) {
+        g_printerr ("error: couldn't parse trace file: %s\n", error->message);
+        exit (EXIT_FAILURE);
+    }
+
+    g_free (contents);
+    g_free (file);
+    g_free (port);
+
+    return EXIT_SUCCESS;
+}